@@ -0,0 +1,832 @@
+/** @file
+ * Implementacja rejestru obszarów zajętych przez graczy.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "areas.h"
+
+/**
+ * Bit, którym oznaczane są odwiedzone pola obszaru podczas liczenia części,
+ * na które obszar się rozpada. Numery obszarów muszą być od niego mniejsze.
+ */
+static const uint32_t AREA_MARK = UINT32_C(1) << 31;
+
+/**
+ * Początkowy rozmiar tablic rejestru.
+ */
+static const uint32_t INITIAL_CAPACITY = 16;
+
+bool registry_new(gamma_t *g) {
+    struct area_registry *r = calloc(1, sizeof(struct area_registry));
+    if (r == NULL)
+        return false;
+
+    r->area_of = create_new_arr(g);
+    r->entries = malloc(INITIAL_CAPACITY * sizeof(struct area_entry));
+    r->free_ids = malloc(INITIAL_CAPACITY * sizeof(uint32_t));
+    r->first = calloc(g->b_players, sizeof(uint32_t));
+    r->stack = malloc(INITIAL_CAPACITY * sizeof(struct field));
+
+    if (r->area_of == NULL || r->entries == NULL || r->free_ids == NULL ||
+        r->first == NULL || r->stack == NULL) {
+        if (r->area_of != NULL)
+            free_arr(g, r->area_of);
+        free(r->entries);
+        free(r->free_ids);
+        free(r->first);
+        free(r->stack);
+        free(r);
+        return false;
+    }
+
+    r->capacity = INITIAL_CAPACITY;
+    r->used = 1;
+    r->stack_capacity = INITIAL_CAPACITY;
+    g->registry = r;
+
+    return true;
+}
+
+void registry_delete(gamma_t *g) {
+    struct area_registry *r = g->registry;
+    if (r == NULL)
+        return;
+
+    free_arr(g, r->area_of);
+    free(r->entries);
+    free(r->free_ids);
+    free(r->first);
+    free(r->stack);
+    free(r);
+    g->registry = NULL;
+}
+
+void registry_clear(gamma_t *g) {
+    struct area_registry *r = g->registry;
+
+    clear_arr(g, r->area_of);
+    memset(r->first, 0, g->b_players * sizeof(uint32_t));
+    r->used = 1;
+    r->free_count = 0;
+}
+
+/**
+ * @brief Przydziela numer nowemu obszarowi gracza @p owner i dopisuje go na
+ *        początek listy obszarów gracza.
+ * @param[in, out] r - wskaźnik na rejestr obszarów.
+ * @param[in] owner - numer gracza.
+ * @return Numer nowego obszaru.
+ */
+static uint32_t new_area(struct area_registry *r, uint32_t owner) {
+    uint32_t id;
+
+    if (r->free_count > 0)
+        id = r->free_ids[--r->free_count];
+    else
+        id = r->used++;
+
+    r->entries[id].area.id = id;
+    r->entries[id].area.owner = owner;
+    r->entries[id].loose_box = false;
+    r->entries[id].prev = 0;
+    r->entries[id].next = r->first[owner - 1];
+    if (r->first[owner - 1] != 0)
+        r->entries[r->first[owner - 1]].prev = id;
+    r->first[owner - 1] = id;
+
+    return id;
+}
+
+/**
+ * @brief Usuwa obszar @p id z listy obszarów jego właściciela i zwalnia jego
+ *        numer.
+ * @param[in, out] r - wskaźnik na rejestr obszarów.
+ * @param[in] id - numer obszaru.
+ */
+static void free_area(struct area_registry *r, uint32_t id) {
+    struct area_entry *e = &r->entries[id];
+
+    if (e->prev != 0)
+        r->entries[e->prev].next = e->next;
+    else
+        r->first[e->area.owner - 1] = e->next;
+    if (e->next != 0)
+        r->entries[e->next].prev = e->prev;
+
+    e->area.owner = 0;
+    r->free_ids[r->free_count++] = id;
+}
+
+/**
+ * @brief Rozszerza prostokąt ograniczający obszar @p a o pole (@p x, @p y).
+ * @param[in, out] a - opis obszaru.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ */
+static void extend_box(gamma_area_t *a, uint32_t x, uint32_t y) {
+    if (x < a->min_x)
+        a->min_x = x;
+    if (x > a->max_x)
+        a->max_x = x;
+    if (y < a->min_y)
+        a->min_y = y;
+    if (y > a->max_y)
+        a->max_y = y;
+}
+
+/**
+ * @brief Przepisuje numer @p from na @p to we wszystkich polach spójnego
+ *        obszaru, do którego należy pole (@p x, @p y).
+ * Przegląda obszar w głąb, korzystając ze stosu rejestru. Pole jest
+ * przepisywane w chwili wstawienia na stos, więc trafia tam co najwyżej raz.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] x - pierwsza współrzędna pola startowego.
+ * @param[in] y - druga współrzędna pola startowego.
+ * @param[in] from - numer, który mają pola obszaru.
+ * @param[in] to - nowy numer pól obszaru.
+ * @param[out] info - jeśli nie jest NULL, trafia tu liczba pól obszaru oraz
+ *                    prostokąt go ograniczający.
+ */
+static void flood(gamma_t *g, uint32_t x, uint32_t y, uint32_t from,
+                  uint32_t to, gamma_area_t *info) {
+    struct area_registry *r = g->registry;
+    uint32_t **area_of = r->area_of;
+    struct field *stack = r->stack;
+    uint64_t top = 0;
+
+    area_of[y][x] = to;
+    stack[top].x = x;
+    stack[top].y = y;
+    top++;
+
+    if (info != NULL) {
+        info->size = 0;
+        info->min_x = info->max_x = x;
+        info->min_y = info->max_y = y;
+    }
+
+    GAMMA_COUNT(g, floods, 1);
+    while (top > 0) {
+        top--;
+        uint32_t cx = stack[top].x;
+        uint32_t cy = stack[top].y;
+
+        GAMMA_COUNT(g, flood_fields, 1);
+
+        if (info != NULL) {
+            info->size++;
+            extend_box(info, cx, cy);
+        }
+
+        if (cx > 0 && area_of[cy][cx - 1] == from) {
+            area_of[cy][cx - 1] = to;
+            stack[top].x = cx - 1;
+            stack[top].y = cy;
+            top++;
+        }
+        if (cx < g->b_width - 1 && area_of[cy][cx + 1] == from) {
+            area_of[cy][cx + 1] = to;
+            stack[top].x = cx + 1;
+            stack[top].y = cy;
+            top++;
+        }
+        if (cy > 0 && area_of[cy - 1][cx] == from) {
+            area_of[cy - 1][cx] = to;
+            stack[top].x = cx;
+            stack[top].y = cy - 1;
+            top++;
+        }
+        if (cy < g->b_height - 1 && area_of[cy + 1][cx] == from) {
+            area_of[cy + 1][cx] = to;
+            stack[top].x = cx;
+            stack[top].y = cy + 1;
+            top++;
+        }
+    }
+}
+
+/**
+ * @brief Podaje współrzędne sąsiedniego pola pola (@p x, @p y), które należy
+ *        do obszaru o numerze @p id.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @param[in] id - numer obszaru.
+ * @param[out] nx - pierwsza współrzędna znalezionego pola.
+ * @param[out] ny - druga współrzędna znalezionego pola.
+ */
+static void neighbor_in_area(gamma_t *g, uint32_t x, uint32_t y, uint32_t id,
+                             uint32_t *nx, uint32_t *ny) {
+    uint32_t **area_of = g->registry->area_of;
+
+    *nx = x;
+    *ny = y;
+    if (x > 0 && area_of[y][x - 1] == id)
+        *nx = x - 1;
+    else if (x < g->b_width - 1 && area_of[y][x + 1] == id)
+        *nx = x + 1;
+    else if (y > 0 && area_of[y - 1][x] == id)
+        *ny = y - 1;
+    else
+        *ny = y + 1;
+}
+
+/**
+ * @brief Dopisuje numer @p id do tablicy @p ids, jeśli jeszcze go w niej nie
+ *        ma.
+ * @param[in, out] ids - tablica numerów obszarów.
+ * @param[in, out] n - liczba numerów w tablicy.
+ * @param[in] id - dopisywany numer.
+ */
+static void add_unique(uint32_t ids[], uint32_t *n, uint32_t id) {
+    for (uint32_t i = 0; i < *n; i++) {
+        if (ids[i] == id)
+            return;
+    }
+    ids[(*n)++] = id;
+}
+
+uint32_t adjacent_areas(gamma_t *g, uint32_t player, uint32_t x, uint32_t y,
+                        uint32_t ids[ADJACENT_FIELDS]) {
+    uint32_t **area_of = g->registry->area_of;
+    uint32_t n = 0;
+
+    if (x > 0 && g->board[y][x - 1] == player)
+        add_unique(ids, &n, area_of[y][x - 1]);
+    if (x < g->b_width - 1 && g->board[y][x + 1] == player)
+        add_unique(ids, &n, area_of[y][x + 1]);
+    if (y > 0 && g->board[y - 1][x] == player)
+        add_unique(ids, &n, area_of[y - 1][x]);
+    if (y < g->b_height - 1 && g->board[y + 1][x] == player)
+        add_unique(ids, &n, area_of[y + 1][x]);
+
+    return n;
+}
+
+uint64_t area_size(gamma_t *g, uint32_t x, uint32_t y) {
+    uint32_t id = g->registry->area_of[y][x];
+
+    if (id == 0)
+        return 0;
+
+    return g->registry->entries[id].area.size;
+}
+
+bool reserve_areas(gamma_t *g, uint32_t new_areas, uint64_t flood_cells) {
+    struct area_registry *r = g->registry;
+
+    if (r->capacity - r->used + r->free_count < new_areas) {
+        uint64_t capacity = 2 * (uint64_t)r->capacity;
+        if (capacity < (uint64_t)r->used + new_areas)
+            capacity = (uint64_t)r->used + new_areas;
+        if (capacity > AREA_MARK)
+            capacity = AREA_MARK;
+        if (capacity < (uint64_t)r->used + new_areas)
+            return false;
+
+        struct area_entry *entries = realloc(r->entries,
+                                        capacity * sizeof(struct area_entry));
+        if (entries == NULL)
+            return false;
+        r->entries = entries;
+
+        uint32_t *free_ids = realloc(r->free_ids, capacity * sizeof(uint32_t));
+        if (free_ids == NULL)
+            return false;
+        r->free_ids = free_ids;
+        r->capacity = (uint32_t)capacity;
+    }
+
+    if (r->stack_capacity < flood_cells) {
+        uint64_t capacity = 2 * r->stack_capacity;
+        if (capacity < flood_cells)
+            capacity = flood_cells;
+
+        struct field *stack = realloc(r->stack, capacity * sizeof(struct field));
+        if (stack == NULL)
+            return false;
+        r->stack = stack;
+        r->stack_capacity = capacity;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Podaje indeks największego spośród obszarów @p ids.
+ * @param[in] r - wskaźnik na rejestr obszarów.
+ * @param[in] ids - numery obszarów.
+ * @param[in] n - liczba obszarów, liczba dodatnia.
+ * @return Indeks największego obszaru w tablicy @p ids.
+ */
+static uint32_t largest_area(struct area_registry *r, const uint32_t ids[],
+                             uint32_t n) {
+    uint32_t largest = 0;
+
+    for (uint32_t i = 1; i < n; i++) {
+        if (r->entries[ids[i]].area.size > r->entries[ids[largest]].area.size)
+            largest = i;
+    }
+
+    return largest;
+}
+
+uint64_t merge_cost(gamma_t *g, const uint32_t ids[], uint32_t n) {
+    struct area_registry *r = g->registry;
+    uint64_t cost = 0;
+
+    if (n < 2)
+        return 0;
+
+    uint32_t largest = largest_area(r, ids, n);
+    for (uint32_t i = 0; i < n; i++) {
+        if (i != largest && r->entries[ids[i]].area.size > cost)
+            cost = r->entries[ids[i]].area.size;
+    }
+
+    return cost;
+}
+
+void add_field(gamma_t *g, uint32_t player, uint32_t x, uint32_t y,
+               const uint32_t ids[], uint32_t n) {
+    struct area_registry *r = g->registry;
+
+    if (n == 0) {
+        uint32_t id = new_area(r, player);
+        gamma_area_t *a = &r->entries[id].area;
+        a->size = 1;
+        a->min_x = a->max_x = x;
+        a->min_y = a->max_y = y;
+        r->area_of[y][x] = id;
+        return;
+    }
+
+    uint32_t largest = largest_area(r, ids, n);
+    gamma_area_t *target = &r->entries[ids[largest]].area;
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (i == largest)
+            continue;
+
+        gamma_area_t *merged = &r->entries[ids[i]].area;
+        uint32_t nx, ny;
+        neighbor_in_area(g, x, y, ids[i], &nx, &ny);
+        flood(g, nx, ny, ids[i], ids[largest], NULL);
+
+        target->size += merged->size;
+        if (r->entries[ids[i]].loose_box)
+            r->entries[ids[largest]].loose_box = true;
+        extend_box(target, merged->min_x, merged->min_y);
+        extend_box(target, merged->max_x, merged->max_y);
+        free_area(r, ids[i]);
+    }
+
+    target->size++;
+    extend_box(target, x, y);
+    r->area_of[y][x] = ids[largest];
+}
+
+bool registry_rebuild(gamma_t *g) {
+    struct area_registry *r = g->registry;
+    uint32_t **board = g->board;
+    uint32_t ids[ADJACENT_FIELDS];
+
+    registry_clear(g);
+
+    // sąsiedzi z lewej i z dołu zostali już dodani do rejestru
+    for (uint32_t y = 0; y < g->b_height; y++) {
+        for (uint32_t x = 0; x < g->b_width; x++) {
+            uint32_t owner = board[y][x];
+            uint32_t n = 0;
+
+            if (owner == 0)
+                continue;
+
+            if (x > 0 && board[y][x - 1] == owner)
+                add_unique(ids, &n, r->area_of[y][x - 1]);
+            if (y > 0 && board[y - 1][x] == owner)
+                add_unique(ids, &n, r->area_of[y - 1][x]);
+
+            if (!reserve_areas(g, 1, merge_cost(g, ids, n)))
+                return false;
+            add_field(g, owner, x, y, ids, n);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Indeks oznaczający pusty stos pól przeglądania.
+ */
+static const uint64_t NO_FIELD = UINT64_MAX;
+
+/**
+ * Struktura przechowująca stan przeglądania części, na które rozpada się
+ * obszar po usunięciu z niego pola. Z każdego sąsiedniego pola obszaru
+ * startuje osobne przeglądanie. Przeglądania, które się spotkały, należą do
+ * jednej grupy, opisującej jedną część obszaru.
+ */
+struct split_search {
+    struct field *trail;
+    /**<
+     * Pola w kolejności odwiedzenia, czyli stos rejestru. Pola każdego
+     * z przeglądań tworzą też listę przez pole @p next.
+     */
+    uint64_t length;///< liczba odwiedzonych pól.
+    uint32_t searches;///< liczba przeglądań.
+    uint64_t top[ADJACENT_FIELDS];///< wierzchołki stosów przeglądań.
+    uint32_t parent[ADJACENT_FIELDS];///< przeglądanie nadrzędne w grupie.
+    gamma_area_t parts[ADJACENT_FIELDS];///< pola odwiedzone przez przeglądania.
+};
+
+/**
+ * @brief Podaje sąsiednie pole pola (@p x, @p y) w kierunku @p i.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @param[in] i - numer kierunku, od 0 do ADJACENT_FIELDS - 1.
+ * @param[out] nx - pierwsza współrzędna sąsiedniego pola.
+ * @param[out] ny - druga współrzędna sąsiedniego pola.
+ * @return @p true, gdy sąsiednie pole leży na planszy, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool neighbor(gamma_t *g, uint32_t x, uint32_t y, int i, uint32_t *nx,
+                     uint32_t *ny) {
+    *nx = x;
+    *ny = y;
+    if (i == 0 && x > 0)
+        *nx = x - 1;
+    else if (i == 1 && x < g->b_width - 1)
+        *nx = x + 1;
+    else if (i == 2 && y > 0)
+        *ny = y - 1;
+    else if (i == 3 && y < g->b_height - 1)
+        *ny = y + 1;
+    else
+        return false;
+
+    return true;
+}
+
+/**
+ * @brief Podaje przeglądanie, które reprezentuje grupę przeglądania @p k.
+ * @param[in] s - stan przeglądania.
+ * @param[in] k - numer przeglądania.
+ * @return Numer przeglądania reprezentującego grupę.
+ */
+static uint32_t find_group(const struct split_search *s, uint32_t k) {
+    while (s->parent[k] != k)
+        k = s->parent[k];
+
+    return k;
+}
+
+/**
+ * @brief Sprawdza, czy grupa reprezentowana przez przeglądanie @p k ma
+ *        jeszcze pola do przejrzenia.
+ * @param[in] s - stan przeglądania.
+ * @param[in] k - numer przeglądania reprezentującego grupę.
+ * @return @p true, gdy któreś z przeglądań grupy nie skończyło pracy,
+ *         @p false w przeciwnym przypadku.
+ */
+static bool group_busy(const struct split_search *s, uint32_t k) {
+    for (uint32_t j = 0; j < s->searches; j++) {
+        if (s->top[j] != NO_FIELD && find_group(s, j) == k)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Oznacza pole (@p x, @p y) jako odwiedzone przez przeglądanie @p k
+ *        i wstawia je na jego stos.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in, out] s - stan przeglądania.
+ * @param[in] k - numer przeglądania.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ */
+static void visit(gamma_t *g, struct split_search *s, uint32_t k, uint32_t x,
+                  uint32_t y) {
+    struct field *f = &s->trail[s->length];
+
+    g->registry->area_of[y][x] = AREA_MARK | k;
+    f->x = x;
+    f->y = y;
+    f->next = s->top[k];
+    s->top[k] = s->length++;
+    s->parts[k].size++;
+    extend_box(&s->parts[k], x, y);
+}
+
+/**
+ * @brief Zdejmuje pole ze stosu przeglądania @p k i odwiedza jego
+ *        nieodwiedzonych sąsiadów z obszaru @p id. Spotkanie pola innego
+ *        przeglądania łączy ich grupy.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in, out] s - stan przeglądania.
+ * @param[in] k - numer przeglądania o niepustym stosie.
+ * @param[in] id - numer przeglądanego obszaru.
+ */
+static void search_step(gamma_t *g, struct split_search *s, uint32_t k,
+                        uint32_t id) {
+    uint32_t **area_of = g->registry->area_of;
+    struct field *f = &s->trail[s->top[k]];
+    uint32_t x = f->x, y = f->y;
+
+    s->top[k] = f->next;
+    GAMMA_COUNT(g, flood_fields, 1);
+
+    for (int i = 0; i < ADJACENT_FIELDS; i++) {
+        uint32_t nx, ny;
+        if (!neighbor(g, x, y, i, &nx, &ny))
+            continue;
+
+        uint32_t label = area_of[ny][nx];
+        if (label == id) {
+            visit(g, s, k, nx, ny);
+        }
+        else if ((label & AREA_MARK) != 0) {
+            uint32_t a = find_group(s, k);
+            uint32_t b = find_group(s, label & ~AREA_MARK);
+            if (a != b)
+                s->parent[b] = a;
+        }
+    }
+}
+
+/**
+ * @brief Liczy części, na które rozpada się obszar zawierający pole
+ *        (@p x, @p y) po usunięciu z niego tego pola.
+ * Przegląda obszar jednocześnie od wszystkich sąsiednich pól obszaru, po
+ * jednym polu na przeglądanie w każdej rundzie, i kończy, gdy co najwyżej
+ * jedna część nie została przejrzana do końca. Koszt jest więc proporcjonalny
+ * do rozmiaru mniejszych części, a nie całego obszaru. Pole (@p x, @p y)
+ * dostaje numer 0, a odwiedzone pola numer przeglądania z ustawionym bitem
+ * @p AREA_MARK.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @param[in] max_components - największa dopuszczalna liczba części.
+ * @param[out] s - stan przeglądania.
+ * @param[out] components - liczba części, gdy przeglądanie się powiodło.
+ * @return @p true, gdy części jest co najwyżej @p max_components, @p false,
+ *         gdy jest ich na pewno więcej.
+ */
+static bool search_parts(gamma_t *g, uint32_t x, uint32_t y,
+                         uint32_t max_components, struct split_search *s,
+                         uint32_t *components) {
+    uint32_t **area_of = g->registry->area_of;
+    uint32_t id = area_of[y][x];
+
+    s->trail = g->registry->stack;
+    s->length = 0;
+    s->searches = 0;
+    area_of[y][x] = 0;
+
+    for (int i = 0; i < ADJACENT_FIELDS; i++) {
+        uint32_t nx, ny;
+        if (!neighbor(g, x, y, i, &nx, &ny) || area_of[ny][nx] != id)
+            continue;
+
+        uint32_t k = s->searches++;
+        s->parent[k] = k;
+        s->top[k] = NO_FIELD;
+        s->parts[k].size = 0;
+        s->parts[k].min_x = s->parts[k].max_x = nx;
+        s->parts[k].min_y = s->parts[k].max_y = ny;
+        visit(g, s, k, nx, ny);
+    }
+
+    GAMMA_COUNT(g, floods, 1);
+    for (;;) {
+        uint32_t finished = 0, unfinished = 0;
+
+        for (uint32_t k = 0; k < s->searches; k++) {
+            if (s->parent[k] != k)
+                continue;
+            if (group_busy(s, k))
+                unfinished++;
+            else
+                finished++;
+        }
+
+        // części nieprzejrzanych do końca jest po ich spotkaniu co najmniej
+        // jedna
+        if (finished + (unfinished > 0) > max_components)
+            return false;
+        if (unfinished <= 1) {
+            *components = finished + unfinished;
+            return true;
+        }
+
+        for (uint32_t k = 0; k < s->searches; k++) {
+            if (s->top[k] != NO_FIELD)
+                search_step(g, s, k, id);
+        }
+    }
+}
+
+/**
+ * @brief Cofa zmiany wprowadzone przez funkcję search_parts(...).
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @param[in] id - numer obszaru, do którego należało pole.
+ * @param[in] s - stan przeglądania.
+ */
+static void restore_parts(gamma_t *g, uint32_t x, uint32_t y, uint32_t id,
+                          const struct split_search *s) {
+    uint32_t **area_of = g->registry->area_of;
+
+    for (uint64_t i = 0; i < s->length; i++) {
+        area_of[s->trail[i].y][s->trail[i].x] = id;
+    }
+    area_of[y][x] = id;
+}
+
+bool remove_field(gamma_t *g, uint32_t x, uint32_t y, uint32_t max_components,
+                  uint32_t *components) {
+    struct area_registry *r = g->registry;
+    uint32_t id = r->area_of[y][x];
+    uint32_t owner = r->entries[id].area.owner;
+    struct split_search s;
+
+    if (!search_parts(g, x, y, max_components, &s, components)) {
+        restore_parts(g, x, y, id, &s);
+        return false;
+    }
+
+    if (*components == 0) {
+        free_area(r, id);
+        return true;
+    }
+
+    // części przejrzane do końca znają dokładny rozmiar i prostokąt
+    for (uint32_t k = 0; k < s.searches; k++) {
+        uint32_t root = find_group(&s, k);
+        if (root == k)
+            continue;
+        s.parts[root].size += s.parts[k].size;
+        extend_box(&s.parts[root], s.parts[k].min_x, s.parts[k].min_y);
+        extend_box(&s.parts[root], s.parts[k].max_x, s.parts[k].max_y);
+    }
+
+    // numer obszaru zachowuje część nieprzejrzana do końca, a gdy jej nie
+    // ma – największa
+    uint32_t kept = find_group(&s, 0);
+    bool unfinished = false;
+    for (uint32_t k = 0; k < s.searches; k++) {
+        if (s.parent[k] != k)
+            continue;
+        if (group_busy(&s, k)) {
+            kept = k;
+            unfinished = true;
+            break;
+        }
+        if (s.parts[k].size > s.parts[kept].size)
+            kept = k;
+    }
+
+    uint32_t part_id[ADJACENT_FIELDS];
+    uint64_t moved = 0;
+    for (uint32_t k = 0; k < s.searches; k++) {
+        if (s.parent[k] != k || k == kept)
+            continue;
+
+        part_id[k] = new_area(r, owner);
+        s.parts[k].id = part_id[k];
+        s.parts[k].owner = owner;
+        r->entries[part_id[k]].area = s.parts[k];
+        moved += s.parts[k].size;
+    }
+
+    part_id[kept] = id;
+    if (unfinished) {
+        r->entries[id].area.size -= moved + 1;
+        r->entries[id].loose_box = true;
+    }
+    else {
+        s.parts[kept].id = id;
+        s.parts[kept].owner = owner;
+        r->entries[id].area = s.parts[kept];
+        r->entries[id].loose_box = false;
+    }
+
+    for (uint64_t i = 0; i < s.length; i++) {
+        uint32_t *label = &r->area_of[s.trail[i].y][s.trail[i].x];
+        *label = part_id[find_group(&s, *label & ~AREA_MARK)];
+    }
+
+    return true;
+}
+
+void fit_area_box(gamma_t *g, uint32_t id) {
+    struct area_registry *r = g->registry;
+    struct area_entry *e = &r->entries[id];
+    gamma_area_t box = e->area;
+    bool found = false;
+
+    if (!e->loose_box)
+        return;
+
+    for (uint32_t y = box.min_y; y <= box.max_y; y++) {
+        for (uint32_t x = box.min_x; x <= box.max_x; x++) {
+            if (r->area_of[y][x] != id)
+                continue;
+            if (!found) {
+                e->area.min_x = e->area.max_x = x;
+                e->area.min_y = e->area.max_y = y;
+                found = true;
+            }
+            extend_box(&e->area, x, y);
+        }
+    }
+
+    e->loose_box = false;
+}
+
+/**
+ * @brief Sprawdza, czy pole (@p x, @p y) należy do gracza @p player.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] x - pierwsza współrzędna pola, może wykraczać poza planszę.
+ * @param[in] y - druga współrzędna pola, może wykraczać poza planszę.
+ * @param[in] player - numer gracza.
+ * @return @p true, gdy pole leży na planszy i należy do gracza, @p false
+ *         w przeciwnym przypadku.
+ */
+static bool owned_by(gamma_t *g, int64_t x, int64_t y, uint32_t player) {
+    return x >= 0 && y >= 0 && x < g->b_width && y < g->b_height &&
+           g->board[y][x] == player;
+}
+
+/**
+ * @brief Szacuje z góry liczbę części, na które rozpadnie się obszar po
+ *        usunięciu z niego pola (@p x, @p y), patrząc tylko na otoczenie pola.
+ * Sąsiednie pola obszaru leżące na rogu wspólnego narożnego pola obszaru
+ * na pewno pozostaną w jednej części.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] x - pierwsza współrzędna zajętego pola.
+ * @param[in] y - druga współrzędna zajętego pola.
+ * @return Górne ograniczenie liczby części.
+ */
+static uint32_t local_parts(gamma_t *g, uint32_t x, uint32_t y) {
+    // sąsiedzi w kolejności wokół pola, po każdym z nich narożnik między nim
+    // a następnym sąsiadem
+    static const int dx[2 * ADJACENT_FIELDS] = {-1, -1, 0, 1, 1, 1, 0, -1};
+    static const int dy[2 * ADJACENT_FIELDS] = {0, -1, -1, -1, 0, 1, 1, 1};
+    uint32_t owner = g->board[y][x];
+    bool near[2 * ADJACENT_FIELDS];
+    uint32_t sides = 0, links = 0;
+
+    for (int i = 0; i < 2 * ADJACENT_FIELDS; i++) {
+        near[i] = owned_by(g, (int64_t)x + dx[i], (int64_t)y + dy[i], owner);
+    }
+
+    for (int i = 0; i < 2 * ADJACENT_FIELDS; i += 2) {
+        if (near[i]) {
+            sides++;
+            if (near[i + 1] && near[(i + 2) % (2 * ADJACENT_FIELDS)])
+                links++;
+        }
+    }
+
+    if (sides == 0)
+        return 0;
+    if (links >= sides)
+        return 1;
+    return sides - links;
+}
+
+bool field_can_be_taken(gamma_t *g, uint32_t x, uint32_t y, bool *allowed) {
+    uint32_t owner = g->board[y][x];
+    uint32_t slack = g->areas_limit - g->busy_areas[owner - 1];
+
+    GAMMA_COUNT(g, take_checks, 1);
+
+    // obszar rozpadający się na k części zwiększa liczbę obszarów o k - 1
+    if (local_parts(g, x, y) <= (uint64_t)slack + 1) {
+        *allowed = true;
+        return true;
+    }
+
+    if (!reserve_areas(g, 0, area_size(g, x, y)))
+        return false;
+
+    GAMMA_COUNT(g, take_floods, 1);
+
+    uint32_t id = g->registry->area_of[y][x];
+    struct split_search s;
+    uint32_t k;
+
+    *allowed = search_parts(g, x, y, slack + 1, &s, &k);
+    restore_parts(g, x, y, id, &s);
+
+    return true;
+}
@@ -0,0 +1,199 @@
+/** @file
+ * Interfejs modułu przechowującego rejestr obszarów zajętych przez graczy.
+ * Rejestr jest aktualizowany przy każdym ruchu, a koszt aktualizacji zależy
+ * od wielkości zmienianych obszarów, a nie od wielkości planszy.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#ifndef AREAS_H
+#define AREAS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "gamma.h"
+#include "moves.h"
+
+/**
+ * Struktura przechowująca współrzędne pola.
+ */
+struct field {
+    uint32_t x;///< pierwsza współrzędna.
+    uint32_t y;///< druga współrzędna.
+    uint64_t next;///< indeks następnego pola na stosie przeglądania obszaru.
+};
+
+/**
+ * Struktura przechowująca wpis rejestru obszarów.
+ */
+struct area_entry {
+    gamma_area_t area;///< opis obszaru, właściciel 0 oznacza wolny wpis.
+    uint32_t prev;///< poprzedni obszar na liście obszarów gracza (0 - brak).
+    uint32_t next;///< następny obszar na liście obszarów gracza (0 - brak).
+    bool loose_box;
+    /**<
+     * Czy prostokąt w opisie obszaru może być większy od najmniejszego
+     * prostokąta ograniczającego obszar.
+     */
+};
+
+/**
+ * Struktura przechowująca rejestr obszarów.
+ */
+struct area_registry {
+    uint32_t **area_of;
+    /**<
+     * Tablica o wymiarach takich jak plansza, zawierająca numery obszarów,
+     * do których należą pola. Wolne pola mają numer 0.
+     */
+    struct area_entry *entries;///< wpisy rejestru indeksowane numerami obszarów.
+    uint32_t capacity;///< rozmiar tablic @p entries i @p free_ids.
+    uint32_t used;///< najmniejszy numer, który nie był jeszcze używany.
+    uint32_t *free_ids;///< stos numerów zwolnionych obszarów.
+    uint32_t free_count;///< liczba numerów na stosie @p free_ids.
+    uint32_t *first;///< pierwszy obszar na liście obszarów każdego z graczy.
+    struct field *stack;///< pola odwiedzane przy przeglądaniu obszarów.
+    uint64_t stack_capacity;///< rozmiar stosu @p stack.
+};
+
+/**
+ * @brief Alokuje pusty rejestr obszarów dla gry @p g.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool registry_new(gamma_t *g);
+
+/**
+ * @brief Zwalnia pamięć zajmowaną przez rejestr obszarów gry @p g.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ */
+extern void registry_delete(gamma_t *g);
+
+/**
+ * @brief Usuwa z rejestru wszystkie obszary.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ */
+extern void registry_clear(gamma_t *g);
+
+/**
+ * @brief Podaje numery różnych obszarów gracza @p player, sąsiadujących
+ *        z polem (@p x, @p y).
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @param[out] ids - tablica, do której trafią numery obszarów.
+ * @return Liczba różnych obszarów gracza sąsiadujących z polem.
+ */
+extern uint32_t adjacent_areas(gamma_t *g, uint32_t player, uint32_t x,
+                               uint32_t y, uint32_t ids[ADJACENT_FIELDS]);
+
+/**
+ * @brief Podaje liczbę pól obszaru, do którego należy pole (@p x, @p y).
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @return Liczba pól obszaru lub 0, gdy pole jest wolne.
+ */
+extern uint64_t area_size(gamma_t *g, uint32_t x, uint32_t y);
+
+/**
+ * @brief Rezerwuje pamięć potrzebną do wykonania ruchu, by funkcje
+ *        add_field(...) oraz remove_field(...) nie musiały jej alokować.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] new_areas - liczba obszarów, które mogą zostać utworzone.
+ * @param[in] flood_cells - największa liczba pól obszaru, który może zostać
+ *                          przejrzany.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool reserve_areas(gamma_t *g, uint32_t new_areas,
+                          uint64_t flood_cells);
+
+/**
+ * @brief Podaje, jak duży obszar może zostać przejrzany przy łączeniu
+ *        obszarów @p ids, czyli rozmiar największego spośród nich poza
+ *        największym.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] ids - numery łączonych obszarów.
+ * @param[in] n - liczba łączonych obszarów.
+ * @return Liczba pól.
+ */
+extern uint64_t merge_cost(gamma_t *g, const uint32_t ids[], uint32_t n);
+
+/**
+ * @brief Dodaje do rejestru pole (@p x, @p y) zajęte przez gracza @p player.
+ * Gdy pole nie sąsiaduje z obszarami gracza, tworzy nowy obszar. W przeciwnym
+ * przypadku dołącza pole do największego z sąsiednich obszarów i przepisuje
+ * do niego pola pozostałych sąsiednich obszarów.
+ * Wymaga wcześniejszego wywołania funkcji reserve_areas(...).
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @param[in] ids - numery obszarów gracza sąsiadujących z polem, zwrócone
+ *                  przez funkcję adjacent_areas(...).
+ * @param[in] n - liczba sąsiadujących obszarów.
+ */
+extern void add_field(gamma_t *g, uint32_t player, uint32_t x, uint32_t y,
+                      const uint32_t ids[], uint32_t n);
+
+/**
+ * @brief Wypełnia rejestr obszarami zajętymi przez graczy na planszy,
+ *        przeglądając ją wiersz po wierszu.
+ * Usuwa z rejestru wcześniejsze obszary.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool registry_rebuild(gamma_t *g);
+
+/**
+ * @brief Usuwa z rejestru zajęte pole (@p x, @p y), o ile obszar, do którego
+ *        należy, nie rozpadnie się na więcej niż @p max_components części.
+ * Części są przeglądane jednocześnie od sąsiadów pola, aż co najwyżej jedna
+ * z nich nie zostanie przejrzana do końca. Ta część zachowuje numer obszaru
+ * i prostokąt, który odtąd może być za duży, a pozostałe dostają nowe numery.
+ * Gdy wszystkie części zostały przejrzane, numer zachowuje największa.
+ * Wymaga wcześniejszego wywołania funkcji reserve_areas(...).
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @param[in] max_components - największa dopuszczalna liczba części.
+ * @param[out] components - liczba części, na które rozpada się obszar.
+ * @return @p true, gdy pole zostało usunięte, @p false, gdy obszar rozpadłby
+ *         się na zbyt wiele części. Wtedy rejestr nie jest zmieniany.
+ */
+extern bool remove_field(gamma_t *g, uint32_t x, uint32_t y,
+                         uint32_t max_components, uint32_t *components);
+
+/**
+ * @brief Sprawdza, czy zajęte pole (@p x, @p y) może zostać odebrane jego
+ *        właścicielowi złotym ruchem, czyli czy właściciel nie przekroczy
+ *        przez to limitu obszarów.
+ * Najpierw ogranicza liczbę części, na które rozpadnie się obszar, patrząc
+ * tylko na otoczenie pola. Dopiero gdy to nie wystarcza, przegląda części
+ * obszaru tak jak funkcja remove_field(...). Nie zmienia stanu gry.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @param[out] allowed - @p true, gdy pole może zostać odebrane, @p false
+ *                       w przeciwnym przypadku.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool field_can_be_taken(gamma_t *g, uint32_t x, uint32_t y,
+                               bool *allowed);
+
+/**
+ * @brief Zawęża prostokąt w opisie obszaru @p id do najmniejszego prostokąta
+ *        ograniczającego obszar, jeśli może być od niego większy.
+ * Przegląda pola dotychczasowego prostokąta.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] id - numer obszaru.
+ */
+extern void fit_area_box(gamma_t *g, uint32_t id);
+
+#endif /* AREAS_H */
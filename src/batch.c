@@ -13,7 +13,14 @@
 #include <errno.h>
 #include <stdbool.h>
 #include <inttypes.h>
+#include <unistd.h>
+#include <pthread.h>
 #include "parser.h"
+#include "output.h"
+#include "ring.h"
+#include "tpool.h"
+#include "journal.h"
+#include "latency.h"
 #include "batch.h"
 
 /**
@@ -30,230 +37,1021 @@ static const int G_M_NUMBER_OF_PARAMETERS = 4;
 static const int B_F_Q_NUMBER_OF_PARAMETERS = 2;
 
 /**Liczba parametrów wymagana do poprawnego wywołania funkcji
- * gamma_board(...).
+ * gamma_board(...), gamma_stats_all(...) oraz gamma_influence_map(...)
+ * oraz poleceń @p r, @p o i @p d.
  * 
  */
 static const int P_NUMBER_OF_PARAMETERS = 1;
 
 /**
- * @brief Sprawdza poprawność ciągów znaków, składających się na linię.
- * @param[in] words - tablica wskaźników do kolejnych ciągów znaków.
- * @param[in] number_of_words_in_line - liczba ciągów znaków w linii.
- * @return @p true, gdy ciągi znaków w linii odpowiadają poprawnemu poleceniu
- *         wykonania funkcji z silnika, @p false w przeciwnym przypadku.
- */
-static bool batch_check_line(char **words, int number_of_words_in_line) {
-    bool check = true;
-    // sprawdzanie poprawności całego pierwszego słowa (strcmp)
-    if ((strcmp(words[0], "m") == 0 || strcmp(words[0], "g") == 0)
-        && number_of_words_in_line == G_M_NUMBER_OF_PARAMETERS) {
-        for (int i = 1; i < number_of_words_in_line; i++) {
-            if (!check_num_parameter(words[i])) {
-                check = false;
-            }
-        }
-        if (check) {
-            return true;
-        }
-    }
-    else if ((strcmp(words[0], "b") == 0 || strcmp(words[0], "f") == 0
-            || strcmp(words[0], "q") == 0)
-            && number_of_words_in_line == B_F_Q_NUMBER_OF_PARAMETERS) {
-        if (check_num_parameter(words[1])) {
-            return true;
-        }
+ * Nazwa polecenia kończącego sesję trybu wsadowego.
+ */
+static const char SESSION_END = 'E';
+
+/**
+ * Początkowy rozmiar tablicy linii sesji wczytywanej z wyprzedzeniem.
+ */
+static const size_t SESSION_LINES = 64;
+
+/**
+ * Liczba miejsc w kolejce linii między etapem wczytywania a etapem
+ * wykonywania poleceń.
+ */
+static const size_t PIPELINE_LINES = 4096;
+
+/**
+ * Liczba miejsc w kolejce wyników między etapem wykonywania poleceń
+ * a etapem drukowania.
+ */
+static const size_t PIPELINE_RESULTS = 4096;
+
+/**
+ * Rodzaje wyników przekazywanych do etapu drukowania.
+ */
+enum result_kind {
+    RESULT_VALUE,///< liczba, drukowana w osobnej linii.
+    RESULT_ERROR,///< komunikat o błędzie w linii o podanym numerze.
+    RESULT_TEXT,///< gotowy tekst dla strumienia wyników.
+    RESULT_ERROR_TEXT,///< gotowy tekst dla strumienia komunikatów o błędach.
+    RESULT_END///< koniec sesji.
+};
+
+/**
+ * Struktura przechowująca wynik polecenia przekazywany do etapu drukowania.
+ */
+struct batch_result {
+    enum result_kind kind;///< rodzaj wyniku.
+    uint64_t value;///< liczba lub numer linii z błędem.
+    char *text;///< tekst, zwalniany przez etap drukowania.
+    size_t length;///< długość tekstu.
+};
+
+/**
+ * Struktura przechowująca stan przetwarzania potokowego sesji: wątek
+ * wczytujący linie, wątek wykonujący polecenia i wątek drukujący wyniki.
+ */
+struct pipeline {
+    struct ring lines;///< kolejka wczytanych linii typu batch_line.
+    struct ring results;///< kolejka wyników typu batch_result.
+    struct line_reader *r;///< stan wczytywania wejścia.
+    unsigned long long line_number;///< numer ostatnio wczytanej linii.
+    struct output *out;///< strumień wyników.
+    struct output *err;///< strumień komunikatów o błędach.
+    bool shared;///< czy @p out i @p err to ten sam strumień.
+    struct journal *journal;///< dziennik udanych ruchów lub NULL.
+};
+
+/**
+ * Rozmiar rekordu polecenia w trybie binarnym: kod polecenia, numer gracza
+ * i dwie współrzędne, zapisane jako czterobajtowe liczby little-endian.
+ */
+#define BINARY_COMMAND_SIZE 16
+
+/**
+ * Rozmiar rekordu wyniku w trybie binarnym: ośmiobajtowa liczba
+ * little-endian.
+ */
+#define BINARY_RESULT_SIZE 8
+
+/**
+ * Wynik niepoprawnego polecenia w trybie binarnym. Żadne poprawne polecenie
+ * nie zwraca tej wartości.
+ */
+static const uint64_t BINARY_ERROR = UINT64_MAX;
+
+/**
+ * @brief Sprawdza, czy polecenie z linii jest poprawnym poleceniem trybu
+ *        wsadowego.
+ * @param[in] cmd - polecenie z linii.
+ * @return @p true, gdy polecenie odpowiada poprawnemu wywołaniu funkcji
+ *         z silnika, @p false w przeciwnym przypadku.
+ */
+static bool batch_check_line(const struct command *cmd) {
+    if (!cmd->numbers_valid) {
+        return false;
     }
-    else if (strcmp(words[0], "p") == 0 &&
-            number_of_words_in_line == P_NUMBER_OF_PARAMETERS) {
-        return true;
+
+    switch (cmd->name) {
+        case 'm':
+        case 'g':
+            return cmd->words == G_M_NUMBER_OF_PARAMETERS;
+        case 'b':
+        case 'f':
+        case 'q':
+        case 'a':
+            return cmd->words == B_F_Q_NUMBER_OF_PARAMETERS;
+        case 'p':
+        case 's':
+        case 'i':
+        case 'r':
+        case 'o':
+        case 'd':
+            return cmd->words == P_NUMBER_OF_PARAMETERS;
+        default:
+            return false;
     }
+}
 
-    return false;
+/**
+ * @brief Drukuje wynik polecenia, które zwraca wartość logiczną.
+ * @param[in, out] out - strumień wyników.
+ * @param[in] value - wynik polecenia.
+ */
+static void print_bool(struct output *out, bool value) {
+    output_bytes(out, value ? "1\n" : "0\n", 2);
+}
+
+void batch_print_error(struct output *err, unsigned long long line_number) {
+    output_bytes(err, "ERROR ", 6);
+    output_u64(err, line_number);
+    output_char(err, '\n');
 }
 
 /**
- * @brief Sprawdza, czy pierwszy znak w linii z wejścia odpowiada jednej z
- *        funkcji z silnika, które można za pomocą trybu wsadowego wywołać.
- * 
- * @param[in] buff - wskaźnik na początek rozpatrywanego ciągu znaków.
- * @return @p true w przypadku, gdy pierwszy znak w rozpatrywanym ciągu znaków
- *         odpowiada poprawnej dla trybu wsadowego linii, @p false w przeciwnym
- *         przypadku. 
- */
-static bool check_first_char(char *buff) {
-    if (buff[0] != 'm' && buff[0] != 'g' && buff[0] != 'b' && buff[0] != 'f'
-        && buff[0] != 'q' && buff[0] != 'p') {
-            return false;
-        }
-    return true;
+ * @brief Drukuje współrzędne pola i numer gracza w postaci @p x_y_gracz.
+ * @param[in, out] out - strumień wyników.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @param[in] owner - numer gracza.
+ */
+static void print_field(struct output *out, uint32_t x, uint32_t y,
+                        uint32_t owner) {
+    output_u64(out, x);
+    output_char(out, ' ');
+    output_u64(out, y);
+    output_char(out, ' ');
+    output_u64(out, owner);
+    output_char(out, '\n');
 }
 
 /**
- * @brief Konwertuje ciągi znaków z poprawnej linii na liczby i wykonuje
- *        zadane w linijce wywołanie odpowiedniej funkcji z silnika, która
- *        wymaga czterech parametrów. 
+ * @brief Wykonuje ruch lub złoty ruch z polecenia.
  * @param[in, out] g - wskaźnik na strukturę, przechowującą obecny stan gry.
- * @param[in] words - tablica wskaźników do pierwszych znaków kolejnych ciągów
- *                znaków z polecenia.
+ * @param[in] cmd - polecenie @p m lub @p g.
  * @return @p true, gdy wywołana funkcja zwróci @p true, @p false, w przypadku,
  *         kiedy wywołana funkcja zwróci @p false.
  */
-static bool four_param_functions(gamma_t *g, char **words) {
-    char *pointer_to_end;
+static bool four_param_functions(gamma_t *g, const struct command *cmd) {
+    if (cmd->name == 'm')
+        return gamma_move(g, cmd->params[0], cmd->params[1], cmd->params[2]);
+
+    return gamma_golden_move(g, cmd->params[0], cmd->params[1],
+                             cmd->params[2]);
+}
+
+/**
+ * @brief Wywołuje funkcję z silnika, która wymaga dwóch parametrów.
+ * @param[in, out] g - wskaźnik na strukturę, przechowującą obecny stan gry.
+ * @param[in] cmd - polecenie @p b lub @p f.
+ * @return Wartość zwracana przez wywołaną funkcję.
+ */
+static uint64_t two_param_functions(gamma_t *g, const struct command *cmd) {
+    if (cmd->name == 'b')
+        return gamma_busy_fields(g, cmd->params[0]);
+
+    return gamma_free_fields(g, cmd->params[0]);
+}
+
+/**
+ * @brief Wywołuje funkcję z silnika, której wynikiem jest jedna liczba:
+ *        polecenia @p m, @p g, @p b, @p f oraz @p q.
+ * Z tego wywołania korzysta zarówno tekstowy, jak i binarny tryb wsadowy.
+ * Wymaga wyzerowania @p errno przed wywołaniem.
+ * @param[in, out] g - wskaźnik na strukturę, przechowującą obecny stan gry.
+ * @param[in] cmd - poprawne polecenie.
+ * @param[out] result - wynik funkcji, 1 lub 0 dla funkcji zwracających
+ *                      wartość logiczną.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią, @p false
+ *         w przeciwnym przypadku.
+ */
+static bool engine_call(gamma_t *g, const struct command *cmd,
+                        uint64_t *result) {
+    uint64_t start = latency_begin();
     bool check;
-    unsigned long param1 = strtoul(words[1], &pointer_to_end, 10);
-    unsigned long param2 = strtoul(words[2], &pointer_to_end, 10);
-    unsigned long param3 = strtoul(words[3], &pointer_to_end, 10);
 
-    if (strcmp(words[0], "m") == 0) {
-        check = gamma_move(g, (uint32_t)param1, (uint32_t)param2,
-                            (uint32_t)param3);
+    if (cmd->name == 'b' || cmd->name == 'f') {
+        *result = two_param_functions(g, cmd);
+        latency_end(cmd->name, start);
+        return true;
     }
-    else {
-        check = gamma_golden_move(g, (uint32_t)param1, (uint32_t)param2,
-                                    (uint32_t)param3);
+
+    if (cmd->name == 'q')
+        check = gamma_golden_possible(g, cmd->params[0]);
+    else
+        check = four_param_functions(g, cmd);
+
+    latency_end(cmd->name, start);
+    *result = check ? 1 : 0;
+    return check || errno != ENOMEM;
+}
+
+/**
+ * @brief Sprawdza, czy wynikiem polecenia jest jedna liczba, obliczana
+ *        funkcją engine_call(...).
+ * @param[in] cmd - poprawne polecenie.
+ * @return @p true dla poleceń @p m, @p g, @p b, @p f oraz @p q, @p false
+ *         w przeciwnym przypadku.
+ */
+static bool returns_value(const struct command *cmd) {
+    return cmd->name == 'm' || cmd->name == 'g' || cmd->name == 'b' ||
+           cmd->name == 'f' || cmd->name == 'q';
+}
+
+/**
+ * @brief Porównuje opisy obszarów według ich numerów.
+ * @param[in] a - wskaźnik na pierwszy opis obszaru.
+ * @param[in] b - wskaźnik na drugi opis obszaru.
+ * @return Liczba ujemna, zero lub dodatnia, gdy numer pierwszego obszaru jest
+ *         odpowiednio mniejszy, równy lub większy od numeru drugiego.
+ */
+static int compare_areas(const void *a, const void *b) {
+    uint32_t id_a = ((const gamma_area_t *)a)->id;
+    uint32_t id_b = ((const gamma_area_t *)b)->id;
+
+    return (id_a > id_b) - (id_a < id_b);
+}
+
+/**
+ * @brief Drukuje obszary gracza podanego w poleceniu @p a.
+ * W pierwszej linii drukuje liczbę obszarów, a w kolejnych, w kolejności
+ * numerów obszarów: numer, liczbę pól oraz współrzędne lewego dolnego
+ * i prawego górnego rogu prostokąta ograniczającego obszar.
+ * @param[in, out] out - strumień wyników.
+ * @param[in] g - wskaźnik na strukturę, przechowującą obecny stan gry.
+ * @param[in] player - numer gracza z polecenia.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool print_player_areas(struct output *out, gamma_t *g,
+                               uint32_t player) {
+    uint32_t count = gamma_player_areas(g, player, NULL, 0);
+    gamma_area_t *areas = malloc(count * sizeof(gamma_area_t));
+
+    if (areas == NULL && count > 0)
+        return false;
+
+    gamma_player_areas(g, player, areas, count);
+    qsort(areas, count, sizeof(gamma_area_t), compare_areas);
+
+    output_u64(out, count);
+    output_char(out, '\n');
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t values[] = {areas[i].id, areas[i].size, areas[i].min_x,
+                             areas[i].min_y, areas[i].max_x, areas[i].max_y};
+
+        for (size_t j = 0; j < sizeof(values) / sizeof(values[0]); j++) {
+            if (j > 0)
+                output_char(out, ' ');
+            output_u64(out, values[j]);
+        }
+        output_char(out, '\n');
     }
 
-    return check;
+    free(areas);
+    return true;
 }
 
 /**
- * @brief Konwertuje ciągi znaków z poprawnej linii na liczby i wykonuje
- *        zadane w linijce wywołanie odpowiedniej funkcji z silnika, która
- *        wymaga dwóch parametrów.
+ * @brief Drukuje statystyki wszystkich graczy (polecenie @p s).
+ * Dla każdego gracza drukuje w osobnej linii liczbę zajętych przez niego pól,
+ * liczbę pól, które może zająć w następnym ruchu, oraz 1 lub 0 w zależności
+ * od tego, czy może wykonać złoty ruch.
+ * @param[in, out] out - strumień wyników.
  * @param[in, out] g - wskaźnik na strukturę, przechowującą obecny stan gry.
- * @param[in] words - tablica wskaźników do pierwszych znaków kolejnych ciągów
- *                znaków z polecenia.
- * @return Wartość zwracana przez wywołaną funkcję.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
  */
-static uint64_t two_param_functions(gamma_t *g, char **words) {
-    char *pointer_to_end;
-    uint64_t num = 0;
-    unsigned long param1 = strtoul(words[1], &pointer_to_end, 10);
+static bool print_stats(struct output *out, gamma_t *g) {
+    uint32_t players = gamma_players(g);
+    gamma_player_stats_t *stats =
+        malloc(players * sizeof(gamma_player_stats_t));
 
-    if (strcmp(words[0], "b") == 0) {
-        num = gamma_busy_fields(g, (uint32_t)param1);
+    if (stats == NULL || !gamma_stats_all(g, stats)) {
+        free(stats);
+        return false;
     }
-    else if (strcmp(words[0], "f") == 0) {
-        num = gamma_free_fields(g, (uint32_t)param1);
+
+    for (uint32_t i = 0; i < players; i++) {
+        output_u64(out, stats[i].busy);
+        output_char(out, ' ');
+        output_u64(out, stats[i].free);
+        output_char(out, ' ');
+        print_bool(out, stats[i].golden_possible);
     }
 
-    return num;
+    free(stats);
+    return true;
+}
+
+/**
+ * @brief Drukuje mapę wpływów graczy (polecenie @p i).
+ * Drukuje kolejne wiersze planszy, zaczynając od górnego, tak jak funkcja
+ * gamma_board(...). Każde pole opisuje jako @p gracz:odległość, oddzielając
+ * pola spacjami. Pole sporne ma gracza 0, a gdy na planszy nie ma pionków,
+ * zamiast odległości drukowany jest znak '-'.
+ * @param[in, out] out - strumień wyników.
+ * @param[in] g - wskaźnik na strukturę, przechowującą obecny stan gry.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool print_influence(struct output *out, gamma_t *g) {
+    gamma_influence_t *map = gamma_influence_map(g, 0);
+
+    if (map == NULL)
+        return false;
+
+    uint32_t width = gamma_width(g);
+    for (uint32_t y = gamma_height(g); y-- > 0;) {
+        gamma_influence_t *row = map + (uint64_t)y * width;
+
+        for (uint32_t x = 0; x < width; x++) {
+            if (x > 0)
+                output_char(out, ' ');
+            output_u64(out, row[x].owner);
+            output_char(out, ':');
+            if (row[x].distance == UINT32_MAX)
+                output_char(out, '-');
+            else
+                output_u64(out, row[x].distance);
+        }
+        output_char(out, '\n');
+    }
+
+    free(map);
+    return true;
+}
+
+/**
+ * @brief Drukuje planszę zakodowaną długościami serii (polecenie @p r).
+ * Drukuje kolejne wiersze planszy, zaczynając od górnego. Wiersz opisuje
+ * jako ciąg serii jednakowych pól w postaci @p długość:gracz, oddzielonych
+ * spacjami, gdzie gracz 0 oznacza wolne pola. Serie wolnych pól są
+ * znajdowane bez przeglądania ich pól po kolei.
+ * @param[in, out] out - strumień wyników.
+ * @param[in] g - wskaźnik na strukturę, przechowującą obecny stan gry.
+ */
+static void print_runs(struct output *out, gamma_t *g) {
+    uint32_t width = gamma_width(g);
+
+    for (uint32_t y = gamma_height(g); y-- > 0;) {
+        uint32_t x = 0;
+        uint32_t owner;
+        bool first = true;
+
+        while (x < width) {
+            uint32_t next = x;
+            uint32_t length;
+
+            if (!gamma_next_busy(g, y, &next, &owner))
+                next = width;
+
+            if (next > x) {
+                length = next - x;
+                owner = 0;
+            }
+            else {
+                // seria zajętych pól kończy się na innym graczu lub wolnym polu
+                uint32_t other;
+                length = 0;
+                do {
+                    length++;
+                    next = x + length;
+                } while (gamma_next_busy(g, y, &next, &other) &&
+                         next == x + length && other == owner);
+            }
+
+            if (!first)
+                output_char(out, ' ');
+            output_u64(out, length);
+            output_char(out, ':');
+            output_u64(out, owner);
+            first = false;
+            x += length;
+        }
+        output_char(out, '\n');
+    }
+}
+
+/**
+ * @brief Drukuje listę zajętych pól planszy (polecenie @p o).
+ * W pierwszej linii drukuje liczbę zajętych pól, a w kolejnych, wiersz po
+ * wierszu, zaczynając od górnego: współrzędne pola i numer gracza, który je
+ * zajmuje.
+ * @param[in, out] out - strumień wyników.
+ * @param[in] g - wskaźnik na strukturę, przechowującą obecny stan gry.
+ */
+static void print_occupied(struct output *out, gamma_t *g) {
+    output_u64(out, gamma_occupied_fields(g));
+    output_char(out, '\n');
+
+    for (uint32_t y = gamma_height(g); y-- > 0;) {
+        uint32_t x = 0;
+        uint32_t owner;
+
+        while (gamma_next_busy(g, y, &x, &owner)) {
+            print_field(out, x, y, owner);
+            x++;
+        }
+    }
+}
+
+/**
+ * @brief Drukuje pola zmienione od poprzedniego polecenia @p p lub @p d
+ *        (polecenie @p d).
+ * W pierwszej linii drukuje liczbę zmienionych pól, a w kolejnych, wiersz po
+ * wierszu, zaczynając od górnego: współrzędne pola i numer gracza, który je
+ * teraz zajmuje (0 dla pola wolnego). Przed pierwszym poleceniem @p p lub
+ * @p d zmianami są wszystkie zajęte pola.
+ * @param[in, out] out - strumień wyników.
+ * @param[in, out] g - wskaźnik na strukturę, przechowującą obecny stan gry.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool print_changes(struct output *out, gamma_t *g) {
+    if (!gamma_track_changes(g, true))
+        return false;
+
+    output_u64(out, gamma_changed_fields(g));
+    output_char(out, '\n');
+
+    for (uint32_t y = gamma_height(g); y-- > 0;) {
+        uint32_t x = 0;
+        uint32_t owner;
+
+        while (gamma_next_changed(g, y, &x, &owner)) {
+            print_field(out, x, y, owner);
+            x++;
+        }
+    }
+
+    gamma_clear_changes(g);
+    return true;
+}
+
+/**
+ * @brief Zapisuje w dzienniku udany ruch lub złoty ruch.
+ * @param[in, out] journal - dziennik lub NULL, gdy ruchy nie są zapisywane.
+ * @param[in] g - wskaźnik na strukturę, przechowującą obecny stan gry.
+ * @param[in] cmd - poprawne polecenie.
+ * @param[in] result - wynik polecenia obliczony funkcją engine_call(...).
+ * @param[in] line_number - numer linii z poleceniem.
+ * @return @p true, gdy nie trzeba było nic zapisywać lub udało się zapisać
+ *         dziennik, @p false w przeciwnym przypadku.
+ */
+static bool log_move(struct journal *journal, gamma_t *g,
+                     const struct command *cmd, uint64_t result,
+                     unsigned long long line_number) {
+    if (journal == NULL || result == 0 ||
+        (cmd->name != 'm' && cmd->name != 'g'))
+        return true;
+
+    return journal_move(journal, g, cmd->name == 'g', cmd->params[0],
+                        cmd->params[1], cmd->params[2], line_number);
 }
 
 /**
  * @brief Wywołuje polecenie z poprawnej linijki w batch mode.
  * Obsługuje problemy z pamięcią. Drukuje zinterpretowane wyniki wywołania
  * funkcji. 
+ * @param[in, out] out - strumień wyników.
+ * @param[in, out] err - strumień komunikatów o błędach.
  * @param[in, out] g - wskaźnik na strukturę, przechowującą obecny stan gry.
- * @param[in] words - tablica wskaźników na pierwsze znaki kolejnych ciągów
- *                    znaków, oddzielonych białymi znakami, z wejścia.
+ * @param[in] cmd - poprawne polecenie z wejścia.
  * @param[in] line_number - numer linii, na której wystąpiło obecnie rozpatrywane
  *                      polecenie.
- * @return @p true, gdy nie wystąpiły problemy z pamięcią, @p false
- *         w przeciwnym przypadku. 
+ * @param[in, out] journal - dziennik udanych ruchów lub NULL.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią ani z zapisem
+ *         dziennika, @p false w przeciwnym przypadku. 
  */
-static bool make_move(gamma_t *g, char **words, unsigned long long line_number) {
-    if (words[0][0] == 'm' || words[0][0] == 'g') {
-        bool check = four_param_functions(g, words);
+static bool make_move(struct output *out, struct output *err, gamma_t *g,
+                      const struct command *cmd,
+                      unsigned long long line_number,
+                      struct journal *journal) {
+    if (returns_value(cmd)) {
+        uint64_t result;
 
-        if (check == false && errno == ENOMEM)
+        if (!engine_call(g, cmd, &result) ||
+            !log_move(journal, g, cmd, result, line_number))
             return false;
 
-        if (check == true) {
-            printf("1\n");
+        output_u64(out, result);
+        output_char(out, '\n');
+    }
+    else if (cmd->name == 'a') {
+        if (!print_player_areas(out, g, cmd->params[0]))
+            batch_print_error(err, line_number);
+    }
+    else if (cmd->name == 's') {
+        if (!print_stats(out, g))
+            batch_print_error(err, line_number);
+    }
+    else if (cmd->name == 'i') {
+        if (!print_influence(out, g))
+            batch_print_error(err, line_number);
+    }
+    else if (cmd->name == 'r') {
+        print_runs(out, g);
+    }
+    else if (cmd->name == 'o') {
+        print_occupied(out, g);
+    }
+    else if (cmd->name == 'd') {
+        if (!print_changes(out, g))
+            batch_print_error(err, line_number);
+    }
+    else if (out->fd < 0) {
+        uint64_t start = latency_begin();
+        char *board = gamma_board(g);
+
+        if (board == NULL) {
+            batch_print_error(err, line_number);
         }
         else {
-            printf("0\n");
+            output_bytes(out, board, strlen(board));
+            free(board);
         }
+        latency_end(cmd->name, start);
+        if (gamma_track_changes(g, true))
+            gamma_clear_changes(g);
     }
-    else if (words[0][0] == 'b' || words[0][0] == 'f') {
-        uint64_t num = two_param_functions(g, words);
+    else {
+        // plansza jest zapisywana wiersz po wierszu prosto do deskryptora,
+        // więc wcześniejsze wyniki muszą najpierw opuścić bufor
+        output_flush(out);
+        uint64_t start = latency_begin();
+        if (!gamma_board_write(g, out->fd))
+            batch_print_error(err, line_number);
+        latency_end(cmd->name, start);
+        // polecenie d drukuje zmiany od ostatnio wydrukowanej planszy
+        if (gamma_track_changes(g, true))
+            gamma_clear_changes(g);
+    }
+    return true;
+}
+
+/**
+ * @brief Sprawdza, czy polecenie kończy sesję trybu wsadowego.
+ * @param[in] status - wynik wczytania linii.
+ * @param[in] cmd - polecenie z linii.
+ * @return @p true, gdy linia składa się z samego słowa @p E, @p false
+ *         w przeciwnym przypadku.
+ */
+static bool session_end(enum line_status status, const struct command *cmd) {
+    return status == LINE_COMMAND && cmd->name == SESSION_END &&
+           cmd->words == 1;
+}
 
-        printf("%" PRIu64 "\n", num);
+/**
+ * @brief Sprawdza i wykonuje polecenie z jednej linii trybu wsadowego,
+ *        zapisując udane ruchy w dzienniku.
+ * @param[in, out] out - strumień wyników.
+ * @param[in, out] err - strumień komunikatów o błędach.
+ * @param[in, out] g - wskaźnik na strukturę, przechowującą obecny stan gry.
+ * @param[in] line - linia wejścia.
+ * @param[in, out] journal - dziennik udanych ruchów lub NULL.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią ani z zapisem
+ *         dziennika, @p false w przeciwnym przypadku.
+ */
+static bool execute_line(struct output *out, struct output *err, gamma_t *g,
+                         const struct batch_line *line,
+                         struct journal *journal) {
+    if (line->status == LINE_ERROR || !batch_check_line(&line->cmd)) {
+        batch_print_error(err, line->line_number);
+        return true;
     }
-    else if (words[0][0] == 'q') {
-        bool check;
-        char *pointer_to_end;
-        unsigned long param1 = strtoul(words[1], &pointer_to_end, 10);
 
-        check = gamma_golden_possible(g, (uint32_t)param1);
-        if (!check && errno == ENOMEM) {
+    // make_move(...) zwraca false tylko przy braku pamięci lub błędzie zapisu
+    // dziennika, bo engine_call(...) pomija pozostałe błędy
+    errno = 0;
+    return make_move(out, err, g, &line->cmd, line->line_number, journal);
+}
+
+bool batch_execute_line(struct output *out, struct output *err, gamma_t *g,
+                        const struct batch_line *line) {
+    return execute_line(out, err, g, line, NULL);
+}
+
+/**
+ * @brief Wykonuje kolejne polecenia trybu wsadowego, drukując ich wyniki do
+ *        strumieni @p out i @p err, aż do końca sesji lub wejścia.
+ * @param[in, out] out - strumień wyników.
+ * @param[in, out] err - strumień komunikatów o błędach.
+ * @param[in, out] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @param[in, out] r - stan wczytywania wejścia.
+ * @param[in, out] line_number - numer ostatnio wczytanej linii.
+ * @param[in, out] journal - dziennik udanych ruchów lub NULL.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią ani z zapisem
+ *         dziennika, @p false w przeciwnym przypadku.
+ */
+static bool run_commands(struct output *out, struct output *err, gamma_t *g,
+                         struct line_reader *r,
+                         unsigned long long *line_number,
+                         struct journal *journal) {
+    struct batch_line line;
+
+    while ((line.status = next_command(r, &line.cmd, line_number)) !=
+           LINE_END) {
+        if (line.status == LINE_NO_MEMORY)
+            return false;
+        if (session_end(line.status, &line.cmd))
+            break;
+
+        line.line_number = *line_number;
+        if (!execute_line(out, err, g, &line, journal))
             return false;
+
+        if (out->interactive)
+            output_flush(out);
+        if (err->interactive)
+            output_flush(err);
+    }
+    return true;
+}
+
+/**
+ * @brief Wczytuje kolejne linie sesji i przekazuje je etapowi wykonywania
+ *        poleceń (funkcja wątku wczytującego).
+ * Po linii kończącej sesję lub wejście przekazuje linię @p LINE_END
+ * i kończy działanie, nie wczytując dalszych linii.
+ * @param[in, out] arg - wskaźnik na stan przetwarzania potokowego.
+ * @return NULL.
+ */
+static void *read_stage(void *arg) {
+    struct pipeline *p = arg;
+    struct batch_line line;
+
+    do {
+        line.status = next_command(p->r, &line.cmd, &p->line_number);
+        if (session_end(line.status, &line.cmd))
+            line.status = LINE_END;
+        line.line_number = p->line_number;
+    } while (ring_push(&p->lines, &line) && line.status != LINE_END &&
+             line.status != LINE_NO_MEMORY);
+
+    return NULL;
+}
+
+/**
+ * @brief Przekazuje etapowi drukowania tekst zgromadzony w strumieniu
+ *        @p text, oddając mu bufor strumienia.
+ * @param[in, out] p - stan przetwarzania potokowego.
+ * @param[in, out] text - strumień gromadzący wyniki w pamięci.
+ * @param[in] kind - @p RESULT_TEXT lub @p RESULT_ERROR_TEXT.
+ */
+static void push_text(struct pipeline *p, struct output *text,
+                      enum result_kind kind) {
+    if (text->used == 0)
+        return;
+
+    struct batch_result result = {kind, 0, text->buffer, text->used};
+    ring_push(&p->results, &result);
+    output_init_memory(text);
+}
+
+/**
+ * @brief Wykonuje polecenia z kolejnych wczytanych linii i przekazuje ich
+ *        wyniki etapowi drukowania (etap wykonywany przez wątek wywołujący).
+ * Wyniki poleceń zwracających jedną liczbę oraz komunikaty o błędach są
+ * przekazywane jako liczby, a wyniki pozostałych poleceń jako tekst.
+ * @param[in, out] p - stan przetwarzania potokowego.
+ * @param[in, out] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią ani z zapisem
+ *         dziennika, @p false w przeciwnym przypadku.
+ */
+static bool execute_stage(struct pipeline *p, gamma_t *g) {
+    struct output text, separate_text;
+    struct output *text_err = p->shared ? &text : &separate_text;
+    struct batch_line line;
+    struct batch_result result = {RESULT_END, 0, NULL, 0};
+    bool success = true;
+
+    output_init_memory(&text);
+    output_init_memory(&separate_text);
+
+    for (ring_pop(&p->lines, &line); line.status != LINE_END;
+         ring_pop(&p->lines, &line)) {
+        if (line.status == LINE_NO_MEMORY) {
+            success = false;
+            break;
         }
-        
-        if (check) {
-            printf("1\n");
+
+        if (line.status == LINE_ERROR || !batch_check_line(&line.cmd)) {
+            result.kind = RESULT_ERROR;
+            result.value = line.line_number;
+            ring_push(&p->results, &result);
+            continue;
         }
-        else {
-            printf("0\n");
+
+        errno = 0;
+        if (returns_value(&line.cmd)) {
+            result.kind = RESULT_VALUE;
+            if (!engine_call(g, &line.cmd, &result.value) ||
+                !log_move(p->journal, g, &line.cmd, result.value,
+                          line.line_number)) {
+                success = false;
+                break;
+            }
+            ring_push(&p->results, &result);
+            continue;
+        }
+
+        make_move(&text, text_err, g, &line.cmd, line.line_number, NULL);
+        if (text.failed || separate_text.failed) {
+            success = false;
+            break;
         }
+        push_text(p, &text, RESULT_TEXT);
+        push_text(p, &separate_text, RESULT_ERROR_TEXT);
     }
-    else {
-        char *string_out;
 
-        string_out = gamma_board(g);
+    // wątek wczytujący mógł jeszcze nie dojść do końca sesji
+    ring_close(&p->lines);
+    result.kind = RESULT_END;
+    ring_push(&p->results, &result);
+
+    output_free(&text);
+    output_free(&separate_text);
+    return success;
+}
+
+/**
+ * @brief Drukuje wyniki przekazane przez etap wykonywania poleceń (funkcja
+ *        wątku drukującego).
+ * Zanim zacznie czekać na kolejne wyniki, opróżnia bufory strumieni, więc
+ * wyniki trafiają na wyjście, zanim program zacznie czekać na wejście.
+ * @param[in, out] arg - wskaźnik na stan przetwarzania potokowego.
+ * @return NULL.
+ */
+static void *emit_stage(void *arg) {
+    struct pipeline *p = arg;
+    struct batch_result result;
 
-        if (string_out == NULL) {
-            fprintf(stderr, "ERROR %lld\n", line_number);
+    for (;;) {
+        if (!ring_try_pop(&p->results, &result)) {
+            output_flush(p->out);
+            output_flush(p->err);
+            ring_pop(&p->results, &result);
+        }
+
+        if (result.kind == RESULT_END)
+            break;
+        if (result.kind == RESULT_VALUE) {
+            output_u64(p->out, result.value);
+            output_char(p->out, '\n');
+        }
+        else if (result.kind == RESULT_ERROR) {
+            batch_print_error(p->err, result.value);
         }
         else {
-            printf("%s", string_out);
+            output_bytes(result.kind == RESULT_TEXT ? p->out : p->err,
+                         result.text, result.length);
+            free(result.text);
         }
 
-        free(string_out);
+        if (p->out->interactive)
+            output_flush(p->out);
+        if (p->err->interactive)
+            output_flush(p->err);
     }
-    return true;
+    return NULL;
 }
 
-bool batch_mode(gamma_t *g, unsigned long long line) {
-    unsigned long long line_number = line;
-    char **words = malloc((G_M_NUMBER_OF_PARAMETERS + 1) * sizeof(char *));
-    if (words == NULL) 
+/**
+ * @brief Wykonuje sesję trybu wsadowego potokowo: wczytywanie linii,
+ *        wykonywanie poleceń i drukowanie wyników przebiegają na osobnych
+ *        wątkach, połączonych kolejkami.
+ * Wyniki są takie same jak w funkcji run_commands(...). Gdy nie udało się
+ * przygotować kolejek lub uruchomić wątków, sesja jest wykonywana przez
+ * funkcję run_commands(...).
+ * @param[in, out] out - strumień wyników.
+ * @param[in, out] err - strumień komunikatów o błędach.
+ * @param[in, out] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @param[in, out] r - stan wczytywania wejścia.
+ * @param[in, out] line_number - numer ostatnio wczytanej linii.
+ * @param[in, out] journal - dziennik udanych ruchów lub NULL.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią ani z zapisem
+ *         dziennika, @p false w przeciwnym przypadku.
+ */
+static bool run_pipeline(struct output *out, struct output *err, gamma_t *g,
+                         struct line_reader *r,
+                         unsigned long long *line_number,
+                         struct journal *journal) {
+    struct pipeline p = {.r = r, .line_number = *line_number, .out = out,
+                         .err = err, .shared = out == err,
+                         .journal = journal};
+    pthread_t reader, emitter;
+
+    if (!ring_init(&p.lines, sizeof(struct batch_line), PIPELINE_LINES))
+        return run_commands(out, err, g, r, line_number, journal);
+    if (!ring_init(&p.results, sizeof(struct batch_result),
+                   PIPELINE_RESULTS)) {
+        ring_free(&p.lines);
+        return run_commands(out, err, g, r, line_number, journal);
+    }
+
+    bool started = pthread_create(&emitter, NULL, emit_stage, &p) == 0;
+    if (started && pthread_create(&reader, NULL, read_stage, &p) != 0) {
+        struct batch_result end = {RESULT_END, 0, NULL, 0};
+        ring_push(&p.results, &end);
+        pthread_join(emitter, NULL);
+        started = false;
+    }
+    if (!started) {
+        ring_free(&p.results);
+        ring_free(&p.lines);
+        return run_commands(out, err, g, r, line_number, journal);
+    }
+
+    bool success = execute_stage(&p, g);
+
+    pthread_join(reader, NULL);
+    pthread_join(emitter, NULL);
+    *line_number = p.line_number;
+    ring_free(&p.results);
+    ring_free(&p.lines);
+
+    return success;
+}
+
+bool batch_mode(gamma_t *g, struct line_reader *r,
+                unsigned long long *line_number, struct journal *journal) {
+    struct output out, separate_err;
+    // gdy oba strumienie trafiają do tego samego pliku, wspólny bufor
+    // zachowuje kolejność wyników i komunikatów o błędach
+    bool shared = output_same_file(STDOUT_FILENO, STDERR_FILENO);
+    struct output *err = shared ? &out : &separate_err;
+
+    // linia rozpoczynająca grę mogła zostać wydrukowana przez stdio
+    fflush(stdout);
+    if (!output_init(&out, STDOUT_FILENO)) {
+        output_free(&out);
         return false;
-    size_t buffer_size = 0;
-    char *buff = NULL;
-    int getline_ret_code = 0;
-    int number_of_words_in_line;
+    }
+    if (!shared && !output_init(&separate_err, STDERR_FILENO)) {
+        output_free(&separate_err);
+        output_free(&out);
+        return false;
+    }
 
-    while (!feof(stdin)) {
-        errno = 0;
-        line_number++;
-        getline_ret_code = getline(&buff, &buffer_size, stdin);
-        if (errno == ENOMEM) {
-            free(buff);
-            free(words);
+    // na jednym procesorze wątki potoku tylko by się przeplatały
+    bool success = tpool_default_workers() > 1
+                   ? run_pipeline(&out, err, g, r, line_number, journal)
+                   : run_commands(&out, err, g, r, line_number, journal);
+    latency_add_game(g);
+
+    if (!shared)
+        output_free(&separate_err);
+    output_free(&out);
+    return success;
+}
+
+bool batch_read_session(struct line_reader *r, unsigned long long *line_number,
+                        struct batch_session *session) {
+    struct batch_line line;
+
+    session->lines = NULL;
+    session->count = 0;
+    session->capacity = 0;
+
+    while ((line.status = next_command(r, &line.cmd, line_number)) !=
+           LINE_END) {
+        if (line.status == LINE_NO_MEMORY)
             return false;
-        }
-        if (feof(stdin)) {
-            if (getline_ret_code != GETLINE_EOF && buff[0] != '#') {
-                fprintf(stderr, "ERROR %lld\n", line_number);
-            }
+        if (session_end(line.status, &line.cmd))
             break;
-        }
-        if (buff[0] == '#' || strcmp(buff, "\n") == 0)
-            continue;
-        if (!check_first_char(buff)) {
-            fprintf(stderr, "ERROR %lld\n", line_number);
-            continue;
-        }
 
-        number_of_words_in_line = separate_words(buff, words);
-        
-        if (!batch_check_line(words, number_of_words_in_line)) {
-            fprintf(stderr, "ERROR %lld\n", line_number);
+        if (session->count == session->capacity) {
+            size_t capacity = session->capacity > 0 ? 2 * session->capacity
+                                                    : SESSION_LINES;
+            struct batch_line *lines =
+                realloc(session->lines, capacity * sizeof(struct batch_line));
+            if (lines == NULL) {
+                errno = ENOMEM;
+                return false;
+            }
+            session->lines = lines;
+            session->capacity = capacity;
         }
-        else {
+
+        line.line_number = *line_number;
+        session->lines[session->count++] = line;
+    }
+    return true;
+}
+
+bool batch_run_session(struct output *out, struct output *err, gamma_t *g,
+                       const struct batch_session *session) {
+    bool success = true;
+
+    for (size_t i = 0; i < session->count && success; i++)
+        success = batch_execute_line(out, err, g, &session->lines[i]);
+
+    latency_add_game(g);
+    return success && !out->failed && !err->failed;
+}
+
+/**
+ * @brief Odczytuje czterobajtową liczbę zapisaną w porządku little-endian.
+ * @param[in] bytes - początek zapisu liczby.
+ * @return Odczytana liczba.
+ */
+static uint32_t read_le32(const unsigned char *bytes) {
+    return (uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 |
+           (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+}
+
+/**
+ * @brief Zapisuje ośmiobajtową liczbę w porządku little-endian.
+ * @param[out] bytes - miejsce na zapis liczby.
+ * @param[in] value - liczba.
+ */
+static void write_le64(unsigned char *bytes, uint64_t value) {
+    for (int i = 0; i < 8; i++)
+        bytes[i] = (unsigned char)(value >> (8 * i));
+}
+
+/**
+ * @brief Zamienia rekord trybu binarnego na polecenie.
+ * Kodem polecenia jest kod znaku jednego z poleceń @p m, @p g, @p b, @p f
+ * lub @p q trybu tekstowego. Polecenia dwuparametrowe ignorują współrzędne.
+ * @param[in] record - rekord polecenia.
+ * @param[out] cmd - polecenie.
+ * @return @p true, gdy kod polecenia jest poprawny, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool decode_record(const unsigned char *record, struct command *cmd) {
+    uint32_t opcode = read_le32(record);
+
+    switch (opcode) {
+        case 'm':
+        case 'g':
+            cmd->words = G_M_NUMBER_OF_PARAMETERS;
+            break;
+        case 'b':
+        case 'f':
+        case 'q':
+            cmd->words = B_F_Q_NUMBER_OF_PARAMETERS;
+            break;
+        default:
+            return false;
+    }
+
+    cmd->name = (char)opcode;
+    cmd->numbers_valid = true;
+    for (int i = 0; i < 3; i++)
+        cmd->params[i] = read_le32(record + 4 * (i + 1));
+
+    return true;
+}
+
+/**
+ * @brief Wykonuje kolejne polecenia binarnego trybu wsadowego, drukując ich
+ *        wyniki do strumienia @p out.
+ * @param[in, out] out - strumień wyników.
+ * @param[in, out] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @param[in, out] r - stan wczytywania wejścia.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią, @p false
+ *         w przeciwnym przypadku.
+ */
+static bool run_records(struct output *out, gamma_t *g,
+                        struct line_reader *r) {
+    const unsigned char *record;
+    unsigned char result[BINARY_RESULT_SIZE];
+    struct command cmd;
+
+    while (true) {
+        // druga strona może czekać na wyniki przed wysłaniem kolejnych
+        // poleceń, więc bufor jest opróżniany przed czekaniem na wejście
+        if (reader_buffered(r) < BINARY_COMMAND_SIZE)
+            output_flush(out);
+        if (!next_record(r, BINARY_COMMAND_SIZE, &record))
+            return errno != ENOMEM;
+
+        uint64_t value = BINARY_ERROR;
+        if (decode_record(record, &cmd)) {
             errno = 0;
-            if (!make_move(g, words, line_number) &&
-                errno == ENOMEM) {
-                    free(buff);
-                    free(words);
-                    return false;
-                }
+            if (!engine_call(g, &cmd, &value))
+                return false;
         }
+
+        write_le64(result, value);
+        output_bytes(out, (const char *)result, BINARY_RESULT_SIZE);
     }
-    free(buff);
-    free(words);
-    return true;
-}
\ No newline at end of file
+}
+
+bool binary_mode(gamma_t *g, struct line_reader *r) {
+    struct output out;
+
+    // linia potwierdzająca rozpoczęcie gry mogła zostać wydrukowana przez stdio
+    fflush(stdout);
+    if (!output_init(&out, STDOUT_FILENO)) {
+        output_free(&out);
+        return false;
+    }
+
+    bool success = run_records(&out, g, r);
+    latency_add_game(g);
+
+    output_free(&out);
+    return success;
+}
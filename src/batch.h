@@ -13,16 +13,118 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "gamma.h"
+#include "lexer.h"
+#include "output.h"
+#include "journal.h"
+
+/**
+ * Struktura przechowująca linię trybu wsadowego wczytaną z wyprzedzeniem.
+ */
+struct batch_line {
+    enum line_status status;///< wynik wczytania linii.
+    struct command cmd;///< polecenie z linii.
+    unsigned long long line_number;///< numer linii.
+};
+
+/**
+ * Struktura przechowująca linie jednej sesji trybu wsadowego.
+ */
+struct batch_session {
+    struct batch_line *lines;///< kolejne linie sesji.
+    size_t count;///< liczba linii.
+    size_t capacity;///< rozmiar tablicy @p lines.
+};
+
+/**
+ * @brief Drukuje komunikat o błędzie w linii @p line_number.
+ * @param[in, out] err - strumień komunikatów o błędach.
+ * @param[in] line_number - numer linii.
+ */
+extern void batch_print_error(struct output *err,
+                              unsigned long long line_number);
+
+/**
+ * @brief Sprawdza i wykonuje polecenie z jednej linii trybu wsadowego.
+ * @param[in, out] out - strumień wyników.
+ * @param[in, out] err - strumień komunikatów o błędach.
+ * @param[in, out] g - wskaźnik na strukturę, przechowującą obecny stan gry.
+ * @param[in] line - linia wejścia.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią, @p false
+ *         w przeciwnym przypadku.
+ */
+extern bool batch_execute_line(struct output *out, struct output *err,
+                               gamma_t *g, const struct batch_line *line);
 
 /**
  * @brief Pobiera polecenia po wejściu w tryb wsadowy, sprawdza ich poprawność
  *        i je interpretuje.
+ * Sesja kończy się wraz z wejściem lub linią składającą się z samego słowa
+ * @p E, po której wejście może zawierać kolejne sesje. Gdy dostępny jest
+ * więcej niż jeden procesor (tpool_default_workers(...)), wczytywanie
+ * linii, wykonywanie poleceń i drukowanie wyników przebiegają na trzech
+ * wątkach połączonych kolejkami (ring.h), a wyniki są takie same jak przy
+ * wykonaniu na jednym wątku.
+ * @param[in, out] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @param[in, out] r - stan wczytywania wejścia, ustawiony za linią
+ *                     rozpoczynającą grę.
+ * @param[in, out] line_number - numer linii, na której zostało wywołane
+ *                               poprawne polecenie wejścia do trybu
+ *                               wsadowego, a po zakończeniu numer ostatnio
+ *                               wczytanej linii.
+ * @param[in, out] journal - dziennik, w którym zapisywane są udane ruchy,
+ *                           lub NULL.
+ * @return @p true, gdy w czasie wykonywania ruchów nie wystąpiły problemy z
+ *         brakiem pamięci ani z zapisem dziennika, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool batch_mode(gamma_t *g, struct line_reader *r,
+                       unsigned long long *line_number,
+                       struct journal *journal);
+
+/**
+ * @brief Wczytuje z wyprzedzeniem linie sesji trybu wsadowego, aż do linii
+ *        kończącej sesję lub końca wejścia.
+ * @param[in, out] r - stan wczytywania wejścia, ustawiony za linią
+ *                     rozpoczynającą grę.
+ * @param[in, out] line_number - numer ostatnio wczytanej linii.
+ * @param[out] session - wczytane linie. Tablicę linii należy zwolnić, także
+ *                       gdy funkcja zwróci @p false.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool batch_read_session(struct line_reader *r,
+                               unsigned long long *line_number,
+                               struct batch_session *session);
+
+/**
+ * @brief Wykonuje linie sesji wczytanej funkcją batch_read_session(...).
+ * Wyniki są takie same jak w funkcji batch_mode(...). Wywołania dla różnych
+ * gier mogą przebiegać jednocześnie na różnych wątkach.
+ * @param[in, out] out - strumień wyników.
+ * @param[in, out] err - strumień komunikatów o błędach, może być tym samym
+ *                       strumieniem co @p out.
+ * @param[in, out] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @param[in] session - linie sesji.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią, @p false
+ *         w przeciwnym przypadku.
+ */
+extern bool batch_run_session(struct output *out, struct output *err,
+                              gamma_t *g, const struct batch_session *session);
+
+/**
+ * @brief Pobiera polecenia binarnego trybu wsadowego i je wykonuje.
+ * Polecenia są rekordami po cztery czterobajtowe liczby little-endian: kod
+ * znaku polecenia (@p m, @p g, @p b, @p f lub @p q), numer gracza oraz dwie
+ * współrzędne. Wynikiem każdego polecenia jest ośmiobajtowa liczba
+ * little-endian: wartość zwrócona przez funkcję z silnika (1 lub 0 dla
+ * wartości logicznych) albo UINT64_MAX dla niepoprawnego kodu polecenia.
+ * Niepełny ostatni rekord jest pomijany.
  * @param[in, out] g - wskaźnik na strukturę, przechowującą stan gry.
- * @param[in] line - numer linii, na której zostało wywołane poprawne polecenie
- *               wejścia do trybu wsadowego.
+ * @param[in, out] r - stan wczytywania wejścia, ustawiony za linią
+ *                     rozpoczynającą grę.
  * @return @p true, gdy w czasie wykonywania ruchów nie wystąpiły problemy z
  *         brakiem pamięci, @p false w przeciwnym przypadku.
  */
-extern bool batch_mode(gamma_t *g, unsigned long long line);
+extern bool binary_mode(gamma_t *g, struct line_reader *r);
 
 #endif /*BATCH_H*/
\ No newline at end of file
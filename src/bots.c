@@ -0,0 +1,235 @@
+/** @file
+ * Implementacja prostych strategii gry (botów), używanych w turniejach
+ * rozgrywanych przez program gamma_tournament.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "moves.h"
+#include "bots.h"
+
+/**
+ * Liczba losowanych pól, zanim bot zacznie przeglądać planszę po kolei.
+ */
+static const int SAMPLE_TRIES = 16;
+
+/**
+ * Liczba losowanych pól, na których bot próbuje wykonać złoty ruch.
+ */
+static const int GOLDEN_TRIES = 8;
+
+/**
+ * Odwrotność prawdopodobieństwa, z jakim agresywny bot próbuje wykonać złoty
+ * ruch, mając jeszcze zwykłe ruchy.
+ */
+static const uint64_t GOLDEN_EAGERNESS = 8;
+
+uint64_t bot_random(uint64_t *seed) {
+    uint64_t x = *seed;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *seed = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief Sprawdza, czy gracz @p player może postawić pionek na polu
+ *        (@p x, @p y), nie przekraczając limitu obszarów.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @return @p true, gdy ruch jest legalny, @p false w przeciwnym przypadku.
+ */
+static bool can_place(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+    if (g->board[y][x] != 0)
+        return false;
+
+    return g->busy_areas[player - 1] < g->areas_limit ||
+           check_neighbors(g, player, x, y);
+}
+
+/**
+ * @brief Ocenia pole (@p x, @p y) z punktu widzenia gracza @p player.
+ * Premiuje pola przylegające do pól gracza oraz pola z wolnymi sąsiadami.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @return Ocena pola, im większa tym lepiej.
+ */
+static uint32_t field_score(gamma_t *g, uint32_t player, uint32_t x,
+                            uint32_t y) {
+    uint32_t neighbors[ADJACENT_FIELDS];
+    int n = 0;
+    uint32_t score = 0;
+
+    if (x > 0)
+        neighbors[n++] = g->board[y][x - 1];
+    if (x < g->b_width - 1)
+        neighbors[n++] = g->board[y][x + 1];
+    if (y > 0)
+        neighbors[n++] = g->board[y - 1][x];
+    if (y < g->b_height - 1)
+        neighbors[n++] = g->board[y + 1][x];
+
+    for (int i = 0; i < n; i++) {
+        if (neighbors[i] == player)
+            score += 4;
+        else if (neighbors[i] == 0)
+            score += 1;
+    }
+
+    return score;
+}
+
+/**
+ * @brief Wykonuje zwykły ruch na pierwszym legalnym polu, przeglądając
+ *        planszę od losowego miejsca.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in, out] seed - stan generatora liczb losowych.
+ * @return @p true, gdy udało się wykonać ruch, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool scan_move(gamma_t *g, uint32_t player, uint64_t *seed) {
+    uint64_t fields = (uint64_t)g->b_width * g->b_height;
+    uint64_t start = bot_random(seed) % fields;
+
+    for (uint64_t k = 0; k < fields; k++) {
+        uint64_t f = (start + k) % fields;
+        uint32_t x = (uint32_t)(f % g->b_width);
+        uint32_t y = (uint32_t)(f / g->b_width);
+
+        if (can_place(g, player, x, y) && gamma_move(g, player, x, y))
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Próbuje wykonać złoty ruch na kilku losowych polach zajętych przez
+ *        innych graczy.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in, out] seed - stan generatora liczb losowych.
+ * @return @p true, gdy udało się wykonać złoty ruch, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool random_golden_move(gamma_t *g, uint32_t player, uint64_t *seed) {
+    if (!g->golden_move_available[player - 1])
+        return false;
+
+    for (int i = 0; i < GOLDEN_TRIES; i++) {
+        uint32_t x = (uint32_t)(bot_random(seed) % g->b_width);
+        uint32_t y = (uint32_t)(bot_random(seed) % g->b_height);
+
+        if (g->board[y][x] != 0 && g->board[y][x] != player &&
+            gamma_golden_move(g, player, x, y))
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Strategia losowa: stawia pionek na losowym legalnym polu, a gdy
+ *        takiego nie ma, próbuje złotego ruchu.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in, out] seed - stan generatora liczb losowych.
+ * @return @p true, gdy gracz wykonał ruch, @p false w przeciwnym przypadku.
+ */
+static bool play_random(gamma_t *g, uint32_t player, uint64_t *seed) {
+    for (int i = 0; i < SAMPLE_TRIES; i++) {
+        uint32_t x = (uint32_t)(bot_random(seed) % g->b_width);
+        uint32_t y = (uint32_t)(bot_random(seed) % g->b_height);
+
+        if (can_place(g, player, x, y) && gamma_move(g, player, x, y))
+            return true;
+    }
+
+    if (scan_move(g, player, seed))
+        return true;
+
+    return random_golden_move(g, player, seed);
+}
+
+/**
+ * @brief Strategia zachłanna: spośród kilku losowych legalnych pól wybiera
+ *        najlepiej ocenione przez funkcję field_score(...).
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in, out] seed - stan generatora liczb losowych.
+ * @return @p true, gdy gracz wykonał ruch, @p false w przeciwnym przypadku.
+ */
+static bool play_greedy(gamma_t *g, uint32_t player, uint64_t *seed) {
+    bool found = false;
+    uint32_t best_x = 0, best_y = 0, best_score = 0;
+
+    for (int i = 0; i < SAMPLE_TRIES; i++) {
+        uint32_t x = (uint32_t)(bot_random(seed) % g->b_width);
+        uint32_t y = (uint32_t)(bot_random(seed) % g->b_height);
+
+        if (can_place(g, player, x, y)) {
+            uint32_t score = field_score(g, player, x, y);
+            if (!found || score > best_score) {
+                found = true;
+                best_x = x;
+                best_y = y;
+                best_score = score;
+            }
+        }
+    }
+
+    if (found && gamma_move(g, player, best_x, best_y))
+        return true;
+
+    if (scan_move(g, player, seed))
+        return true;
+
+    return random_golden_move(g, player, seed);
+}
+
+/**
+ * @brief Strategia agresywna: gra jak strategia zachłanna, ale co pewien
+ *        czas próbuje wcześniej wykorzystać złoty ruch.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in, out] seed - stan generatora liczb losowych.
+ * @return @p true, gdy gracz wykonał ruch, @p false w przeciwnym przypadku.
+ */
+static bool play_golden(gamma_t *g, uint32_t player, uint64_t *seed) {
+    if (bot_random(seed) % GOLDEN_EAGERNESS == 0 &&
+        random_golden_move(g, player, seed))
+        return true;
+
+    return play_greedy(g, player, seed);
+}
+
+/**
+ * Tablica dostępnych strategii.
+ */
+static const bot_t BOTS[] = {
+    {"random", play_random},
+    {"greedy", play_greedy},
+    {"golden", play_golden},
+};
+
+const bot_t *find_bot(const char *name) {
+    for (size_t i = 0; i < sizeof(BOTS) / sizeof(BOTS[0]); i++) {
+        if (strcmp(BOTS[i].name, name) == 0)
+            return &BOTS[i];
+    }
+
+    return NULL;
+}
+
+const char *bot_names(void) {
+    return "random,greedy,golden";
+}
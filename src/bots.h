@@ -0,0 +1,52 @@
+/** @file
+ * Interfejs modułu zawierającego proste strategie gry (boty), używane
+ * w turniejach rozgrywanych przez program gamma_tournament.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#ifndef BOTS_H
+#define BOTS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "gamma.h"
+
+/**
+ * Struktura opisująca strategię gry.
+ */
+struct bot {
+    const char *name;///< nazwa strategii, podawana w parametrach turnieju.
+    bool (*play)(gamma_t *g, uint32_t player, uint64_t *seed);
+    /**<
+     * Funkcja wykonująca jeden ruch gracza @p player. Korzysta z generatora
+     * liczb losowych o stanie @p seed. Zwraca @p true, gdy gracz wykonał
+     * ruch (zwykły lub złoty), a @p false, gdy nie znalazł ruchu.
+     */
+};
+///Struktura opisująca strategię gry.
+typedef struct bot bot_t;
+
+/**
+ * @brief Losuje kolejną liczbę pseudolosową (xorshift64*).
+ * @param[in, out] seed - stan generatora, liczba niezerowa.
+ * @return Wylosowana liczba.
+ */
+extern uint64_t bot_random(uint64_t *seed);
+
+/**
+ * @brief Szuka strategii o nazwie @p name.
+ * @param[in] name - nazwa strategii.
+ * @return Wskaźnik na opis strategii lub NULL, gdy nie ma strategii o takiej
+ *         nazwie.
+ */
+extern const bot_t *find_bot(const char *name);
+
+/**
+ * @brief Podaje nazwy wszystkich dostępnych strategii.
+ * @return Napis z nazwami strategii oddzielonymi przecinkami.
+ */
+extern const char *bot_names(void);
+
+#endif /* BOTS_H */
@@ -6,10 +6,30 @@
  * @date 16.04.2020
  */
 
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #include "chboard.h"
+#include "tpool.h"
+
+/**
+ * Zapisy dziesiętne liczb od 0 do 99, po dwa znaki na liczbę.
+ */
+static const char DIGIT_PAIRS[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
 
 uint32_t int_len(uint32_t number) {
     uint32_t counter = 0;
@@ -24,6 +44,24 @@ uint32_t int_len(uint32_t number) {
     return counter;
 }
 
+char *write_digits(char *end, uint64_t number) {
+    while (number >= 100) {
+        uint32_t pair = (uint32_t)(number % 100) * 2;
+        number /= 100;
+        *--end = DIGIT_PAIRS[pair + 1];
+        *--end = DIGIT_PAIRS[pair];
+    }
+    if (number >= 10) {
+        *--end = DIGIT_PAIRS[number * 2 + 1];
+        *--end = DIGIT_PAIRS[number * 2];
+    }
+    else {
+        *--end = (char)('0' + number);
+    }
+
+    return end;
+}
+
 uint32_t max_f(uint32_t a, uint32_t b) {
     if (a > b)
         return a;
@@ -31,85 +69,436 @@ uint32_t max_f(uint32_t a, uint32_t b) {
         return b;
 }
 
-char *board_max_9(gamma_t *g) {
-    uint32_t charac;
-    uint32_t ptr = 0;
-    uint64_t board_size = g->b_width * g->b_height + g->b_height + 1;
+/**
+ * Rozmiar bufora, w którym funkcja board_write(...) tworzy kolejne wiersze
+ * napisu opisującego planszę, o ile mieści się w nim jeden wiersz.
+ */
+static const uint64_t WRITE_BUFFER_SIZE = UINT64_C(1) << 16;
 
-    char *word_ptr = malloc(board_size * sizeof(char));
+/**
+ * Długość napisu opisującego planszę, od której napis jest tworzony na
+ * wielu wątkach.
+ */
+static const uint64_t PARALLEL_TEXT_LENGTH = UINT64_C(1) << 22;
+
+/**
+ * Przybliżona liczba znaków napisu tworzonych w ramach jednego zadania puli
+ * wątków.
+ */
+static const uint64_t TASK_TEXT_LENGTH = UINT64_C(1) << 18;
+
+/**
+ * Największa liczba opisów pól przygotowywanych przed tworzeniem napisu.
+ * Pola graczy o większych numerach są opisywane na bieżąco.
+ */
+static const uint32_t CELL_TABLE_LIMIT = UINT32_C(1) << 16;
+
+struct board_renderer;
+
+/**
+ * Funkcja wpisująca pod adres @p dst opis wiersza @p y planszy zakończony
+ * znakiem nowej linii.
+ */
+typedef void (*row_renderer)(const struct board_renderer *r, uint32_t y,
+                             char *dst);
+
+/**
+ * Struktura przechowująca dane potrzebne do tworzenia kolejnych wierszy
+ * napisu opisującego planszę.
+ */
+struct board_renderer {
+    gamma_t *g;///< wskaźnik na strukturę, przechowującą stan gry.
+    row_renderer render;///< funkcja opisująca wiersz planszy.
+    uint32_t cell_width;///< liczba znaków opisu jednego pola.
+    char *cells;
+    /**<
+     * Opisy pól zajętych przez graczy o numerach od 0 do @p cell_count - 1,
+     * po @p cell_width znaków na pole, lub NULL, gdy graczy jest co
+     * najwyżej 9.
+     */
+    uint32_t cell_count;///< liczba opisów pól w tablicy @p cells.
+    uint64_t row;///< liczba znaków opisu jednego wiersza planszy.
+    uint32_t rows_per_task;///< liczba wierszy opisywanych w jednym zadaniu.
+    char *text;///< napis, do którego trafiają opisy wierszy.
+    uint32_t first;
+    /**<
+     * Numer, licząc od górnego wiersza planszy, wiersza opisywanego na
+     * początku @p text.
+     */
+    uint32_t end;///< numer wiersza za ostatnim opisywanym wierszem.
+};
+
+/**
+ * @brief Wpisuje opis pola zajętego przez gracza @p number, wyrównany do
+ *        prawej, pod adres @p cell. Pole wolne opisuje znakiem '.'.
+ * @param[out] cell - miejsce na @p width znaków.
+ * @param[in] width - liczba znaków opisu pola.
+ * @param[in] number - numer gracza lub 0 dla wolnego pola.
+ */
+static void format_cell(char *cell, uint32_t width, uint32_t number) {
+    char *start = cell + width - 1;
 
-    if (word_ptr == NULL)
+    if (number == 0)
+        *start = '.';
+    else
+        start = write_digits(cell + width, number);
+    memset(cell, ' ', (size_t)(start - cell));
+}
+
+#if defined(__AVX2__)
+/**
+ * @brief Zamienia 32 kolejne pola wiersza na znaki, gdy graczy jest co
+ *        najwyżej 9.
+ * Zawęża numery graczy do bajtów, dodaje do nich '0', a wolne pola zastępuje
+ * znakiem '.'.
+ * @param[in] cells - 32 kolejne pola wiersza.
+ * @param[out] dst - miejsce na 32 znaki.
+ */
+static void cells_to_chars(const uint32_t *cells, char *dst) {
+    const __m256i *src = (const __m256i *)cells;
+    __m256i ab = _mm256_packs_epi32(_mm256_loadu_si256(src),
+                                    _mm256_loadu_si256(src + 1));
+    __m256i cd = _mm256_packs_epi32(_mm256_loadu_si256(src + 2),
+                                    _mm256_loadu_si256(src + 3));
+    // zawężanie działa w obrębie 128-bitowych połówek, więc czwórki bajtów
+    // trzeba jeszcze ułożyć w kolejności pól
+    __m256i bytes = _mm256_permutevar8x32_epi32(
+        _mm256_packus_epi16(ab, cd), _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+    __m256i free_mask = _mm256_cmpeq_epi8(bytes, _mm256_setzero_si256());
+    __m256i digits = _mm256_add_epi8(bytes, _mm256_set1_epi8('0'));
+
+    _mm256_storeu_si256((__m256i *)dst,
+                        _mm256_blendv_epi8(digits, _mm256_set1_epi8('.'),
+                                           free_mask));
+}
+
+/**
+ * Liczba pól zamienianych naraz przez funkcję cells_to_chars(...).
+ */
+#define CELLS_PER_VECTOR 32
+#elif defined(__SSE2__)
+/**
+ * @brief Zamienia 16 kolejnych pól wiersza na znaki, gdy graczy jest co
+ *        najwyżej 9.
+ * Zawęża numery graczy do bajtów, dodaje do nich '0', a wolne pola zastępuje
+ * znakiem '.'.
+ * @param[in] cells - 16 kolejnych pól wiersza.
+ * @param[out] dst - miejsce na 16 znaków.
+ */
+static void cells_to_chars(const uint32_t *cells, char *dst) {
+    const __m128i *src = (const __m128i *)cells;
+    __m128i ab = _mm_packs_epi32(_mm_loadu_si128(src),
+                                 _mm_loadu_si128(src + 1));
+    __m128i cd = _mm_packs_epi32(_mm_loadu_si128(src + 2),
+                                 _mm_loadu_si128(src + 3));
+    __m128i bytes = _mm_packus_epi16(ab, cd);
+    __m128i free_mask = _mm_cmpeq_epi8(bytes, _mm_setzero_si128());
+    __m128i digits = _mm_add_epi8(bytes, _mm_set1_epi8('0'));
+
+    _mm_storeu_si128((__m128i *)dst,
+                     _mm_or_si128(_mm_and_si128(free_mask,
+                                                _mm_set1_epi8('.')),
+                                  _mm_andnot_si128(free_mask, digits)));
+}
+
+/**
+ * Liczba pól zamienianych naraz przez funkcję cells_to_chars(...).
+ */
+#define CELLS_PER_VECTOR 16
+#endif
+
+/**
+ * @brief Wpisuje opis wiersza @p y planszy, gdy graczy jest co najwyżej 9.
+ * Gdy procesor to umożliwia, zamienia na znaki po kilkanaście pól naraz,
+ * a pozostałe pola zamienia pojedynczo.
+ * @param[in] r - dane potrzebne do tworzenia napisu.
+ * @param[in] y - numer wiersza.
+ * @param[out] dst - miejsce na @p r->row znaków.
+ */
+static void row_max_9(const struct board_renderer *r, uint32_t y,
+                      char *dst) {
+    const uint32_t *row = r->g->board[y];
+    uint32_t width = r->g->b_width;
+    uint32_t j = 0;
+
+#ifdef CELLS_PER_VECTOR
+    for (; j + CELLS_PER_VECTOR <= width; j += CELLS_PER_VECTOR) {
+        cells_to_chars(row + j, dst + j);
+    }
+#endif
+    for (; j < width; j++) {
+        dst[j] = row[j] == 0 ? '.' : (char)('0' + row[j]);
+    }
+    dst[width] = '\n';
+}
+
+/**
+ * @brief Wpisuje opis wiersza @p y planszy, gdy graczy jest co najmniej 10.
+ * Kopiuje gotowe opisy pól z tablicy @p r->cells.
+ * @param[in] r - dane potrzebne do tworzenia napisu.
+ * @param[in] y - numer wiersza.
+ * @param[out] dst - miejsce na @p r->row znaków.
+ */
+static void row_more_than_9(const struct board_renderer *r, uint32_t y,
+                            char *dst) {
+    gamma_t *g = r->g;
+    uint32_t width = r->cell_width;
+
+    for (uint32_t j = 0; j < g->b_width; j++) {
+        uint32_t owner = g->board[y][j];
+
+        if (owner < r->cell_count)
+            memcpy(dst, r->cells + (uint64_t)owner * width, width);
+        else
+            format_cell(dst, width, owner);
+        dst += width;
+    }
+    *dst = '\n';
+}
+
+/**
+ * @brief Przygotowuje dane potrzebne do tworzenia napisu opisującego
+ *        planszę.
+ * @param[out] r - dane do uzupełnienia.
+ * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @param[in] render - funkcja opisująca wiersz planszy.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool renderer_init(struct board_renderer *r, gamma_t *g,
+                          row_renderer render) {
+    r->g = g;
+    r->render = render;
+    r->cell_width = board_cell_width(g);
+    r->cells = NULL;
+    r->cell_count = 0;
+    r->row = (uint64_t)g->b_width * r->cell_width + 1;
+    r->rows_per_task = 1;
+    if (r->row < TASK_TEXT_LENGTH)
+        r->rows_per_task = (uint32_t)(TASK_TEXT_LENGTH / r->row);
+    r->text = NULL;
+    r->first = 0;
+    r->end = g->b_height;
+
+    if (render != row_more_than_9)
+        return true;
+
+    r->cell_count = g->b_players < CELL_TABLE_LIMIT ? g->b_players + 1
+                                                    : CELL_TABLE_LIMIT;
+    r->cells = malloc((uint64_t)r->cell_count * r->cell_width);
+    if (r->cells == NULL)
+        return false;
+
+    for (uint32_t i = 0; i < r->cell_count; i++) {
+        format_cell(r->cells + (uint64_t)i * r->cell_width, r->cell_width, i);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Wybiera funkcję opisującą wiersz planszy.
+ * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @return Funkcja opisująca wiersz planszy.
+ */
+static row_renderer choose_renderer(gamma_t *g) {
+    if (g->b_players < 10)
+        return row_max_9;
+    else
+        return row_more_than_9;
+}
+
+/**
+ * @brief Opisuje kolejne wiersze planszy należące do zadania @p task.
+ * Zadanie o numerze @p task obejmuje @p r->rows_per_task wierszy napisu,
+ * licząc od wiersza @p r->first.
+ * @param[in] arg - wskaźnik na dane potrzebne do tworzenia napisu.
+ * @param[in] task - numer zadania.
+ * @param[in] worker - numer wątku, nieużywany.
+ */
+static void render_task(void *arg, uint64_t task, unsigned worker) {
+    const struct board_renderer *r = arg;
+    uint32_t height = r->g->b_height;
+    uint64_t first = r->first + task * r->rows_per_task;
+    uint64_t last = first + r->rows_per_task;
+    (void)worker;
+
+    if (last > r->end)
+        last = r->end;
+    for (uint64_t i = first; i < last; i++) {
+        r->render(r, height - 1 - (uint32_t)i,
+                  r->text + (i - r->first) * r->row);
+    }
+}
+
+/**
+ * @brief Opisuje wiersze planszy od @p r->first do @p r->end - 1, licząc od
+ *        górnego, i wpisuje je kolejno od początku @p r->text.
+ * Gdy @p workers jest większe od 1, wiersze są dzielone na zadania puli
+ * wątków.
+ * @param[in] r - dane potrzebne do tworzenia napisu.
+ * @param[in] workers - liczba wątków.
+ */
+static void render_range(struct board_renderer *r, unsigned workers) {
+    uint64_t tasks = ((uint64_t)r->end - r->first + r->rows_per_task - 1)
+                     / r->rows_per_task;
+    bool done = false;
+
+    if (workers > 1 && tasks > 1)
+        done = tpool_run(workers, tasks, render_task, r);
+    // gdy nie udało się uruchomić puli, wiersze są tworzone na jednym wątku
+    for (uint64_t t = 0; !done && t < tasks; t++) {
+        render_task(r, t, 0);
+    }
+}
+
+/**
+ * @brief Tworzy napis opisujący planszę, wiersz po wierszu, od górnego.
+ * Gdy napis jest długi, jego wiersze są tworzone na wielu wątkach.
+ * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @param[in] render - funkcja opisująca wiersz planszy.
+ * @return Zaalokowany napis lub NULL, gdy nie udało się zaalokować pamięci.
+ */
+static char *render_rows(gamma_t *g, row_renderer render) {
+    struct board_renderer r;
+    uint64_t board_size = board_text_length(g) + 1;
+
+    if (!renderer_init(&r, g, render))
         return NULL;
 
-    
-    for (long long i = g->b_height - 1; i >= 0; i--) {
-        for (uint32_t j = 0; j < g->b_width; j++) {
-            if (g->board[j][i] == 0) {
-                word_ptr[ptr] = '.';
-                ptr++;
-            }
-            else {
-                charac = g->board[j][i];
-                word_ptr[ptr] = (char)((charac % 10) + 48);
-                ptr++;
-            }
-
-            if (j == g->b_width - 1) {
-                word_ptr[ptr] = '\n';
-                ptr++;
-            }
-        }
+    char *word_ptr = malloc(board_size * sizeof(char));
+    if (word_ptr == NULL) {
+        free(r.cells);
+        return NULL;
     }
+    r.text = word_ptr;
+    render_range(&r, board_size > PARALLEL_TEXT_LENGTH
+                         ? tpool_default_workers() : 1);
     word_ptr[board_size - 1] = '\0';
+
+    free(r.cells);
     return word_ptr;
 }
 
+char *board_max_9(gamma_t *g) {
+    return render_rows(g, row_max_9);
+}
+
 char *board_more_than_9(gamma_t *g) {
-    uint32_t max_num_len = int_len(g->b_players);
-    uint32_t ptr = 0;
-    uint32_t previous_num = 0;
+    return render_rows(g, row_more_than_9);
+}
 
-    uint32_t board_size = g->b_width * g->b_height * (max_num_len + 1) + 1
-    + g->b_height;
+/**
+ * @brief Zapisuje do deskryptora @p fd całą zawartość bufora, ponawiając
+ *        zapis po częściowym zapisaniu lub przerwaniu sygnałem.
+ * @param[in] fd - deskryptor pliku.
+ * @param[in] buf - bufor.
+ * @param[in] n - liczba bajtów do zapisania.
+ * @return @p true, gdy zapisano wszystkie bajty, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool write_all(int fd, const char *buf, uint64_t n) {
+    while (n > 0) {
+        size_t chunk = n > SSIZE_MAX ? SSIZE_MAX : (size_t)n;
+        ssize_t written = write(fd, buf, chunk);
 
-    char *word_ptr = malloc(board_size * sizeof(char));
-    if (word_ptr == NULL)
-        return NULL;
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        buf += written;
+        n -= (uint64_t)written;
+    }
 
-    for (int i = g->b_height - 1; i >= 0; i--) {
-        for (uint32_t j = 0; j < g->b_width; j++) {
-            if (g->board[j][i] == 0) {
-                for (uint32_t k = 0; k < max_num_len; k++) {
-                    word_ptr[ptr] = ' ';
-                    ptr++;
-                }
-                word_ptr[ptr] = '.';
-                ptr++;
-            }
-            else if (g->board[j][i] > 0) {
-                previous_num = g->board[j][i];
-                word_ptr[ptr] = ' ';
-                ptr += max_num_len;
-                for (uint32_t k = 0; k < max_num_len; k++) {
-                    if (previous_num > 0) {
-                        word_ptr[ptr] = (char)((previous_num % 10) + 48);
-                        ptr--;
-                        previous_num /= 10;
-                    }
-                    else {
-                        word_ptr[ptr] = ' ';
-                        ptr--;
-                    }
-                }
-                ptr += max_num_len + 1;                
-            }
-
-            if (j == g->b_width - 1) {
-                    word_ptr[ptr] = '\n';
-                    ptr++;
-            }
+    return true;
+}
+
+bool board_write(gamma_t *g, int fd) {
+    if (g->board_text != NULL)
+        return write_all(fd, g->board_text, board_text_length(g));
+
+    struct board_renderer r;
+    if (!renderer_init(&r, g, choose_renderer(g))) {
+        errno = ENOMEM;
+        return false;
+    }
+
+    // długi napis jest tworzony na wielu wątkach, tak jak w funkcji
+    // render_rows(...), po większym kawałku naraz
+    unsigned workers = 1;
+    uint64_t size = WRITE_BUFFER_SIZE;
+    if (board_text_length(g) > PARALLEL_TEXT_LENGTH) {
+        workers = tpool_default_workers();
+        if (workers > 1)
+            size = PARALLEL_TEXT_LENGTH;
+    }
+    if (size < r.row)
+        size = r.row;
+
+    char *buf = malloc(size);
+    if (buf == NULL) {
+        free(r.cells);
+        errno = ENOMEM;
+        return false;
+    }
+    r.text = buf;
+
+    uint64_t rows = size / r.row;
+    bool ok = true;
+    for (uint64_t first = 0; first < g->b_height && ok; first += rows) {
+        r.first = (uint32_t)first;
+        r.end = first + rows < g->b_height ? (uint32_t)(first + rows)
+                                           : g->b_height;
+        render_range(&r, workers);
+        ok = write_all(fd, buf, (uint64_t)(r.end - r.first) * r.row);
+    }
+
+    free(buf);
+    free(r.cells);
+    return ok;
+}
+
+uint32_t board_cell_width(gamma_t *g) {
+    if (g->b_players < 10)
+        return 1;
+
+    return int_len(g->b_players) + 1;
+}
+
+uint64_t board_text_length(gamma_t *g) {
+    return ((uint64_t)g->b_width * board_cell_width(g) + 1) * g->b_height;
+}
+
+void board_write_field(gamma_t *g, char *text, uint32_t x, uint32_t y) {
+    uint64_t cell = board_cell_width(g);
+    uint64_t row = (uint64_t)g->b_width * cell + 1;
+    // wiersze są zapisane od górnego, a numer gracza jest wyrównany do prawej
+    char *field = text + (uint64_t)(g->b_height - 1 - y) * row + x * cell;
+
+    if (cell == 1)
+        field[0] = g->board[y][x] == 0 ? '.' : (char)('0' + g->board[y][x]);
+    else
+        format_cell(field, (uint32_t)cell, g->board[y][x]);
+}
+
+void board_write_empty(gamma_t *g, char *text) {
+    uint64_t cell = board_cell_width(g);
+    uint64_t row = (uint64_t)g->b_width * cell + 1;
+
+    // wszystkie wiersze pustej planszy są takie same, więc pierwszy jest
+    // wypełniany znak po znaku, a pozostałe są jego kopiami
+    if (cell == 1) {
+        memset(text, '.', g->b_width);
+    }
+    else {
+        memset(text, ' ', row - 1);
+        for (uint64_t j = cell - 1; j < row - 1; j += cell) {
+            text[j] = '.';
         }
     }
-    word_ptr[board_size - 1] = '\0';
-    return word_ptr;
-}
\ No newline at end of file
+    text[row - 1] = '\n';
+    for (uint32_t y = 1; y < g->b_height; y++) {
+        memcpy(text + y * row, text, row);
+    }
+}
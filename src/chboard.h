@@ -9,6 +9,7 @@
 #ifndef CHBOARD_H
 #define CHBOARD_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "gamma.h"
 
@@ -21,6 +22,17 @@
  */
 extern uint32_t int_len(uint32_t number);
 
+/**
+ * @brief Wpisuje zapis dziesiętny liczby @p number tak, by kończył się tuż
+ *        przed adresem @p end.
+ * Cyfry są wpisywane od końca, po dwie naraz. Z funkcji korzysta tworzenie
+ * napisu opisującego planszę i bufor wyników trybu wsadowego.
+ * @param[out] end - adres tuż za miejscem na co najwyżej 20 cyfr.
+ * @param[in] number - liczba do zapisania.
+ * @return Adres pierwszej wpisanej cyfry.
+ */
+extern char *write_digits(char *end, uint64_t number);
+
 /**
  * @brief Podaje, która spośród dwóch liczb: @p a, @p b, jest większa.
  * @param[in] a - pierwsza liczba do porównania.
@@ -45,4 +57,55 @@ extern char *board_max_9(gamma_t *g);
  */
 extern char *board_more_than_9(gamma_t *g);
 
+/**
+ * @brief Zapisuje napis opisujący planszę do deskryptora @p fd.
+ * Gdy napis jest przechowywany w strukturze gry, zapisuje go w całości.
+ * W przeciwnym przypadku tworzy kolejne wiersze w buforze, którego rozmiar
+ * nie zależy od wysokości planszy, i zapisuje bufor, gdy się zapełni.
+ * Wiersze długiego napisu są tworzone na wielu wątkach, tak jak w funkcji
+ * board_max_9(...).
+ * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @param[in] fd - deskryptor pliku otwartego do zapisu.
+ * @return @p true, gdy zapisano cały napis, @p false, gdy nie udało się
+ *         zaalokować pamięci lub zapis się nie powiódł.
+ */
+extern bool board_write(gamma_t *g, int fd);
+
+/**
+ * @brief Podaje liczbę znaków, które zajmuje w napisie opisującym planszę
+ *        jedno pole.
+ * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @return 1, gdy graczy jest co najwyżej 9, w przeciwnym przypadku długość
+ *         największego numeru gracza powiększona o 1.
+ */
+extern uint32_t board_cell_width(gamma_t *g);
+
+/**
+ * @brief Podaje długość napisu opisującego planszę, bez kończącego go znaku
+ *        '\0'.
+ * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @return Liczba znaków napisu.
+ */
+extern uint64_t board_text_length(gamma_t *g);
+
+/**
+ * @brief Wpisuje w napis opisujący planszę aktualny opis pola (@p x, @p y).
+ * Zmienia tylko znaki należące do tego pola.
+ * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @param[in, out] text - napis utworzony przez funkcję board_max_9(...) lub
+ *                        board_more_than_9(...).
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ */
+extern void board_write_field(gamma_t *g, char *text, uint32_t x, uint32_t y);
+
+/**
+ * @brief Wpisuje w napis opisujący planszę opis pustej planszy.
+ * Wypełnia napis wiersz po wierszu, bez zaglądania do pól planszy.
+ * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @param[out] text - napis utworzony przez funkcję board_max_9(...) lub
+ *                    board_more_than_9(...).
+ */
+extern void board_write_empty(gamma_t *g, char *text);
+
 #endif /* CHBOARD_H */
\ No newline at end of file
@@ -9,15 +9,19 @@
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include "queue.h"
+#include <string.h>
 #include "moves.h"
 #include "chboard.h"
+#include "areas.h"
+#include "influence.h"
+#include "snapshot.h"
+#include "tpool.h"
 #include "gamma.h"
 
 /**
  * @brief Funkcja alokuje pamięć potrzebną do przeprowadzenia rozgrywki.
  * Alokuje pamięć dla: @p g->busy_areas, @p g->golden_move_available,
- * @p g->board.
+ * @p g->info, @p g->watched, @p g->board, @p g->busy_bits, @p g->registry.
  * @param[in, out] g - wskaźnik na strukturę, która ma za zadanie przechowywać
  *                     stan gry.
  * @return Jeśli alokacja pamięci się powiodła, wskaźnik na strukturę @p g,
@@ -39,35 +43,65 @@ static gamma_t* allocate_memory(gamma_t *g) {
         return NULL;
     }
 
-    g->board = malloc(g->b_width * sizeof(uint32_t *));
+    g->info = malloc(g->b_players * sizeof(struct gamma_player_info));
+
+    if (g->info == NULL) {
+        free(g->golden_move_available);
+        free(g->busy_areas);
+        free(g);
+        return NULL;
+    }
+
+    g->watched = malloc(g->b_players * sizeof(uint32_t));
+
+    if (g->watched == NULL) {
+        free(g->info);
+        free(g->golden_move_available);
+        free(g->busy_areas);
+        free(g);
+        return NULL;
+    }
+
+    g->board = create_new_arr(g);
     if (g->board == NULL) {
+        free(g->watched);
+        free(g->info);
         free(g->golden_move_available);
         free(g->busy_areas);
         free(g);
         return NULL;
     }
-    
-    for (uint32_t i = 0; i < g->b_width; i++) {
-        g->board[i] = calloc(g->b_height, sizeof(uint32_t));
 
-        if (g->board[i] == NULL) {
-            for (uint32_t j = 0; j <= i; j++) {
-                free(g->board[j]);
-            }
-            free(g->board);
-            free(g->golden_move_available);
-            free(g->busy_areas);
-            free(g);
-            return NULL;
-        }
+    g->busy_bits = create_bitmap(g);
+    if (g->busy_bits == NULL) {
+        free_arr(g, g->board);
+        free(g->watched);
+        free(g->info);
+        free(g->golden_move_available);
+        free(g->busy_areas);
+        free(g);
+        return NULL;
+    }
+
+    if (!registry_new(g)) {
+        free(g->busy_bits);
+        free_arr(g, g->board);
+        free(g->watched);
+        free(g->info);
+        free(g->golden_move_available);
+        free(g->busy_areas);
+        free(g);
+        return NULL;
     }
 
     return g;    
 }
 
 /**
- * @brief Funkcja nadaje początkową wartość polom tablicy 
- * @p g->golden_move_available. 
+ * @brief Funkcja nadaje początkową wartość polom tablic
+ * @p g->golden_move_available i @p g->info oraz licznikom wolnych pól
+ * i graczy, którzy mogą wykonać ruch.
+ * Zwiększa numer stanu planszy, unieważniając zapamiętane wyniki.
  * @param[in, out] g - wskaźnik na strukturę, przechowująca stan gry.
  * @return Wskaźnik na strukturę @p g.
  */
@@ -77,6 +111,17 @@ static gamma_t* initial_value(gamma_t *g) {
         g->golden_move_available[i] = true;
     }
 
+    memset(g->info, 0, g->b_players * sizeof(struct gamma_player_info));
+    // na planszy jest wolne pole, więc każdy gracz może wykonać ruch
+    for (uint32_t i = 0; i < g->b_players; i++) {
+        g->info[i].active = true;
+    }
+    g->active_players = g->b_players;
+    g->stale_players = 0;
+    g->watched_count = 0;
+    g->free_fields = (uint64_t)g->b_width * g->b_height;
+    g->epoch++;
+
     return g;
 }
 
@@ -96,6 +141,13 @@ gamma_t* gamma_new(uint32_t width, uint32_t height,
     g->b_width = width;
     g->b_height = height;
     g->areas_limit = areas;
+    g->epoch = 0;
+    g->board_text = NULL;
+    g->changed_bits = NULL;
+    g->changed_fields = 0;
+    memset(&g->counters, 0, sizeof(g->counters));
+    g->trace = NULL;
+    g->trace_arg = NULL;
 
     g = allocate_memory(g);
 
@@ -110,173 +162,292 @@ gamma_t* gamma_new(uint32_t width, uint32_t height,
 
 void gamma_delete(gamma_t *g) {
     if (g != NULL) {
-        for (uint32_t i = 0; i < g->b_width; i++) {
-            free(g->board[i]);
-        }
-        
+        free(g->board_text);
+        free(g->changed_bits);
+        registry_delete(g);
+        free(g->busy_bits);
+        free_arr(g, g->board);
+        free(g->watched);
+        free(g->info);
         free(g->golden_move_available);
         free(g->busy_areas);
-        free(g->board);
         free(g);
     }
 }
 
-bool gamma_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
-    if (!check_move_parameters(g, player, x, y))
-        return false;
-    
-    uint32_t **check_arr = create_new_arr(g);
-
-    if (check_arr == NULL) {
-        errno = ENOMEM;
-        return false;
-    }
+/**
+ * @brief Oznacza pole (@p x, @p y) jako zmienione, o ile zmiany są śledzone.
+ * @param[in, out] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ */
+static void mark_changed(gamma_t *g, uint32_t x, uint32_t y) {
+    if (g->changed_bits == NULL ||
+        test_field_bit(g, g->changed_bits, x, y))
+        return;
 
-    uint32_t counter = 0;
-    uint32_t counter2 = 0;
-    
-    if (!find_sets_of_player(g, player, x, y, check_arr, &counter)) {
-        errno = ENOMEM;
-        free_arr(g, check_arr);
-        return false;
-    }
+    set_field_bit(g, g->changed_bits, x, y);
+    g->changed_fields++;
+}
 
-    for (uint32_t i = 0; i < g->b_width; i++) {
-        for (uint32_t j = 0; j < g->b_height; j++) {
-            check_arr[i][j] = 0;
+/**
+ * @brief Oznacza wszystkie zajęte pola jako zmienione.
+ * @param[in, out] g - wskaźnik na strukturę, przechowującą stan gry.
+ */
+static void mark_busy_changed(gamma_t *g) {
+    for (uint32_t y = 0; y < g->b_height; y++) {
+        for (uint32_t x = next_field_bit(g, g->busy_bits, 0, y);
+             x < g->b_width; x = next_field_bit(g, g->busy_bits, x + 1, y)) {
+            mark_changed(g, x, y);
         }
     }
+}
 
-    uint32_t prev_player = g->board[x][y];
-    g->board[x][y] = player;
+void gamma_reset(gamma_t *g) {
+    if (g == NULL)
+        return;
 
-    if (!find_sets_of_player(g, player, x, y, check_arr, &counter2)) {
-        errno = ENOMEM;
-        free_arr(g, check_arr);
-        return false;
-    }
+    if (g->changed_bits != NULL)
+        mark_busy_changed(g);
+    clear_arr(g, g->board);
+    clear_bitmap(g, g->busy_bits);
 
-    g->board[x][y] = prev_player;
+    memset(g->busy_areas, 0, g->b_players * sizeof(uint32_t));
+    registry_clear(g);
+    initial_value(g);
 
-    if (!check_neighbors(g, player, x, y)) {
-        if (g->busy_areas[player - 1] + 1 > g->areas_limit) {
-            free_arr(g, check_arr);
-            return false;
-        }
-        g->busy_areas[player - 1]++;
-    }
+    if (g->board_text != NULL)
+        board_write_empty(g, g->board_text);
+}
 
-    g->busy_areas[player - 1] -= counter - counter2;
-    g->board[x][y] = player;
+uint32_t gamma_width(gamma_t *g) {
+    if (g == NULL)
+        return 0;
 
-    free_arr(g, check_arr);
-    return true;
+    return g->b_width;
 }
 
-bool gamma_golden_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
-    if (!check_golden_parameters(g, player, x, y))
-        return false;
-    uint32_t prev_player = g->board[x][y];
-    uint32_t player_arr[ADJACENT_FIELDS][2], player_arr_2[ADJACENT_FIELDS][2];
-    uint32_t **check_arr;
-    if (!make_help_arr(g, player_arr, player_arr_2, &check_arr, x , y)) {
-        errno = ENOMEM;
-        return false;
-    }
-    
-    if (!find_and_mark_sets(g, player, x, y, player_arr, player_arr_2,
-        check_arr)) {
-        errno = ENOMEM;
-        return false;
-    }
+uint32_t gamma_height(gamma_t *g) {
+    if (g == NULL)
+        return 0;
+
+    return g->b_height;
+}
+
+uint32_t gamma_players(gamma_t *g) {
+    if (g == NULL)
+        return 0;
+
+    return g->b_players;
+}
+
+uint32_t gamma_areas_limit(gamma_t *g) {
+    if (g == NULL)
+        return 0;
+
+    return g->areas_limit;
+}
 
-    if (!check_busy_areas(g, player, x, y, player_arr, player_arr_2,
-        prev_player, check_arr)) {
+/**
+ * @brief Podaje współrzędne sąsiada pola (@p x, @p y) o numerze @p i.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @param[in] i - numer sąsiada, od 0 do ADJACENT_FIELDS - 1.
+ * @param[out] nx - pierwsza współrzędna sąsiada.
+ * @param[out] ny - druga współrzędna sąsiada.
+ * @return @p true, gdy sąsiad leży na planszy, @p false w przeciwnym
+ * przypadku.
+ */
+static bool neighbor(gamma_t *g, uint32_t x, uint32_t y, int i,
+                     uint32_t *nx, uint32_t *ny) {
+    *nx = x;
+    *ny = y;
+    if (i == 0 && x > 0)
+        *nx = x - 1;
+    else if (i == 1 && x < g->b_width - 1)
+        *nx = x + 1;
+    else if (i == 2 && y > 0)
+        *ny = y - 1;
+    else if (i == 3 && y < g->b_height - 1)
+        *ny = y + 1;
+    else
         return false;
-    }
 
-    if (!check_neighbors(g, player, x, y)) {
-        if (g->busy_areas[player - 1] + 1 > g->areas_limit) {
-            g->board[x][y] = prev_player;
-            free_arr(g, check_arr);
-            return false;
-        }
+    return true;
+}
+
+/**
+ * @brief Zwiększa licznik wolnych pól sąsiadujących z polami gracza
+ * @p player o te wolne sąsiednie pola pola (@p x, @p y), które nie sąsiadują
+ * jeszcze z innymi polami gracza.
+ * Wywoływana przed postawieniem pionka gracza na polu (@p x, @p y).
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ */
+static void add_free_neighbors(gamma_t *g, uint32_t player, uint32_t x,
+                               uint32_t y) {
+    uint32_t nx, ny;
 
-        g->busy_areas[player - 1] += 1;
+    for (int i = 0; i < ADJACENT_FIELDS; i++) {
+        if (neighbor(g, x, y, i, &nx, &ny) && g->board[ny][nx] == 0 &&
+            !check_neighbors(g, player, nx, ny))
+            g->info[player - 1].adjacent_free++;
     }
+}
 
-    if (!check_neighbors(g, prev_player, x, y)) {
-        g->busy_areas[prev_player - 1] -= 1;
+/**
+ * @brief Zmniejsza licznik wolnych pól sąsiadujących z polami gracza
+ * @p player o te wolne sąsiednie pola pola (@p x, @p y), które przestały
+ * sąsiadować z polami gracza.
+ * Wywoływana po odebraniu graczowi pola (@p x, @p y).
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ */
+static void remove_free_neighbors(gamma_t *g, uint32_t player, uint32_t x,
+                                  uint32_t y) {
+    uint32_t nx, ny;
+
+    for (int i = 0; i < ADJACENT_FIELDS; i++) {
+        if (neighbor(g, x, y, i, &nx, &ny) && g->board[ny][nx] == 0 &&
+            !check_neighbors(g, player, nx, ny))
+            g->info[player - 1].adjacent_free--;
     }
+}
 
-    change_busy_areas(g, player, player_arr);
+/**
+ * @brief Aktualizuje liczniki graczy przed postawieniem pionka gracza
+ * @p player na wolnym polu (@p x, @p y).
+ * Pole przestaje być wolnym polem sąsiadującym z polami każdego z graczy,
+ * których pionki stoją obok niego.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ */
+static void take_free_field(gamma_t *g, uint32_t player, uint32_t x,
+                            uint32_t y) {
+    uint32_t seen[ADJACENT_FIELDS];
+    uint32_t n = 0, nx, ny;
 
-    uint32_t a = 0, b = 0;
     for (int i = 0; i < ADJACENT_FIELDS; i++) {
-        if (player_arr[i][0] == player) {
-            a = player_arr[i][1];
-            b = player_arr_2[i][1];
+        if (!neighbor(g, x, y, i, &nx, &ny) || g->board[ny][nx] == 0)
+            continue;
+
+        uint32_t owner = g->board[ny][nx];
+        bool repeated = false;
+        for (uint32_t k = 0; k < n; k++) {
+            if (seen[k] == owner)
+                repeated = true;
+        }
+
+        if (!repeated) {
+            seen[n++] = owner;
+            g->info[owner - 1].adjacent_free--;
         }
     }
-    g->golden_move_available[player - 1] = false;
-    g->busy_areas[player - 1] -= a - b;
 
-    free_arr(g, check_arr);
-    return true;
+    add_free_neighbors(g, player, x, y);
+    g->free_fields--;
+    g->info[player - 1].busy_fields++;
 }
 
-uint64_t gamma_busy_fields(gamma_t *g, uint32_t player) {
+/**
+ * @brief Zgłasza funkcji śledzącej początek lub koniec wywołania funkcji
+ * silnika. Bez makra @p GAMMA_INSTRUMENT nie robi nic.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry lub NULL.
+ * @param[in] call - wywołana funkcja.
+ * @param[in] end - @p false na początku, @p true na końcu wywołania.
+ */
+static inline void trace_call(gamma_t *g, enum gamma_call call, bool end) {
+#ifdef GAMMA_INSTRUMENT
+    if (g != NULL && g->trace != NULL)
+        g->trace(g->trace_arg, g, call, end);
+#else
+    (void)g;
+    (void)call;
+    (void)end;
+#endif
+}
+
+/**
+ * @brief Zwiększa numer stanu planszy i zapamiętuje zmianę, która do niego
+ * doprowadziła.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - gracz, który zajął pole.
+ * @param[in] prev_player - poprzedni właściciel pola lub 0.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ */
+static void log_change(gamma_t *g, uint32_t player, uint32_t prev_player,
+                       uint32_t x, uint32_t y) {
+    struct gamma_change *c = &g->changes[++g->epoch % GAMMA_CHANGE_LOG];
+
+    c->player = player;
+    c->prev_player = prev_player;
+    c->x = x;
+    c->y = y;
+}
+
+/**
+ * @brief Podaje liczbę pól zajętych przez gracza, tak jak funkcja
+ * @ref gamma_busy_fields, bez zgłaszania wywołania funkcji śledzącej.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @return Liczba pól zajętych przez gracza.
+ */
+static uint64_t busy_fields(gamma_t *g, uint32_t player) {
     if (g == NULL || player > g->b_players || player < 1)
         return 0;
 
-    uint64_t counter = 0;
+    return g->info[player - 1].busy_fields;
+}
 
-    for (uint32_t i = 0; i < g->b_width; i++) {
-        for (uint32_t j = 0; j < g->b_height; j++) {
-            if (g->board[i][j] == player) {
-                counter ++;
-            }
-        }
-    }
+uint64_t gamma_busy_fields(gamma_t *g, uint32_t player) {
+    trace_call(g, GAMMA_CALL_BUSY_FIELDS, false);
+    uint64_t result = busy_fields(g, player);
+    trace_call(g, GAMMA_CALL_BUSY_FIELDS, true);
 
-    return counter;
+    return result;
 }
 
-uint64_t gamma_free_fields(gamma_t *g, uint32_t player) {
+/**
+ * @brief Podaje liczbę pól, które gracz może zająć w kolejnym ruchu, tak jak
+ * funkcja @ref gamma_free_fields, bez zgłaszania wywołania funkcji
+ * śledzącej.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @return Liczba pól, które gracz może zająć.
+ */
+static uint64_t free_fields(gamma_t *g, uint32_t player) {
     if (g == NULL)
         return 0;
     if (player > g->b_players || player < 1)
         return 0;
 
-    uint64_t counter = 0;
-    bool in_area = false;
-
-    for (uint32_t i = 0; i < g->b_width; i++) {
-        for (uint32_t j = 0; j < g->b_height; j++) {
-            in_area = false;
-
-            if (g->busy_areas[player - 1] >= g->areas_limit &&
-                g->board[i][j] == 0) {
-                if (i > 0 && g->board[i - 1][j] == player)
-                    in_area = true;
-                if (i < g->b_width - 1 && g->board[i + 1][j] == player)
-                    in_area = true;
-                if (j > 0 && g->board[i][j - 1] == player)
-                    in_area = true;
-                if (j < g->b_height - 1 && g->board[i][j + 1] == player)
-                    in_area = true;
-
-                if (in_area)
-                    counter++;
-            }
-            else {
-                if (g->board[i][j] == 0)
-                    counter++;
-            }
-        }
-    }
+    if (g->busy_areas[player - 1] >= g->areas_limit)
+        return g->info[player - 1].adjacent_free;
 
-    return counter;
+    return g->free_fields;
+}
+
+uint64_t gamma_free_fields(gamma_t *g, uint32_t player) {
+    trace_call(g, GAMMA_CALL_FREE_FIELDS, false);
+    uint64_t result = free_fields(g, player);
+    trace_call(g, GAMMA_CALL_FREE_FIELDS, true);
+
+    return result;
+}
+
+uint64_t gamma_occupied_fields(gamma_t *g) {
+    if (g == NULL)
+        return 0;
+
+    return (uint64_t)g->b_width * g->b_height - g->free_fields;
 }
 
 /**
@@ -299,106 +470,874 @@ static bool golden_possible_parameters(gamma_t *g, uint32_t player) {
 }
 
 /**
- * @brief Sprawdza, czy gracz @p player stawiając pionek na polu (@p x, @p y)
- * nie przekroczy limitu obszarów.
+ * @brief Dopisuje gracza @p owner do właścicieli pól, od których zależy
+ * zapamiętana możliwość wykonania złotego ruchu.
+ * @param[in, out] info - liczniki gracza.
+ * @param[in] owner - numer gracza.
+ */
+static void add_golden_owner(struct gamma_player_info *info, uint32_t owner) {
+    uint32_t n = info->golden_owner_count;
+
+    for (uint32_t i = 0; i < n && i < GAMMA_GOLDEN_OWNERS; i++) {
+        if (info->golden_owners[i] == owner)
+            return;
+    }
+
+    if (n < GAMMA_GOLDEN_OWNERS)
+        info->golden_owners[n] = owner;
+    if (n <= GAMMA_GOLDEN_OWNERS)
+        info->golden_owner_count++;
+}
+
+/**
+ * @brief Zapamiętuje, czy gracz może zająć złotym ruchem sąsiadujące z jego
+ * polami pole gracza @p owner.
+ * @param[in, out] info - liczniki gracza.
+ * @param[in] owner - właściciel pola.
+ * @param[in] allowed - czy pole można zająć.
+ */
+static void note_golden_field(struct gamma_player_info *info, uint32_t owner,
+                              bool allowed) {
+    if (allowed) {
+        info->golden_possible = true;
+        info->golden_owner_count = 0;
+    }
+    add_golden_owner(info, owner);
+}
+
+/**
+ * @brief Sprawdza, czy zmiana planszy dotyczy gracza @p player.
+ * @param[in] info - liczniki gracza.
+ * @param[in] owner - gracz, którego pola zmieniono, lub 0.
+ * @return @p true, gdy zapamiętana wartość zależy od pól gracza @p owner.
+ */
+static bool golden_depends_on(const struct gamma_player_info *info,
+                              uint32_t owner) {
+    if (owner == 0)
+        return false;
+    for (uint32_t i = 0; i < info->golden_owner_count; i++) {
+        if (info->golden_owners[i] == owner)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Sprawdza, czy zajęcie pola (@p x, @p y) przez gracza @p changed
+ * mogło zmienić zapamiętaną możliwość wykonania złotego ruchu przez gracza
+ * @p player, który wyczerpał limit obszarów.
+ * Zmiana pola zmienia tylko obszary jego poprzedniego i nowego właściciela,
+ * a od obszarów gracza zależy jedynie, czy można zająć jego pola, więc
+ * wynik się nie zmienia, gdy zmiana nie dotyczyła gracza ani właścicieli
+ * pól, od których wynik zależy, a dla wyniku @p false także nie sąsiadowała
+ * z polami gracza.
  * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
- * @param[in] player - numer gracza
- * @param[in] x - pierwsza wspórzędna pola, na którym ma być postawiony pionek.
- * @param[in] y - druga wspórzędna pola, na którym ma być postawiony pionek.
- * @return @p true, gdy gracz @p player stawiając pionek na polu (@p x, @p y)
- * nie przekroczy limitu obszarów, @p false w przeciwnym przypadku.
+ * @param[in] player - numer gracza.
+ * @param[in] changed - gracz, który zajął pole.
+ * @param[in] prev - poprzedni właściciel pola lub 0.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @return @p true, gdy zapamiętany wynik mógł się zmienić, @p false
+ * w przeciwnym przypadku.
  */
-static bool check_limit_of_areas(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+static bool golden_affected(gamma_t *g, uint32_t player, uint32_t changed,
+                            uint32_t prev, uint32_t x, uint32_t y) {
+    const struct gamma_player_info *info = &g->info[player - 1];
+
+    return changed == player || prev == player ||
+           info->golden_owner_count > GAMMA_GOLDEN_OWNERS ||
+           golden_depends_on(info, changed) ||
+           golden_depends_on(info, prev) ||
+           (!info->golden_possible && check_neighbors(g, player, x, y));
+}
+
+/**
+ * @brief Sprawdza, czy zapamiętana możliwość wykonania złotego ruchu przez
+ * gracza @p player, który wyczerpał limit obszarów, jest nadal aktualna.
+ * Przegląda zmiany planszy od zapamiętania wyniku; wynik jest aktualny, gdy
+ * żadna z nich nie mogła go zmienić (funkcja golden_affected(...)).
+ * Aktualny wynik jest oznaczany bieżącym numerem stanu planszy.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @return @p true, gdy zapamiętany wynik jest aktualny, @p false w przeciwnym
+ * przypadku.
+ */
+static bool golden_cached(gamma_t *g, uint32_t player) {
+    struct gamma_player_info *info = &g->info[player - 1];
+
+    if (info->golden_epoch == g->epoch)
+        return true;
+    if (info->golden_epoch == 0 ||
+        g->epoch - info->golden_epoch > GAMMA_CHANGE_LOG)
+        return false;
+
+    for (uint64_t e = info->golden_epoch + 1; e <= g->epoch; e++) {
+        const struct gamma_change *c = &g->changes[e % GAMMA_CHANGE_LOG];
+
+        if (golden_affected(g, player, c->player, c->prev_player, c->x, c->y))
+            return false;
+    }
+
+    info->golden_epoch = g->epoch;
+    return true;
+}
+
+/**
+ * @brief Szuka w prostokącie pola innego gracza, sąsiadującego z polami gracza
+ * @p player, które gracz może zająć złotym ruchem.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in] min_x - najmniejsza pierwsza współrzędna pola prostokąta.
+ * @param[in] min_y - najmniejsza druga współrzędna pola prostokąta.
+ * @param[in] max_x - największa pierwsza współrzędna pola prostokąta.
+ * @param[in] max_y - największa druga współrzędna pola prostokąta.
+ * @param[out] possible - @p true, gdy znaleziono takie pole, w przeciwnym
+ * przypadku wartość nie jest zmieniana.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ * przypadku.
+ */
+static bool golden_in_box(gamma_t *g, uint32_t player, uint32_t min_x,
+                          uint32_t min_y, uint32_t max_x, uint32_t max_y,
+                          bool *possible) {
+    bool allowed;
+
+    for (uint32_t j = min_y; j <= max_y; j++) {
+        for (uint32_t i = min_x; i <= max_x; i++) {
+            GAMMA_COUNT(g, golden_scanned, 1);
+            if (g->board[j][i] == 0 || g->board[j][i] == player ||
+                !check_neighbors(g, player, i, j))
+                continue;
+
+            if (!field_can_be_taken(g, i, j, &allowed))
+                return false;
+            note_golden_field(&g->info[player - 1], g->board[j][i], allowed);
+            if (allowed) {
+                *possible = true;
+                return true;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Sprawdza, czy gracz @p player, który wyczerpał limit obszarów, może
+ * wykonać złoty ruch, czyli zająć któreś z sąsiadujących z jego polami pól
+ * innych graczy.
+ * Przegląda prostokąty ograniczające obszary gracza powiększone o jedno pole,
+ * a gdy mają one łącznie więcej pól niż plansza – całą planszę. Zapamiętuje
+ * właścicieli pól, od których zależy wynik.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[out] possible - @p true, gdy gracz może wykonać złoty ruch, @p false
+ * w przeciwnym przypadku.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ * przypadku.
+ */
+static bool golden_at_limit(gamma_t *g, uint32_t player, bool *possible) {
+    struct area_registry *r = g->registry;
+    uint64_t fields = (uint64_t)g->b_width * g->b_height;
+    uint64_t total = 0;
+
+    *possible = false;
+    g->info[player - 1].golden_owner_count = 0;
+
+    for (uint32_t id = r->first[player - 1]; id != 0 && total <= fields;
+         id = r->entries[id].next) {
+        gamma_area_t *a = &r->entries[id].area;
+        total += (uint64_t)(a->max_x - a->min_x + 3) * (a->max_y - a->min_y + 3);
+    }
+
+    if (total > fields)
+        return golden_in_box(g, player, 0, 0, g->b_width - 1, g->b_height - 1,
+                             possible);
+
+    for (uint32_t id = r->first[player - 1]; id != 0 && !*possible;
+         id = r->entries[id].next) {
+        gamma_area_t *a = &r->entries[id].area;
+        uint32_t min_x = a->min_x > 0 ? a->min_x - 1 : 0;
+        uint32_t min_y = a->min_y > 0 ? a->min_y - 1 : 0;
+        uint32_t max_x = a->max_x < g->b_width - 1 ? a->max_x + 1 : a->max_x;
+        uint32_t max_y = a->max_y < g->b_height - 1 ? a->max_y + 1 : a->max_y;
+
+        if (!golden_in_box(g, player, min_x, min_y, max_x, max_y, possible))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Sprawdza, czy gracz @p player może wykonać złoty ruch.
+ * Dla gracza, który wyczerpał limit obszarów, korzysta z zapamiętanego
+ * wyniku, jeśli zmiany planszy od jego zapamiętania nie mogły go zmienić,
+ * albo liczy go i zapamiętuje.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - poprawny numer gracza.
+ * @param[out] possible - @p true, gdy gracz może wykonać złoty ruch, @p false
+ * w przeciwnym przypadku.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ * przypadku.
+ */
+static bool check_golden(gamma_t *g, uint32_t player, bool *possible) {
+    struct gamma_player_info *info = &g->info[player - 1];
+    uint64_t occupied = (uint64_t)g->b_width * g->b_height - g->free_fields;
+
+    if (!g->golden_move_available[player - 1]) {
+        *possible = false;
+        return true;
+    }
+
+    // każdy obszar ma pole, po którego odebraniu się nie rozpada, więc gracz
+    // poniżej limitu obszarów może wykonać złoty ruch, gdy na planszy jest
+    // jakikolwiek pionek innego gracza
     if (g->busy_areas[player - 1] < g->areas_limit) {
+        *possible = occupied > info->busy_fields;
         return true;
     }
+
+    if (golden_cached(g, player)) {
+        GAMMA_COUNT(g, golden_cache_hits, 1);
+    }
     else {
-        if (x > 0 && g->board[x - 1][y] == player) 
-            return true;
-        else if (x < g->b_width - 1 &&
-                g->board[x + 1][y] == player)
-            return true;
-        else if (y > 0 && g->board[x][y - 1] == player) 
-            return true;
-        else if (y < g->b_height - 1 && 
-                g->board[x][y + 1] == player)
-            return true;
+        GAMMA_COUNT(g, golden_recomputes, 1);
+        // wynik liczony częściowo nie może zostać uznany za aktualny
+        info->golden_epoch = 0;
+        if (!golden_at_limit(g, player, &info->golden_possible))
+            return false;
+        info->golden_epoch = g->epoch;
     }
 
-    return false;
+    *possible = info->golden_possible;
+    return true;
 }
 
 /**
- * @brief Wypełnia dwuwymiarową tablicę o wymiarach @p g->b_width na
- * @p g->b_height zerami. 
- * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
- * @param[in, out] array - tablica, która będzie wypełniona zerami.
+ * @brief Sprawdza, czy gracz może wykonać złoty ruch, tak jak funkcja
+ * @ref gamma_golden_possible, bez zgłaszania wywołania funkcji śledzącej.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @return @p true, gdy gracz może wykonać złoty ruch, @p false w przeciwnym
+ * przypadku.
  */
-static void fill_array_with_zeros(gamma_t *g, uint32_t **array) {
-    for (uint32_t i = 0; i < g->b_width; i++) {
-        for (uint32_t j = 0; j < g->b_height; j++) {
-            array[i][j] = 0;
-        }
+static bool golden_possible(gamma_t *g, uint32_t player) {
+    if (golden_possible_parameters(g, player) == false)
+        return false;
+
+    bool possible;
+    if (!check_golden(g, player, &possible)) {
+        errno = ENOMEM;
+        return false;
     }
+
+    return possible;
 }
 
 bool gamma_golden_possible(gamma_t *g, uint32_t player) {
-    if (golden_possible_parameters(g, player) == false) 
+    trace_call(g, GAMMA_CALL_GOLDEN_POSSIBLE, false);
+    bool result = golden_possible(g, player);
+    trace_call(g, GAMMA_CALL_GOLDEN_POSSIBLE, true);
+
+    return result;
+}
+
+/**
+ * @brief Zapamiętuje, czy gracz @p player może wykonać ruch, poprawiając
+ * liczbę graczy, którzy mogą wykonać ruch.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in] active - czy gracz może wykonać ruch.
+ */
+static void set_active(gamma_t *g, uint32_t player, bool active) {
+    struct gamma_player_info *info = &g->info[player - 1];
+
+    if (info->active == active)
+        return;
+
+    info->active = active;
+    if (active)
+        g->active_players++;
+    else
+        g->active_players--;
+}
+
+/**
+ * @brief Dodaje gracza @p player do obserwowanych graczy lub go z nich usuwa.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in] watched - czy gracz ma być obserwowany.
+ */
+static void set_watched(gamma_t *g, uint32_t player, bool watched) {
+    struct gamma_player_info *info = &g->info[player - 1];
+
+    if (watched && info->watch_slot == 0) {
+        g->watched[g->watched_count++] = player;
+        info->watch_slot = g->watched_count;
+    }
+    else if (!watched && info->watch_slot != 0) {
+        // na zwolnione miejsce trafia ostatni obserwowany gracz
+        uint32_t last = g->watched[--g->watched_count];
+        g->watched[info->watch_slot - 1] = last;
+        g->info[last - 1].watch_slot = info->watch_slot;
+        info->watch_slot = 0;
+    }
+}
+
+/**
+ * @brief Ustala od nowa, czy gracz @p player może wykonać zwykły lub złoty
+ * ruch.
+ * Gracz, który nie może wykonać zwykłego ruchu, wyczerpał limit obszarów
+ * i nie wykonał złotego ruchu, jest obserwowany: możliwość złotego ruchu
+ * zależy wtedy od obszarów innych graczy. Gdy nie uda się zaalokować
+ * pamięci, gracz nie jest liczony jako mogący wykonać ruch, lecz jest
+ * oznaczany do ponownego sprawdzenia.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ * przypadku.
+ */
+static bool update_active(gamma_t *g, uint32_t player) {
+    struct gamma_player_info *info = &g->info[player - 1];
+    bool possible = free_fields(g, player) > 0;
+
+    set_watched(g, player, !possible &&
+                           g->golden_move_available[player - 1] &&
+                           g->busy_areas[player - 1] >= g->areas_limit);
+
+    bool known = possible || check_golden(g, player, &possible);
+    if (info->active_stale == known) {
+        info->active_stale = !known;
+        if (known)
+            g->stale_players--;
+        else
+            g->stale_players++;
+    }
+    set_active(g, player, known && possible);
+
+    return known;
+}
+
+/**
+ * @brief Poprawia informację, którzy gracze mogą wykonać ruch, po zajęciu
+ * pola (@p x, @p y) przez gracza @p player.
+ * Sprawdzani są tylko gracze, dla których zmiana mogła to zmienić:
+ * - nowy i poprzedni właściciel pola;
+ * - po zwykłym ruchu właściciele sąsiednich pól, którzy wyczerpali limit
+ *   obszarów, bo mogli stracić ostatnie wolne pole obok swoich pionków
+ *   (pozostali gracze mogą zająć każde wolne pole);
+ * - gracze obserwowani, dla których zmiana mogła zmienić możliwość
+ *   wykonania złotego ruchu (funkcja golden_cached(...)); pozostałym
+ *   zapamiętany wynik jest przenoszony na nowy stan planszy;
+ * - wszyscy gracze, gdy ruch zapełnił planszę.
+ * Możliwość złotego ruchu pozostałych graczy poniżej limitu obszarów zależy
+ * tylko od liczby pól innych graczy, więc się nie zmienia.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - gracz, który zajął pole.
+ * @param[in] prev_player - poprzedni właściciel pola lub 0.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ */
+static void update_players(gamma_t *g, uint32_t player, uint32_t prev_player,
+                           uint32_t x, uint32_t y) {
+    uint32_t nx, ny;
+
+    if (g->free_fields == 0 && prev_player == 0) {
+        for (uint32_t p = 1; p <= g->b_players; p++)
+            update_active(g, p);
+        return;
+    }
+
+    // gracz usunięty z obserwowanych jest zastępowany ostatnim, już
+    // sprawdzonym, więc tablica jest przeglądana od końca
+    for (uint32_t i = g->watched_count; i-- > 0;) {
+        uint32_t w = g->watched[i];
+
+        if (!golden_cached(g, w))
+            update_active(g, w);
+    }
+
+    update_active(g, player);
+    if (prev_player != 0) {
+        update_active(g, prev_player);
+    }
+    else {
+        for (int i = 0; i < ADJACENT_FIELDS; i++) {
+            if (!neighbor(g, x, y, i, &nx, &ny))
+                continue;
+            uint32_t owner = g->board[ny][nx];
+            if (owner != 0 && owner != player &&
+                g->busy_areas[owner - 1] >= g->areas_limit)
+                update_active(g, owner);
+        }
+    }
+}
+
+/**
+ * @brief Ustala, czy mogą wykonać ruch gracze oznaczeni do ponownego
+ * sprawdzenia.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ * przypadku.
+ */
+static bool update_stale(gamma_t *g) {
+    for (uint32_t p = 1; p <= g->b_players && g->stale_players > 0; p++) {
+        if (g->info[p - 1].active_stale && !update_active(g, p)) {
+            errno = ENOMEM;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Wykonuje ruch, tak jak funkcja @ref gamma_move, bez zgłaszania go
+ * funkcji śledzącej.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @return @p true, gdy ruch został wykonany, @p false w przeciwnym przypadku.
+ */
+static bool move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+    if (!check_move_parameters(g, player, x, y))
         return false;
 
-    uint32_t **visited_fields = create_new_arr(g);
-    if (visited_fields == NULL) {
+    uint32_t ids[ADJACENT_FIELDS];
+    uint32_t n = adjacent_areas(g, player, x, y, ids);
+
+    if (n == 0 && g->busy_areas[player - 1] + 1 > g->areas_limit)
+        return false;
+
+    if (!reserve_areas(g, 1, merge_cost(g, ids, n))) {
         errno = ENOMEM;
         return false;
     }
 
-    uint32_t counter_before = 0, counter_after = 0;
-    uint32_t player_on_field; 
-    
-    for (uint32_t i = 0; i < g->b_width; i++) {
-        for (uint32_t j = 0; j < g->b_height; j++) {
-            player_on_field = g->board[i][j];
-            if (g->board[i][j] > 0 && g->board[i][j] != player) {
-                counter_before = 0;
-                counter_after = 0;
-                fill_array_with_zeros(g, visited_fields);
-                if (find_sets_of_player(g, player_on_field, i, j,
-                                visited_fields, &counter_before) == false) {
-                    free_arr(g, visited_fields);
-                    return false;
-                 }
-
-                g->board[i][j] = player;
-                fill_array_with_zeros(g, visited_fields);
-                if (find_sets_of_player(g, player_on_field, i, j,
-                                    visited_fields, &counter_after) == false) {
-                    free_arr(g, visited_fields);
-                    return false;
-                 }
-
-                g->board[i][j] = player_on_field;
-
-                if (counter_after - counter_before + 
-                    g->busy_areas[player_on_field - 1] <= g->areas_limit
-                    && check_limit_of_areas(g, player, i, j)) {
-                    free_arr(g, visited_fields);
-                    return true;
-                }
+    add_field(g, player, x, y, ids, n);
+    take_free_field(g, player, x, y);
+    g->board[y][x] = player;
+    set_field_bit(g, g->busy_bits, x, y);
+    mark_changed(g, x, y);
+    if (g->board_text != NULL)
+        board_write_field(g, g->board_text, x, y);
+    // nowe pole tworzy obszar lub łączy n sąsiednich obszarów w jeden
+    g->busy_areas[player - 1] += 1;
+    g->busy_areas[player - 1] -= n;
+    log_change(g, player, 0, x, y);
+    update_players(g, player, 0, x, y);
+
+    return true;
+}
+
+bool gamma_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+    trace_call(g, GAMMA_CALL_MOVE, false);
+    bool result = move(g, player, x, y);
+    trace_call(g, GAMMA_CALL_MOVE, true);
+
+    return result;
+}
+
+/**
+ * @brief Wykonuje złoty ruch, tak jak funkcja @ref gamma_golden_move, bez
+ * zgłaszania go funkcji śledzącej.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] player - numer gracza.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @return @p true, gdy ruch został wykonany, @p false w przeciwnym przypadku.
+ */
+static bool golden_move(gamma_t *g, uint32_t player, uint32_t x,
+                        uint32_t y) {
+    if (!check_golden_parameters(g, player, x, y))
+        return false;
+
+    uint32_t prev_player = g->board[y][x];
+    uint32_t ids[ADJACENT_FIELDS];
+    uint32_t n = adjacent_areas(g, player, x, y, ids);
+
+    if (n == 0 && g->busy_areas[player - 1] + 1 > g->areas_limit)
+        return false;
+
+    uint64_t cost = merge_cost(g, ids, n);
+    if (area_size(g, x, y) > cost)
+        cost = area_size(g, x, y);
+
+    if (!reserve_areas(g, ADJACENT_FIELDS, cost)) {
+        errno = ENOMEM;
+        return false;
+    }
+
+    // obszar gracza prev_player może rozpaść się na tyle części, by gracz
+    // nie przekroczył limitu obszarów
+    uint32_t components;
+    uint32_t max_components =
+        g->areas_limit - g->busy_areas[prev_player - 1] + 1;
+
+    if (!remove_field(g, x, y, max_components, &components))
+        return false;
+
+    g->busy_areas[prev_player - 1] += components;
+    g->busy_areas[prev_player - 1] -= 1;
+
+    add_field(g, player, x, y, ids, n);
+    add_free_neighbors(g, player, x, y);
+    g->board[y][x] = player;
+    mark_changed(g, x, y);
+    if (g->board_text != NULL)
+        board_write_field(g, g->board_text, x, y);
+    remove_free_neighbors(g, prev_player, x, y);
+    g->info[prev_player - 1].busy_fields--;
+    g->info[player - 1].busy_fields++;
+    g->busy_areas[player - 1] += 1;
+    g->busy_areas[player - 1] -= n;
+    g->golden_move_available[player - 1] = false;
+    log_change(g, player, prev_player, x, y);
+    update_players(g, player, prev_player, x, y);
+
+    return true;
+}
+
+bool gamma_golden_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+    trace_call(g, GAMMA_CALL_GOLDEN_MOVE, false);
+    bool result = golden_move(g, player, x, y);
+    trace_call(g, GAMMA_CALL_GOLDEN_MOVE, true);
+
+    return result;
+}
+
+bool gamma_next_active_player(gamma_t *g, uint32_t player, uint32_t *next) {
+    if (g == NULL || next == NULL || player > g->b_players)
+        return false;
+    if (!update_stale(g))
+        return false;
+
+    *next = 0;
+    for (uint32_t i = 1; i <= g->b_players && g->active_players > 0; i++) {
+        uint32_t p = (player + i - 1) % g->b_players + 1;
+        if (g->info[p - 1].active) {
+            *next = p;
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool gamma_is_over(gamma_t *g) {
+    if (g == NULL)
+        return true;
+    if (g->stale_players > 0 && !update_stale(g))
+        return false;
+
+    return g->active_players == 0;
+}
+
+/**
+ * @brief Sprawdza, czy któryś z graczy sąsiadujących z zajętym polem
+ * (@p x, @p y), dla których możliwość wykonania złotego ruchu nie jest
+ * zapamiętana ani jeszcze znaleziona, może je zająć złotym ruchem.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] x - pierwsza współrzędna zajętego pola.
+ * @param[in] y - druga współrzędna zajętego pola.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ * przypadku.
+ */
+static bool check_golden_neighbors(gamma_t *g, uint32_t x, uint32_t y) {
+    uint32_t owner = g->board[y][x];
+    uint32_t nx, ny;
+    bool checked = false, allowed = false;
+
+    for (int i = 0; i < ADJACENT_FIELDS; i++) {
+        if (!neighbor(g, x, y, i, &nx, &ny))
+            continue;
+
+        uint32_t p = g->board[ny][nx];
+        if (p == 0 || p == owner || !g->golden_move_available[p - 1] ||
+            g->busy_areas[p - 1] < g->areas_limit ||
+            g->info[p - 1].golden_epoch == g->epoch ||
+            g->info[p - 1].golden_possible)
+            continue;
+
+        if (!checked) {
+            if (!field_can_be_taken(g, x, y, &allowed))
+                return false;
+            checked = true;
+        }
+        note_golden_field(&g->info[p - 1], owner, allowed);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Podaje statystyki wszystkich graczy, tak jak funkcja
+ * @ref gamma_stats_all, bez zgłaszania wywołania funkcji śledzącej.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[out] stats - tablica na statystyki kolejnych graczy.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ * przypadku.
+ */
+static bool stats_all(gamma_t *g, gamma_player_stats_t *stats) {
+    if (g == NULL || stats == NULL)
+        return false;
+
+    // graczy, dla których trzeba przejrzeć planszę, sprawdzamy w jednym
+    // przejściu zamiast osobno
+    uint32_t pending = 0;
+    for (uint32_t p = 0; p < g->b_players; p++) {
+        if (g->golden_move_available[p] &&
+            g->busy_areas[p] >= g->areas_limit &&
+            !golden_cached(g, p + 1)) {
+            g->info[p].golden_epoch = 0;
+            g->info[p].golden_possible = false;
+            g->info[p].golden_owner_count = 0;
+            pending++;
+        }
+    }
+
+    for (uint32_t j = 0; j < g->b_height && pending > 0; j++) {
+        for (uint32_t i = 0; i < g->b_width; i++) {
+            GAMMA_COUNT(g, golden_scanned, 1);
+            if (g->board[j][i] != 0 && !check_golden_neighbors(g, i, j)) {
+                errno = ENOMEM;
+                return false;
             }
         }
     }
-    free_arr(g, visited_fields);
-    return false;
+
+    for (uint32_t p = 0; p < g->b_players; p++) {
+        if (g->golden_move_available[p] &&
+            g->busy_areas[p] >= g->areas_limit)
+            g->info[p].golden_epoch = g->epoch;
+
+        stats[p].busy = busy_fields(g, p + 1);
+        stats[p].free = free_fields(g, p + 1);
+        check_golden(g, p + 1, &stats[p].golden_possible);
+    }
+
+    return true;
 }
 
-char *gamma_board(gamma_t *g) {
+bool gamma_stats_all(gamma_t *g, gamma_player_stats_t *stats) {
+    trace_call(g, GAMMA_CALL_STATS_ALL, false);
+    bool result = stats_all(g, stats);
+    trace_call(g, GAMMA_CALL_STATS_ALL, true);
+
+    return result;
+}
+
+uint32_t gamma_player_areas(gamma_t *g, uint32_t player, gamma_area_t *areas,
+                            uint32_t max) {
+    if (g == NULL || player < 1 || player > g->b_players)
+        return 0;
+
+    struct area_registry *r = g->registry;
+    uint32_t count = 0;
+
+    for (uint32_t id = r->first[player - 1]; id != 0;
+         id = r->entries[id].next) {
+        if (count < max) {
+            fit_area_box(g, id);
+            areas[count] = r->entries[id].area;
+        }
+        count++;
+    }
+
+    return count;
+}
+
+gamma_influence_t *gamma_influence_map(gamma_t *g, unsigned threads) {
     if (g == NULL)
         return NULL;
-    
+
+    if (threads == 0)
+        threads = tpool_default_workers();
+
+    gamma_influence_t *map = influence_map(g, threads);
+    if (map == NULL)
+        errno = ENOMEM;
+
+    return map;
+}
+
+bool gamma_next_busy(gamma_t *g, uint32_t y, uint32_t *x, uint32_t *owner) {
+    if (g == NULL || x == NULL || owner == NULL || y >= g->b_height)
+        return false;
+
+    uint32_t found = next_field_bit(g, g->busy_bits, *x, y);
+    if (found == g->b_width)
+        return false;
+
+    *x = found;
+    *owner = g->board[y][found];
+    return true;
+}
+
+bool gamma_track_changes(gamma_t *g, bool enable) {
+    if (g == NULL)
+        return false;
+
+    if (!enable) {
+        free(g->changed_bits);
+        g->changed_bits = NULL;
+        g->changed_fields = 0;
+    }
+    else if (g->changed_bits == NULL) {
+        g->changed_bits = create_bitmap(g);
+        if (g->changed_bits == NULL) {
+            errno = ENOMEM;
+            return false;
+        }
+        mark_busy_changed(g);
+    }
+
+    return true;
+}
+
+uint64_t gamma_changed_fields(gamma_t *g) {
+    if (g == NULL)
+        return 0;
+
+    return g->changed_fields;
+}
+
+bool gamma_next_changed(gamma_t *g, uint32_t y, uint32_t *x,
+                        uint32_t *owner) {
+    if (g == NULL || g->changed_bits == NULL || x == NULL || owner == NULL ||
+        y >= g->b_height)
+        return false;
+
+    uint32_t found = next_field_bit(g, g->changed_bits, *x, y);
+    if (found == g->b_width)
+        return false;
+
+    *x = found;
+    *owner = g->board[y][found];
+    return true;
+}
+
+void gamma_clear_changes(gamma_t *g) {
+    if (g == NULL || g->changed_bits == NULL)
+        return;
+
+    clear_bitmap(g, g->changed_bits);
+    g->changed_fields = 0;
+}
+
+bool gamma_save(gamma_t *g, const char *path) {
+    if (g == NULL || path == NULL)
+        return false;
+
+    return snapshot_save(g, path);
+}
+
+gamma_t *gamma_load(const char *path) {
+    if (path == NULL)
+        return NULL;
+
+    return snapshot_load(path);
+}
+
+/**
+ * @brief Tworzy od nowa napis opisujący planszę.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @return Wskaźnik na zaalokowany napis lub NULL, gdy nie udało się
+ * zaalokować pamięci.
+ */
+static char *render_board(gamma_t *g) {
     if (g->b_players < 10) {
         return board_max_9(g);
     }
     else {
         return board_more_than_9(g);
     }
-}
\ No newline at end of file
+}
+
+bool gamma_board_cache(gamma_t *g, bool enable) {
+    if (g == NULL)
+        return false;
+
+    if (!enable) {
+        free(g->board_text);
+        g->board_text = NULL;
+    }
+    else if (g->board_text == NULL) {
+        g->board_text = render_board(g);
+        if (g->board_text == NULL) {
+            errno = ENOMEM;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const char *gamma_board_view(gamma_t *g) {
+    if (!gamma_board_cache(g, true))
+        return NULL;
+
+    return g->board_text;
+}
+
+bool gamma_board_write(gamma_t *g, int fd) {
+    if (g == NULL)
+        return false;
+
+    trace_call(g, GAMMA_CALL_BOARD, false);
+    bool result = board_write(g, fd);
+    trace_call(g, GAMMA_CALL_BOARD, true);
+
+    return result;
+}
+
+char *gamma_board(gamma_t *g) {
+    if (g == NULL)
+        return NULL;
+
+    trace_call(g, GAMMA_CALL_BOARD, false);
+    char *copy;
+    if (g->board_text == NULL) {
+        copy = render_board(g);
+    }
+    else {
+        uint64_t length = board_text_length(g);
+        copy = malloc(length + 1);
+        if (copy != NULL)
+            memcpy(copy, g->board_text, length + 1);
+    }
+    trace_call(g, GAMMA_CALL_BOARD, true);
+
+    return copy;
+}
+
+bool gamma_get_counters(gamma_t *g, gamma_counters_t *counters) {
+#ifdef GAMMA_INSTRUMENT
+    if (g == NULL || counters == NULL)
+        return false;
+
+    *counters = g->counters;
+    return true;
+#else
+    (void)g;
+    (void)counters;
+    return false;
+#endif
+}
+
+bool gamma_set_trace(gamma_t *g, gamma_trace_fn fn, void *arg) {
+#ifdef GAMMA_INSTRUMENT
+    if (g == NULL)
+        return false;
+
+    g->trace = fn;
+    g->trace_arg = arg;
+    return true;
+#else
+    (void)g;
+    (void)fn;
+    (void)arg;
+    return false;
+#endif
+}
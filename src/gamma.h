@@ -13,6 +13,137 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+/**
+ * Największa liczba graczy, od których pól zależy zapamiętana możliwość
+ * wykonania złotego ruchu.
+ */
+#define GAMMA_GOLDEN_OWNERS 4
+
+/**
+ * Liczba ostatnich zmian planszy pamiętanych w strukturze gry, potęga dwójki.
+ */
+#define GAMMA_CHANGE_LOG 64
+
+/**
+ * Struktura opisująca spójny obszar pól zajętych przez jednego gracza.
+ */
+struct gamma_area {
+    uint32_t id;///< numer obszaru, niezerowy.
+    uint32_t owner;///< numer gracza, do którego należy obszar.
+    uint64_t size;///< liczba pól obszaru.
+    uint32_t min_x;///< najmniejsza pierwsza współrzędna pola obszaru.
+    uint32_t min_y;///< najmniejsza druga współrzędna pola obszaru.
+    uint32_t max_x;///< największa pierwsza współrzędna pola obszaru.
+    uint32_t max_y;///< największa druga współrzędna pola obszaru.
+};
+///Struktura opisująca spójny obszar pól zajętych przez jednego gracza.
+typedef struct gamma_area gamma_area_t;
+
+/**
+ * Struktura przechowująca liczniki gracza, aktualizowane przy każdym ruchu.
+ */
+struct gamma_player_info {
+    uint64_t busy_fields;///< liczba pól zajętych przez gracza.
+    uint64_t adjacent_free;///< liczba wolnych pól sąsiadujących z polami gracza.
+    uint64_t golden_epoch;
+    /**<
+     * Stan planszy (wartość @p epoch), dla którego zapamiętano wartość
+     * @p golden_possible, lub 0, gdy nie jest ona zapamiętana.
+     */
+    bool golden_possible;
+    /**<
+     * Zapamiętana informacja, czy gracz, który wyczerpał limit obszarów, może
+     * wykonać złoty ruch.
+     */
+    uint32_t golden_owners[GAMMA_GOLDEN_OWNERS];
+    /**<
+     * Właściciele pól, od których zależy zapamiętana wartość
+     * @p golden_possible: pola, które gracz może zająć złotym ruchem, gdy
+     * wartość to @p true, a w przeciwnym przypadku wszystkich pól innych
+     * graczy sąsiadujących z polami gracza.
+     */
+    uint32_t golden_owner_count;
+    /**<
+     * Liczba elementów @p golden_owners lub więcej niż
+     * @p GAMMA_GOLDEN_OWNERS, gdy właścicieli jest za dużo, by ich zapamiętać.
+     */
+    bool active;///< czy gracz może wykonać zwykły lub złoty ruch.
+    bool active_stale;
+    /**<
+     * Czy wartość @p active trzeba ustalić od nowa, bo przy jej ustalaniu
+     * zabrakło pamięci lub stan gry wczytano z pliku.
+     */
+    uint32_t watch_slot;
+    /**<
+     * Indeks gracza w tablicy @p watched struktury gry powiększony o 1 lub 0,
+     * gdy gracz nie jest obserwowany.
+     */
+};
+
+/**
+ * Struktura opisująca jedną zmianę planszy.
+ */
+struct gamma_change {
+    uint32_t player;///< gracz, który zajął pole.
+    uint32_t prev_player;///< poprzedni właściciel pola lub 0.
+    uint32_t x;///< pierwsza współrzędna pola.
+    uint32_t y;///< druga współrzędna pola.
+};
+
+/**
+ * Struktura przechowująca liczniki pracy wykonanej przez silnik. Liczniki są
+ * zwiększane tylko w programie skompilowanym z makrem @p GAMMA_INSTRUMENT,
+ * a w pozostałych ich obsługa nie kosztuje nic.
+ */
+struct gamma_counters {
+    uint64_t arrays_created;///< tablice o rozmiarze planszy utworzone przez create_new_arr(...).
+    uint64_t floods;///< przeglądania obszarów w głąb.
+    uint64_t flood_fields;///< pola wstawione na stos przy przeglądaniu obszarów.
+    uint64_t take_checks;///< sprawdzenia, czy pole można odebrać właścicielowi.
+    uint64_t take_floods;
+    /**<
+     * Sprawdzenia, czy pole można odebrać właścicielowi, wymagające
+     * przejrzenia obszaru.
+     */
+    uint64_t golden_scanned;///< pola przejrzane przy szukaniu złotego ruchu.
+    uint64_t golden_cache_hits;
+    /**<
+     * Odpowiedzi o możliwość złotego ruchu gracza, który wyczerpał limit
+     * obszarów, wzięte z zapamiętanego wyniku.
+     */
+    uint64_t golden_recomputes;
+    /**<
+     * Odpowiedzi o możliwość złotego ruchu gracza, który wyczerpał limit
+     * obszarów, liczone od nowa.
+     */
+};
+///Struktura przechowująca liczniki pracy wykonanej przez silnik.
+typedef struct gamma_counters gamma_counters_t;
+
+/**
+ * Wywołania funkcji silnika zgłaszane funkcji śledzącej.
+ */
+enum gamma_call {
+    GAMMA_CALL_MOVE,///< @ref gamma_move.
+    GAMMA_CALL_GOLDEN_MOVE,///< @ref gamma_golden_move.
+    GAMMA_CALL_BUSY_FIELDS,///< @ref gamma_busy_fields.
+    GAMMA_CALL_FREE_FIELDS,///< @ref gamma_free_fields.
+    GAMMA_CALL_GOLDEN_POSSIBLE,///< @ref gamma_golden_possible.
+    GAMMA_CALL_STATS_ALL,///< @ref gamma_stats_all.
+    GAMMA_CALL_BOARD///< @ref gamma_board lub @ref gamma_board_write.
+};
+
+struct gamma;
+
+/**
+ * Funkcja śledząca wywołania silnika, wywoływana na początku (@p end równe
+ * @p false) i na końcu (@p end równe @p true) każdego wywołania @p call
+ * dla gry @p g. Pierwszy parametr to wskaźnik przekazany do funkcji
+ * @ref gamma_set_trace.
+ */
+typedef void (*gamma_trace_fn)(void *arg, struct gamma *g,
+                               enum gamma_call call, bool end);
+
 /**
  * Struktura przechowująca stan gry.
  */
@@ -28,11 +159,78 @@ struct gamma {
      * Jeśli nie wykonał, w tablicy pod indeksem [numer_gracza - 1] znajduje
      * się @p true, w przeciwnym przypadku @p false.
      */
-    uint32_t **board;///<plansza.
+    uint32_t **board;///<plansza, pole (x, y) to element [y][x].
+    uint64_t *busy_bits;///< mapa bitowa zajętych pól planszy.
+    uint64_t *changed_bits;
+    /**<
+     * Mapa bitowa pól zmienionych od ostatniego wyczyszczenia zmian lub NULL,
+     * gdy zmiany nie są śledzone.
+     */
+    uint64_t changed_fields;///< liczba ustawionych bitów @p changed_bits.
+    struct area_registry *registry;///< rejestr obszarów zajętych przez graczy.
+    struct gamma_player_info *info;///< liczniki kolejnych graczy.
+    uint64_t free_fields;///< liczba wolnych pól planszy.
+    uint32_t active_players;
+    /**<
+     * Liczba graczy, którzy mogą wykonać ruch, nie licząc graczy oznaczonych
+     * do ponownego sprawdzenia.
+     */
+    uint32_t stale_players;///< liczba graczy oznaczonych do ponownego sprawdzenia.
+    uint32_t *watched;
+    /**<
+     * Gracze, którzy nie mogą wykonać zwykłego ruchu, wyczerpali limit
+     * obszarów i nie wykonali złotego ruchu. Możliwość wykonania przez nich
+     * ruchu jest sprawdzana po zmianach planszy, od których może ona zależeć.
+     */
+    uint32_t watched_count;///< liczba obserwowanych graczy.
+    uint64_t epoch;///< numer stanu planszy, zwiększany przy każdej jej zmianie.
+    struct gamma_change changes[GAMMA_CHANGE_LOG];
+    /**<
+     * Ostatnie zmiany planszy: zmiana, po której stan planszy ma numer
+     * @p e, to element [e % GAMMA_CHANGE_LOG].
+     */
+    char *board_text;
+    /**<
+     * Napis opisujący planszę, poprawiany przy każdym ruchu, lub NULL, gdy
+     * jego przechowywanie jest wyłączone.
+     */
+    gamma_counters_t counters;///< liczniki pracy wykonanej przez silnik.
+    gamma_trace_fn trace;///< funkcja śledząca wywołania silnika lub NULL.
+    void *trace_arg;///< wskaźnik przekazywany funkcji @p trace.
 };
 ///Struktura, przechowująca stan gry.
 typedef struct gamma gamma_t;
 
+/**
+ * Struktura przechowująca statystyki jednego gracza.
+ */
+struct gamma_player_stats {
+    uint64_t busy;///< liczba pól zajętych przez gracza.
+    uint64_t free;///< liczba pól, które gracz może zająć w następnym ruchu.
+    bool golden_possible;///< czy gracz może wykonać złoty ruch.
+};
+///Struktura przechowująca statystyki jednego gracza.
+typedef struct gamma_player_stats gamma_player_stats_t;
+
+/**
+ * Struktura opisująca wpływ graczy na jedno pole planszy.
+ */
+struct gamma_influence {
+    uint32_t owner;
+    /**<
+     * Numer gracza, którego pionek jest najbliżej pola, lub 0, gdy najbliżej
+     * są pionki kilku graczy albo na planszy nie ma pionków.
+     */
+    uint32_t distance;
+    /**<
+     * Odległość od najbliższego pionka, liczona w ruchach między sąsiednimi
+     * polami (0 dla pola zajętego), lub @p UINT32_MAX, gdy na planszy nie ma
+     * pionków.
+     */
+};
+///Struktura opisująca wpływ graczy na jedno pole planszy.
+typedef struct gamma_influence gamma_influence_t;
+
 /** @brief Tworzy strukturę przechowującą stan gry.
  * Alokuje pamięć na nową strukturę przechowującą stan gry.
  * Inicjuje tę strukturę tak, aby reprezentowała początkowy stan gry.
@@ -54,6 +252,40 @@ gamma_t* gamma_new(uint32_t width, uint32_t height,
  */
 void gamma_delete(gamma_t *g);
 
+/** @brief Przywraca początkowy stan gry.
+ * Czyści planszę, zeruje liczby obszarów graczy i przywraca wszystkim graczom
+ * możliwość wykonania złotego ruchu. Nie zmienia parametrów gry i nie alokuje
+ * pamięci, dzięki czemu jedna struktura może posłużyć do rozegrania wielu
+ * partii.
+ * Nic nie robi, jeśli wskaźnik @p g ma wartość NULL.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry.
+ */
+void gamma_reset(gamma_t *g);
+
+/** @brief Podaje szerokość planszy.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry.
+ * @return Szerokość planszy lub zero, gdy @p g ma wartość NULL.
+ */
+uint32_t gamma_width(gamma_t *g);
+
+/** @brief Podaje wysokość planszy.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wysokość planszy lub zero, gdy @p g ma wartość NULL.
+ */
+uint32_t gamma_height(gamma_t *g);
+
+/** @brief Podaje liczbę graczy.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry.
+ * @return Liczba graczy lub zero, gdy @p g ma wartość NULL.
+ */
+uint32_t gamma_players(gamma_t *g);
+
+/** @brief Podaje limit obszarów jednego gracza.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry.
+ * @return Limit obszarów lub zero, gdy @p g ma wartość NULL.
+ */
+uint32_t gamma_areas_limit(gamma_t *g);
+
 /** @brief Wykonuje ruch.
  * Ustawia pionek gracza @p player na polu (@p x, @p y).
  * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
@@ -105,6 +337,13 @@ uint64_t gamma_busy_fields(gamma_t *g, uint32_t player);
  */
 uint64_t gamma_free_fields(gamma_t *g, uint32_t player);
 
+/** @brief Podaje liczbę zajętych pól planszy.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry.
+ * @return Liczba pól zajętych przez wszystkich graczy lub zero, gdy @p g ma
+ * wartość NULL.
+ */
+uint64_t gamma_occupied_fields(gamma_t *g);
+
 /** @brief Sprawdza, czy gracz może wykonać złoty ruch.
  * Sprawdza, czy gracz @p player nie wykonał jeszcze złotego ruchu.
  * Sprawdza również, czy istnieje co najmniej jedno pole, na którym stoi pionek
@@ -123,9 +362,199 @@ uint64_t gamma_free_fields(gamma_t *g, uint32_t player);
  */
 bool gamma_golden_possible(gamma_t *g, uint32_t player);
 
+/** @brief Sprawdza, czy gra się zakończyła.
+ * Gra kończy się, gdy żaden z graczy nie może wykonać ani zwykłego, ani złotego
+ * ruchu. Zbiór graczy, którzy mogą wykonać ruch, jest poprawiany przy każdym
+ * ruchu, więc funkcja odczytuje tylko jego rozmiar. Wyjątkiem są gracze,
+ * przy których sprawdzaniu zabrakło pamięci, oraz gra wczytana z pliku – ci
+ * gracze są sprawdzani ponownie.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wartość @p true, jeśli gra się zakończyła lub @p g ma wartość NULL,
+ * a @p false, jeśli któryś z graczy może wykonać ruch lub nie udało się
+ * zaalokować pamięci (wtedy @p errno ma wartość @p ENOMEM).
+ */
+bool gamma_is_over(gamma_t *g);
+
+/** @brief Podaje następnego gracza, który może wykonać ruch.
+ * Przegląda graczy po kolei, zaczynając od gracza o numerze @p player + 1,
+ * a po graczu o największym numerze wraca do gracza 1.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba nieujemna niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new; 0 oznacza
+ *                      przeglądanie od gracza 1,
+ * @param[out] next   – numer gracza, który może wykonać ruch, lub zero, jeśli
+ *                      gra się zakończyła.
+ * @return Wartość @p true, jeśli udało się ustalić następnego gracza,
+ * a @p false, jeśli któryś z parametrów jest niepoprawny lub nie udało się
+ * zaalokować pamięci (wtedy @p errno ma wartość @p ENOMEM).
+ */
+bool gamma_next_active_player(gamma_t *g, uint32_t player, uint32_t *next);
+
+/** @brief Podaje statystyki wszystkich graczy.
+ * Zapisuje w tablicy @p stats, pod indeksem [numer_gracza - 1], wartości
+ * funkcji @ref gamma_busy_fields, @ref gamma_free_fields oraz
+ * @ref gamma_golden_possible dla każdego z graczy, przeglądając planszę
+ * co najwyżej raz.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[out] stats  – tablica o rozmiarze równym wartości @p players
+ *                      z funkcji @ref gamma_new.
+ * @return Wartość @p true, jeśli statystyki zostały zapisane, a @p false,
+ * gdy któryś z parametrów jest niepoprawny lub nie udało się zaalokować
+ * pamięci.
+ */
+bool gamma_stats_all(gamma_t *g, gamma_player_stats_t *stats);
+
+/** @brief Podaje obszary zajęte przez gracza.
+ * Zapisuje w tablicy @p areas opisy co najwyżej @p max obszarów gracza
+ * @p player: numer obszaru, liczbę jego pól oraz najmniejszy prostokąt,
+ * w którym się mieści. Numer obszaru nie zmienia się, dopóki obszar nie
+ * zostanie połączony z większym obszarem lub nie zostanie rozdzielony złotym
+ * ruchem.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[out] areas  – tablica, do której trafią opisy obszarów,
+ * @param[in] max     – rozmiar tablicy @p areas.
+ * @return Liczba obszarów zajętych przez gracza (może być większa od
+ * @p max) lub zero, jeśli któryś z parametrów jest niepoprawny.
+ */
+uint32_t gamma_player_areas(gamma_t *g, uint32_t player, gamma_area_t *areas,
+                            uint32_t max);
+
+/** @brief Liczy mapę wpływów graczy.
+ * Dla każdego pola podaje gracza, którego pionek stoi najbliżej, oraz
+ * odległość od tego pionka. Przeszukuje planszę wszerz jednocześnie od
+ * wszystkich zajętych pól, dzieląc każdy poziom przeszukiwania między wątki.
+ * Funkcja wywołująca musi zwolnić zwrócony bufor.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] threads – największa liczba wątków lub 0, by użyć tylu wątków,
+ *                      ile jest dostępnych procesorów.
+ * @return Wskaźnik na zaalokowany bufor o rozmiarze @p width * @p height,
+ * w którym opis pola (@p x, @p y) znajduje się pod indeksem
+ * @p y * @p width + @p x, lub NULL, jeśli nie udało się zaalokować pamięci
+ * lub @p g ma wartość NULL.
+ */
+gamma_influence_t *gamma_influence_map(gamma_t *g, unsigned threads);
+
+/** @brief Zapisuje stan gry do pliku binarnego.
+ * Zapisuje wymiary planszy, liczbę graczy, limit obszarów, informację, którzy
+ * gracze mogą jeszcze wykonać złoty ruch, oraz wszystkie pola planszy.
+ * Plik można wczytać funkcją @ref gamma_load.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] path    – ścieżka do pliku, który zostanie utworzony lub
+ *                      nadpisany.
+ * @return Wartość @p true, jeśli udało się zapisać plik, a @p false
+ * w przeciwnym przypadku lub gdy któryś z parametrów ma wartość NULL.
+ */
+bool gamma_save(gamma_t *g, const char *path);
+
+/** @brief Odtwarza stan gry zapisany funkcją @ref gamma_save.
+ * Mapuje plik do pamięci i kopiuje z niego pola planszy, a obszary graczy
+ * i liczniki wylicza na nowo w jednym przejściu po planszy.
+ * @param[in] path    – ścieżka do pliku.
+ * @return Wskaźnik na nową strukturę przechowującą stan gry lub NULL, jeśli
+ * nie udało się odczytać pliku, plik jest niepoprawny (także gdy któryś
+ * gracz przekracza w nim limit obszarów), nie udało się zaalokować pamięci
+ * lub @p path ma wartość NULL.
+ */
+gamma_t* gamma_load(const char *path);
+
+/** @brief Szuka kolejnego zajętego pola w wierszu planszy.
+ * Szuka w wierszu @p y pierwszego zajętego pola, którego pierwsza współrzędna
+ * jest nie mniejsza niż @p *x. Wolne pola pomija po 64 naraz, więc przejrzenie
+ * całej planszy kosztuje tyle, ile liczba zajętych pól plus liczba pól
+ * podzielona przez 64.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] y       – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                      @p height z funkcji @ref gamma_new,
+ * @param[in,out] x   – pierwsza współrzędna, od której zaczyna się szukanie;
+ *                      trafia tu pierwsza współrzędna znalezionego pola,
+ * @param[out] owner  – numer gracza zajmującego znalezione pole.
+ * @return Wartość @p true, jeśli znaleziono pole, a @p false, gdy w wierszu
+ * nie ma już zajętych pól lub któryś z parametrów jest niepoprawny.
+ */
+bool gamma_next_busy(gamma_t *g, uint32_t y, uint32_t *x, uint32_t *owner);
+
+/** @brief Włącza lub wyłącza śledzenie zmienionych pól planszy.
+ * Po włączeniu każdy ruch, złoty ruch i wyczyszczenie planszy oznacza
+ * zmienione pola w mapie bitowej. W chwili włączenia za zmienione uznawane są
+ * wszystkie zajęte pola, czyli zmiany względem pustej planszy.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] enable  – @p true, by włączyć śledzenie, @p false, by je
+ *                      wyłączyć.
+ * @return Wartość @p true, jeśli śledzenie zostało włączone lub wyłączone,
+ * a @p false, gdy nie udało się zaalokować pamięci lub @p g ma wartość NULL.
+ */
+bool gamma_track_changes(gamma_t *g, bool enable);
+
+/** @brief Podaje liczbę pól zmienionych od ostatniego wyczyszczenia zmian.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry.
+ * @return Liczba zmienionych pól lub zero, gdy zmiany nie są śledzone lub
+ * @p g ma wartość NULL.
+ */
+uint64_t gamma_changed_fields(gamma_t *g);
+
+/** @brief Szuka kolejnego zmienionego pola w wierszu planszy.
+ * Działa tak jak funkcja @ref gamma_next_busy, ale szuka pól zmienionych od
+ * ostatniego wyczyszczenia zmian. Zmienione pole może być już wolne.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] y       – numer wiersza,
+ * @param[in,out] x   – pierwsza współrzędna, od której zaczyna się szukanie;
+ *                      trafia tu pierwsza współrzędna znalezionego pola,
+ * @param[out] owner  – numer gracza zajmującego znalezione pole lub 0.
+ * @return Wartość @p true, jeśli znaleziono pole, a @p false, gdy w wierszu
+ * nie ma już zmienionych pól, zmiany nie są śledzone lub któryś
+ * z parametrów jest niepoprawny.
+ */
+bool gamma_next_changed(gamma_t *g, uint32_t y, uint32_t *x, uint32_t *owner);
+
+/** @brief Zapomina dotychczasowe zmiany, nie wyłączając ich śledzenia.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry.
+ */
+void gamma_clear_changes(gamma_t *g);
+
+/** @brief Włącza lub wyłącza przechowywanie napisu opisującego planszę.
+ * Gdy przechowywanie jest włączone, każdy ruch poprawia w przechowywanym
+ * napisie tylko znaki zmienionego pola, a funkcje @ref gamma_board
+ * i @ref gamma_board_view nie tworzą napisu od nowa.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] enable  – @p true, by włączyć przechowywanie, @p false, by je
+ *                      wyłączyć i zwolnić napis.
+ * @return Wartość @p true, jeśli przechowywanie zostało włączone lub
+ * wyłączone, a @p false, gdy nie udało się zaalokować pamięci lub @p g ma
+ * wartość NULL.
+ */
+bool gamma_board_cache(gamma_t *g, bool enable);
+
+/** @brief Udostępnia napis opisujący stan planszy bez kopiowania go.
+ * Włącza przechowywanie napisu (funkcja @ref gamma_board_cache), jeśli nie
+ * było włączone. Napis jest aktualizowany przez kolejne ruchy i pozostaje
+ * ważny do wyłączenia przechowywania lub usunięcia struktury. Funkcja
+ * wywołująca nie może go zmieniać ani zwalniać.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wskaźnik na napis opisujący planszę lub NULL, jeśli nie udało się
+ * zaalokować pamięci lub @p g ma wartość NULL.
+ */
+const char* gamma_board_view(gamma_t *g);
+
+/** @brief Zapisuje napis opisujący stan planszy do pliku.
+ * Zapisuje do deskryptora @p fd ten sam napis, który zwraca funkcja
+ * @ref gamma_board, bez tworzenia go w całości w pamięci. Kolejne wiersze
+ * planszy trafiają do bufora, którego rozmiar zależy tylko od szerokości
+ * planszy, a zapełniony bufor jest zapisywany. Gdy przechowywanie napisu
+ * jest włączone, zapisuje przechowywany napis.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] fd      – deskryptor pliku otwartego do zapisu.
+ * @return Wartość @p true, jeśli zapisano cały napis, a @p false, gdy nie
+ * udało się zaalokować pamięci, zapis się nie powiódł lub @p g ma wartość
+ * NULL.
+ */
+bool gamma_board_write(gamma_t *g, int fd);
+
 /** @brief Daje napis opisujący stan planszy.
  * Alokuje w pamięci bufor, w którym umieszcza napis zawierający tekstowy
  * opis aktualnego stanu planszy. Przykład znajduje się w pliku gamma_test.c.
+ * Gdy przechowywanie napisu jest włączone, kopiuje przechowywany napis.
  * Funkcja wywołująca musi zwolnić ten bufor.
  * @param[in] g       – wskaźnik na strukturę przechowującą stan gry.
  * @return Wskaźnik na zaalokowany bufor zawierający napis opisujący stan
@@ -133,4 +562,25 @@ bool gamma_golden_possible(gamma_t *g, uint32_t player);
  */
 char* gamma_board(gamma_t *g);
 
+/** @brief Podaje liczniki pracy wykonanej przez silnik od utworzenia gry.
+ * @param[in] g         – wskaźnik na strukturę przechowującą stan gry,
+ * @param[out] counters – miejsce na liczniki.
+ * @return Wartość @p true, jeśli podano liczniki, a @p false, gdy program
+ * skompilowano bez makra @p GAMMA_INSTRUMENT, więc liczniki nie są
+ * zwiększane, lub któryś z parametrów jest niepoprawny.
+ */
+bool gamma_get_counters(gamma_t *g, gamma_counters_t *counters);
+
+/** @brief Ustawia funkcję śledzącą wywołania silnika.
+ * Funkcja @p fn jest wywoływana na początku i na końcu każdego wywołania
+ * funkcji z @ref gamma_call dla gry @p g, ale nie wywołań tych funkcji przez
+ * sam silnik.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] fn      – funkcja śledząca lub NULL, by wyłączyć śledzenie,
+ * @param[in] arg     – wskaźnik przekazywany funkcji @p fn.
+ * @return Wartość @p true, jeśli ustawiono funkcję, a @p false, gdy program
+ * skompilowano bez makra @p GAMMA_INSTRUMENT lub @p g ma wartość NULL.
+ */
+bool gamma_set_trace(gamma_t *g, gamma_trace_fn fn, void *arg);
+
 #endif /* GAMMA_H */
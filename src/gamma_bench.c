@@ -0,0 +1,739 @@
+/**
+ * @file
+ * Program mierzący wydajność silnika gry gamma. Uruchamia zestaw
+ * powtarzalnych pomiarów: ruchy na pustej i zapełnionej planszy, złote ruchy
+ * na planszy podzielonej na wiele małych obszarów, najgorszy przypadek
+ * funkcji gamma_golden_possible(...), funkcję gamma_free_fields(...) dla
+ * graczy z wyczerpanym limitem obszarów, rysowanie planszy oraz wczytywanie
+ * i wykonywanie skryptu trybu wsadowego. Dane każdego pomiaru zależą tylko
+ * od ziarna, a wyniki są wypisywane jako tabela lub jako linie JSON. Zamiast
+ * zestawu pomiarów program może zmierzyć wykonanie skryptu z podanego pliku,
+ * np. wygenerowanego programem gamma_gen.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include "gamma.h"
+#include "lexer.h"
+#include "output.h"
+#include "batch.h"
+#include "options.h"
+#include "splitmix.h"
+
+/**
+ * Domyślna liczba powtórzeń każdego pomiaru.
+ */
+#define BENCH_REPS 3
+
+/**
+ * Struktura opisująca parametry gry, na której wykonywany jest pomiar.
+ */
+struct config {
+    uint32_t width;///< szerokość planszy.
+    uint32_t height;///< wysokość planszy.
+    uint32_t players;///< liczba graczy.
+    uint32_t areas;///< limit obszarów.
+};
+
+/**
+ * Funkcja wykonująca jedno powtórzenie pomiaru. Dostaje parametry gry,
+ * ziarno i liczbę operacji do wykonania, a zwraca czas wykonania tych
+ * operacji w nanosekundach, bez czasu przygotowania danych, lub ujemną
+ * liczbę, gdy zabrakło pamięci.
+ */
+typedef double (*bench_fn)(const struct config *c, uint64_t seed,
+                           uint64_t ops);
+
+/**
+ * Struktura opisująca jeden pomiar.
+ */
+struct bench {
+    const char *name;///< nazwa pomiaru.
+    bench_fn run;///< funkcja wykonująca pomiar.
+    struct config config;///< parametry gry.
+    uint64_t ops;///< liczba operacji w jednym powtórzeniu przy skali 1.
+};
+
+/**
+ * Struktura opisująca parametry uruchomienia programu.
+ */
+struct options {
+    uint64_t seed;///< ziarno generatora liczb losowych.
+    uint64_t scale;///< mnożnik liczby operacji.
+    unsigned reps;///< liczba powtórzeń każdego pomiaru.
+    bool json;///< czy wyniki mają być wypisane jako linie JSON.
+    const char *filter;///< fragment nazwy wybranych pomiarów lub NULL.
+    const char *script;///< skrypt trybu wsadowego do zmierzenia lub NULL.
+};
+
+/**
+ * @brief Podaje odczyt zegara monotonicznego.
+ * @return Liczba nanosekund od ustalonej chwili.
+ */
+static uint64_t now_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+}
+
+/**
+ * @brief Zajmuje wszystkie pola planszy pionkami losowych graczy.
+ * Ruchy na kolejne pola w losowej kolejności są wykonywane przez losowego
+ * gracza, a gdy nie jest to możliwe z powodu limitu obszarów, przez
+ * następnych graczy po kolei. Pola, których nie może zająć żaden gracz,
+ * pozostają wolne.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in, out] seed - stan generatora.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool fill_board(gamma_t *g, uint64_t *seed) {
+    uint64_t size = (uint64_t)g->b_width * g->b_height;
+    uint64_t *order = malloc(size * sizeof(uint64_t));
+    if (order == NULL)
+        return false;
+
+    for (uint64_t i = 0; i < size; i++)
+        order[i] = i;
+    for (uint64_t i = size - 1; i > 0; i--) {
+        uint64_t j = splitmix64(seed) % (i + 1);
+        uint64_t t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+
+    for (uint64_t i = 0; i < size; i++) {
+        uint32_t x = (uint32_t)(order[i] % g->b_width);
+        uint32_t y = (uint32_t)(order[i] / g->b_width);
+        uint32_t first = splitmix64_below(seed, g->b_players);
+        for (uint32_t k = 0; k < g->b_players; k++) {
+            if (gamma_move(g, (first + k) % g->b_players + 1, x, y))
+                break;
+        }
+    }
+
+    free(order);
+    return true;
+}
+
+/**
+ * @brief Mierzy ruchy na losowe pola planszy, zaczynając od pustej planszy.
+ * Po wykonaniu tylu ruchów, ile pól ma plansza, gra jest zerowana poza
+ * pomiarem.
+ * @param[in] c - parametry gry.
+ * @param[in] seed - ziarno.
+ * @param[in] ops - liczba ruchów.
+ * @return Czas w nanosekundach lub liczba ujemna, gdy zabrakło pamięci.
+ */
+static double bench_move_empty(const struct config *c, uint64_t seed,
+                               uint64_t ops) {
+    gamma_t *g = gamma_new(c->width, c->height, c->players, c->areas);
+    uint32_t *moves = malloc(3 * ops * sizeof(uint32_t));
+    if (g == NULL || moves == NULL) {
+        gamma_delete(g);
+        free(moves);
+        return -1;
+    }
+
+    for (uint64_t i = 0; i < ops; i++) {
+        moves[3 * i] = splitmix64_below(&seed, c->players) + 1;
+        moves[3 * i + 1] = splitmix64_below(&seed, c->width);
+        moves[3 * i + 2] = splitmix64_below(&seed, c->height);
+    }
+
+    uint64_t size = (uint64_t)c->width * c->height;
+    uint64_t elapsed = 0;
+    for (uint64_t done = 0; done < ops; done += size) {
+        uint64_t end = done + size < ops ? done + size : ops;
+        gamma_reset(g);
+        uint64_t start = now_ns();
+        for (uint64_t i = done; i < end; i++)
+            gamma_move(g, moves[3 * i], moves[3 * i + 1], moves[3 * i + 2]);
+        elapsed += now_ns() - start;
+    }
+
+    gamma_delete(g);
+    free(moves);
+    return (double)elapsed;
+}
+
+/**
+ * @brief Mierzy próby ruchów na zapełnionej planszy, na której żaden ruch
+ *        nie jest już możliwy.
+ * @param[in] c - parametry gry.
+ * @param[in] seed - ziarno.
+ * @param[in] ops - liczba ruchów.
+ * @return Czas w nanosekundach lub liczba ujemna, gdy zabrakło pamięci.
+ */
+static double bench_move_full(const struct config *c, uint64_t seed,
+                              uint64_t ops) {
+    gamma_t *g = gamma_new(c->width, c->height, c->players, c->areas);
+    uint32_t *moves = malloc(3 * ops * sizeof(uint32_t));
+    if (g == NULL || moves == NULL || !fill_board(g, &seed)) {
+        gamma_delete(g);
+        free(moves);
+        return -1;
+    }
+
+    for (uint64_t i = 0; i < ops; i++) {
+        moves[3 * i] = splitmix64_below(&seed, c->players) + 1;
+        moves[3 * i + 1] = splitmix64_below(&seed, c->width);
+        moves[3 * i + 2] = splitmix64_below(&seed, c->height);
+    }
+
+    uint64_t start = now_ns();
+    for (uint64_t i = 0; i < ops; i++)
+        gamma_move(g, moves[3 * i], moves[3 * i + 1], moves[3 * i + 2]);
+    uint64_t elapsed = now_ns() - start;
+
+    gamma_delete(g);
+    free(moves);
+    return (double)elapsed;
+}
+
+/**
+ * @brief Mierzy złote ruchy na planszy zapełnionej losowo pionkami wielu
+ *        graczy, czyli podzielonej na wiele małych obszarów.
+ * Każdy gracz wykonuje jeden złoty ruch na losowe pole innego gracza, po
+ * czym plansza jest zapełniana od nowa poza pomiarem.
+ * @param[in] c - parametry gry.
+ * @param[in] seed - ziarno.
+ * @param[in] ops - liczba złotych ruchów.
+ * @return Czas w nanosekundach lub liczba ujemna, gdy zabrakło pamięci.
+ */
+static double bench_golden_fragmented(const struct config *c, uint64_t seed,
+                                      uint64_t ops) {
+    gamma_t *g = gamma_new(c->width, c->height, c->players, c->areas);
+    uint32_t *targets = malloc(2 * (size_t)c->players * sizeof(uint32_t));
+    if (g == NULL || targets == NULL) {
+        gamma_delete(g);
+        free(targets);
+        return -1;
+    }
+
+    uint64_t elapsed = 0;
+    bool ok = true;
+    for (uint64_t done = 0; ok && done < ops; done += c->players) {
+        gamma_reset(g);
+        ok = fill_board(g, &seed);
+
+        for (uint32_t p = 1; ok && p <= c->players; p++) {
+            uint32_t x, y;
+            do {
+                x = splitmix64_below(&seed, c->width);
+                y = splitmix64_below(&seed, c->height);
+            } while (g->board[y][x] == p || g->board[y][x] == 0);
+            targets[2 * (p - 1)] = x;
+            targets[2 * (p - 1) + 1] = y;
+        }
+
+        uint32_t count = ops - done < c->players ? (uint32_t)(ops - done)
+                                                 : c->players;
+        uint64_t start = now_ns();
+        for (uint32_t p = 1; p <= count; p++)
+            gamma_golden_move(g, p, targets[2 * (p - 1)],
+                              targets[2 * (p - 1) + 1]);
+        elapsed += now_ns() - start;
+    }
+
+    gamma_delete(g);
+    free(targets);
+    return ok ? (double)elapsed : -1;
+}
+
+/**
+ * @brief Ustawia planszę, na której sprawdzenie, czy gracz 1 może wykonać
+ *        złoty ruch, jest najdroższe.
+ * Gracz 2 ma jeden obszar: wąż zajmujący wszystkie parzyste wiersze,
+ * połączone na przemian prawym i lewym końcem. Gracz 1 ma jeden obszar
+ * w trzecim wierszu, sąsiadujący z dwoma wierszami węża. Limit obszarów
+ * wynosi 1, więc złoty ruch gracza 1 musi sąsiadować z jego obszarem, a każde
+ * takie pole węża go rozcina, więc dla każdego z nich silnik przegląda cały
+ * wąż i odpowiedź jest przecząca.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry,
+ *                     o wysokości co najmniej 7.
+ */
+static void build_serpent(gamma_t *g) {
+    uint32_t w = g->b_width;
+    for (uint32_t y = 0; y < g->b_height; y += 2) {
+        bool rightwards = (y / 2) % 2 == 0;
+        for (uint32_t i = 0; i < w; i++)
+            gamma_move(g, 2, rightwards ? i : w - 1 - i, y);
+        if (y + 2 < g->b_height)
+            gamma_move(g, 2, rightwards ? w - 1 : 0, y + 1);
+    }
+
+    for (uint32_t x = 1; x < w; x++)
+        gamma_move(g, 1, x, 3);
+}
+
+/**
+ * @brief Mierzy najgorszy przypadek funkcji gamma_golden_possible(...):
+ *        plansza z funkcji build_serpent(...) i odpowiedź obliczana za
+ *        każdym razem od nowa.
+ * @param[in] c - parametry gry.
+ * @param[in] seed - ziarno, nieużywane, bo plansza jest ustalona.
+ * @param[in] ops - liczba wywołań.
+ * @return Czas w nanosekundach lub liczba ujemna, gdy zabrakło pamięci.
+ */
+static double bench_golden_worst(const struct config *c, uint64_t seed,
+                                 uint64_t ops) {
+    (void)seed;
+    gamma_t *g = gamma_new(c->width, c->height, c->players, c->areas);
+    if (g == NULL)
+        return -1;
+    build_serpent(g);
+
+    uint64_t start = now_ns();
+    for (uint64_t i = 0; i < ops; i++) {
+        g->info[0].golden_epoch = 0;
+        gamma_golden_possible(g, 1);
+    }
+    uint64_t elapsed = now_ns() - start;
+
+    gamma_delete(g);
+    return (double)elapsed;
+}
+
+/**
+ * @brief Mierzy powtarzane wywołania gamma_golden_possible(...) na planszy
+ *        z funkcji build_serpent(...), gdy między nimi plansza się nie
+ *        zmienia.
+ * @param[in] c - parametry gry.
+ * @param[in] seed - ziarno, nieużywane, bo plansza jest ustalona.
+ * @param[in] ops - liczba wywołań.
+ * @return Czas w nanosekundach lub liczba ujemna, gdy zabrakło pamięci.
+ */
+static double bench_golden_cached(const struct config *c, uint64_t seed,
+                                  uint64_t ops) {
+    (void)seed;
+    gamma_t *g = gamma_new(c->width, c->height, c->players, c->areas);
+    if (g == NULL)
+        return -1;
+    build_serpent(g);
+
+    uint64_t start = now_ns();
+    for (uint64_t i = 0; i < ops; i++)
+        gamma_golden_possible(g, 1);
+    uint64_t elapsed = now_ns() - start;
+
+    gamma_delete(g);
+    return (double)elapsed;
+}
+
+/**
+ * @brief Mierzy funkcję gamma_free_fields(...) na planszy zapełnionej przez
+ *        graczy, z których większość wyczerpała limit obszarów.
+ * @param[in] c - parametry gry.
+ * @param[in] seed - ziarno.
+ * @param[in] ops - liczba wywołań.
+ * @return Czas w nanosekundach lub liczba ujemna, gdy zabrakło pamięci.
+ */
+static double bench_free_fields(const struct config *c, uint64_t seed,
+                                uint64_t ops) {
+    gamma_t *g = gamma_new(c->width, c->height, c->players, c->areas);
+    uint32_t *players = malloc(ops * sizeof(uint32_t));
+    if (g == NULL || players == NULL || !fill_board(g, &seed)) {
+        gamma_delete(g);
+        free(players);
+        return -1;
+    }
+
+    for (uint64_t i = 0; i < ops; i++)
+        players[i] = splitmix64_below(&seed, c->players) + 1;
+
+    uint64_t sum = 0;
+    uint64_t start = now_ns();
+    for (uint64_t i = 0; i < ops; i++)
+        sum += gamma_free_fields(g, players[i]);
+    uint64_t elapsed = now_ns() - start;
+
+    gamma_delete(g);
+    free(players);
+    return sum == UINT64_MAX ? -1 : (double)elapsed;
+}
+
+/**
+ * @brief Mierzy rysowanie zapełnionej planszy funkcją gamma_board(...).
+ * @param[in] c - parametry gry.
+ * @param[in] seed - ziarno.
+ * @param[in] ops - liczba wywołań.
+ * @return Czas w nanosekundach lub liczba ujemna, gdy zabrakło pamięci.
+ */
+static double bench_board(const struct config *c, uint64_t seed,
+                          uint64_t ops) {
+    gamma_t *g = gamma_new(c->width, c->height, c->players, c->areas);
+    if (g == NULL || !fill_board(g, &seed)) {
+        gamma_delete(g);
+        return -1;
+    }
+
+    bool ok = true;
+    uint64_t start = now_ns();
+    for (uint64_t i = 0; ok && i < ops; i++) {
+        char *board = gamma_board(g);
+        ok = board != NULL;
+        free(board);
+    }
+    uint64_t elapsed = now_ns() - start;
+
+    gamma_delete(g);
+    return ok ? (double)elapsed : -1;
+}
+
+/**
+ * @brief Zapisuje do pliku tymczasowego losowy skrypt trybu wsadowego.
+ * Po linii @p B następuje @p ops poleceń: głównie ruchy, a także złote
+ * ruchy, polecenia @p b, @p f i @p q oraz nieliczne polecenia @p p.
+ * @param[in] c - parametry gry.
+ * @param[in, out] seed - stan generatora.
+ * @param[in] ops - liczba poleceń po linii @p B.
+ * @param[out] path - bufor na ścieżkę pliku.
+ * @param[in] path_size - rozmiar bufora.
+ * @return @p true, gdy udało się zapisać plik, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool write_script(const struct config *c, uint64_t *seed,
+                         uint64_t ops, char *path, size_t path_size) {
+    snprintf(path, path_size, "%s/gamma_bench.XXXXXX", P_tmpdir);
+    int fd = mkstemp(path);
+    if (fd < 0)
+        return false;
+
+    FILE *f = fdopen(fd, "w");
+    if (f == NULL) {
+        close(fd);
+        unlink(path);
+        return false;
+    }
+
+    fprintf(f, "B %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 "\n",
+            c->width, c->height, c->players, c->areas);
+    for (uint64_t i = 0; i < ops; i++) {
+        uint32_t kind = splitmix64_below(seed, 1000);
+        uint32_t p = splitmix64_below(seed, c->players) + 1;
+        uint32_t x = splitmix64_below(seed, c->width);
+        uint32_t y = splitmix64_below(seed, c->height);
+        if (kind < 800)
+            fprintf(f, "m %" PRIu32 " %" PRIu32 " %" PRIu32 "\n", p, x, y);
+        else if (kind < 840)
+            fprintf(f, "g %" PRIu32 " %" PRIu32 " %" PRIu32 "\n", p, x, y);
+        else if (kind < 890)
+            fprintf(f, "b %" PRIu32 "\n", p);
+        else if (kind < 940)
+            fprintf(f, "f %" PRIu32 "\n", p);
+        else if (kind < 999)
+            fprintf(f, "q %" PRIu32 "\n", p);
+        else
+            fputs("p\n", f);
+    }
+
+    if (fclose(f) != 0) {
+        unlink(path);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Wczytuje, rozkłada i wykonuje skrypt trybu wsadowego, z wynikami
+ *        zapisywanymi do @p /dev/null.
+ * Pierwszym poleceniem skryptu musi być poprawna linia @p B.
+ * @param[in] path - ścieżka do pliku ze skryptem.
+ * @param[out] c - parametry gry z linii @p B.
+ * @param[out] lines - liczba wykonanych poleceń po linii @p B.
+ * @return Czas w nanosekundach lub liczba ujemna, gdy nie udało się
+ *         wczytać lub wykonać skryptu.
+ */
+static double execute_script(const char *path, struct config *c,
+                             uint64_t *lines) {
+    int null_fd = open("/dev/null", O_WRONLY);
+    struct line_reader r;
+    struct output out;
+    bool ok = null_fd >= 0 && output_init(&out, null_fd);
+    if (ok && !reader_open(&r, path)) {
+        output_free(&out);
+        ok = false;
+    }
+    if (!ok) {
+        if (null_fd >= 0)
+            close(null_fd);
+        return -1;
+    }
+
+    uint64_t start = now_ns();
+    gamma_t *g = NULL;
+    struct batch_line line = {LINE_COMMAND, {0}, 0};
+    *lines = 0;
+    while (ok) {
+        line.status = next_command(&r, &line.cmd, &line.line_number);
+        if (line.status == LINE_END || line.status == LINE_NO_MEMORY)
+            break;
+        if (g == NULL) {
+            const uint32_t *params = line.cmd.params;
+            ok = line.status == LINE_COMMAND && line.cmd.name == 'B' &&
+                 line.cmd.words == 5 && line.cmd.numbers_valid;
+            if (ok) {
+                g = gamma_new(params[0], params[1], params[2], params[3]);
+                ok = g != NULL;
+            }
+        }
+        else {
+            ok = batch_execute_line(&out, &out, g, &line);
+            (*lines)++;
+        }
+    }
+    output_flush(&out);
+    uint64_t elapsed = now_ns() - start;
+
+    ok = ok && line.status == LINE_END && !out.failed && *lines > 0;
+    if (ok) {
+        c->width = g->b_width;
+        c->height = g->b_height;
+        c->players = g->b_players;
+        c->areas = g->areas_limit;
+    }
+    gamma_delete(g);
+    reader_free(&r);
+    output_free(&out);
+    close(null_fd);
+    return ok ? (double)elapsed : -1;
+}
+
+/**
+ * @brief Mierzy wczytanie, rozłożenie i wykonanie losowego skryptu trybu
+ *        wsadowego.
+ * Skrypt jest zapisywany do pliku tymczasowego poza pomiarem.
+ * @param[in] c - parametry gry.
+ * @param[in] seed - ziarno.
+ * @param[in] ops - liczba poleceń.
+ * @return Czas w nanosekundach lub liczba ujemna, gdy nie udało się
+ *         zapisać lub wykonać skryptu.
+ */
+static double bench_batch(const struct config *c, uint64_t seed,
+                          uint64_t ops) {
+    char path[256];
+    if (!write_script(c, &seed, ops, path, sizeof(path)))
+        return -1;
+
+    struct config script;
+    uint64_t lines;
+    double elapsed = execute_script(path, &script, &lines);
+    unlink(path);
+    return elapsed;
+}
+
+/**
+ * Zestaw pomiarów.
+ */
+static const struct bench benches[] = {
+    {"move_empty", bench_move_empty, {16, 16, 4, 8}, 1 << 20},
+    {"move_empty", bench_move_empty, {256, 256, 4, 64}, 1 << 20},
+    {"move_empty", bench_move_empty, {2048, 2048, 16, 1024}, 1 << 20},
+    {"move_full", bench_move_full, {16, 16, 4, 256}, 1 << 20},
+    {"move_full", bench_move_full, {256, 256, 4, 65536}, 1 << 20},
+    {"move_full", bench_move_full, {2048, 2048, 16, 1 << 22}, 1 << 20},
+    {"golden_fragmented", bench_golden_fragmented, {64, 64, 64, 4096}, 4096},
+    {"golden_fragmented", bench_golden_fragmented, {512, 512, 1024, 262144},
+     4096},
+    {"golden_possible_worst", bench_golden_worst, {32, 32, 2, 1}, 1024},
+    {"golden_possible_worst", bench_golden_worst, {128, 128, 2, 1}, 16},
+    {"golden_possible_cached", bench_golden_cached, {128, 128, 2, 1}, 1 << 20},
+    {"free_fields_at_limit", bench_free_fields, {256, 256, 8, 4}, 1 << 22},
+    {"board_render", bench_board, {256, 256, 9, 65536}, 64},
+    {"board_render", bench_board, {256, 256, 50, 65536}, 64},
+    {"batch_end_to_end", bench_batch, {256, 256, 8, 16}, 1 << 20},
+};
+
+/**
+ * @brief Porównuje dwie liczby zmiennoprzecinkowe, na potrzeby qsort.
+ * @param[in] a - wskaźnik na pierwszą liczbę.
+ * @param[in] b - wskaźnik na drugą liczbę.
+ * @return Liczba ujemna, zero lub dodatnia, gdy pierwsza liczba jest
+ *         odpowiednio mniejsza, równa lub większa od drugiej.
+ */
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Wypisuje wynik pomiaru: najmniejszy i środkowy czas jednej
+ *        operacji.
+ * @param[in] name - nazwa pomiaru.
+ * @param[in] c - parametry gry.
+ * @param[in] ops - liczba operacji w jednym powtórzeniu.
+ * @param[in] o - parametry uruchomienia programu.
+ * @param[in, out] times - czasy jednej operacji w kolejnych powtórzeniach.
+ */
+static void print_result(const char *name, const struct config *c,
+                         uint64_t ops, const struct options *o,
+                         double *times) {
+    qsort(times, o->reps, sizeof(double), compare_doubles);
+
+    double best = times[0], median = times[o->reps / 2];
+    if (o->json) {
+        printf("{\"bench\":\"%s\",\"width\":%" PRIu32 ",\"height\":%" PRIu32
+               ",\"players\":%" PRIu32 ",\"areas\":%" PRIu32
+               ",\"ops\":%" PRIu64 ",\"reps\":%u,\"seed\":%" PRIu64
+               ",\"best_ns_per_op\":%.2f,\"median_ns_per_op\":%.2f}\n",
+               name, c->width, c->height, c->players, c->areas, ops,
+               o->reps, o->seed, best, median);
+    }
+    else {
+        char size[32];
+        snprintf(size, sizeof(size), "%" PRIu32 "x%" PRIu32, c->width,
+                 c->height);
+        printf("%-24s %10s %8" PRIu32 " %8" PRIu32 " %10" PRIu64
+               " %12.2f %12.2f %10.3f\n", name, size, c->players,
+               c->areas, ops, best, median, best > 0 ? 1e3 / best : 0.0);
+    }
+    fflush(stdout);
+}
+
+/**
+ * @brief Wykonuje zadaną liczbę powtórzeń pomiaru i wypisuje jego wynik.
+ * Każde powtórzenie dostaje to samo ziarno, więc wykonuje tę samą pracę.
+ * @param[in] b - pomiar.
+ * @param[in] o - parametry uruchomienia programu.
+ * @param[in, out] times - bufor na czasy kolejnych powtórzeń.
+ * @return @p true, gdy pomiar się powiódł, @p false w przeciwnym przypadku.
+ */
+static bool run_bench(const struct bench *b, const struct options *o,
+                      double *times) {
+    uint64_t ops = b->ops * o->scale;
+    for (unsigned i = 0; i < o->reps; i++) {
+        times[i] = b->run(&b->config, o->seed, ops) / (double)ops;
+        if (times[i] < 0)
+            return false;
+    }
+
+    print_result(b->name, &b->config, ops, o, times);
+    return true;
+}
+
+/**
+ * @brief Wykonuje zadaną liczbę powtórzeń skryptu z pliku podanego opcją
+ *        @p -i i wypisuje wynik pomiaru, w którym operacją jest jedno
+ *        polecenie skryptu.
+ * @param[in] o - parametry uruchomienia programu.
+ * @param[in, out] times - bufor na czasy kolejnych powtórzeń.
+ * @return @p true, gdy pomiar się powiódł, @p false w przeciwnym przypadku.
+ */
+static bool run_script(const struct options *o, double *times) {
+    struct config c;
+    uint64_t lines = 0;
+    for (unsigned i = 0; i < o->reps; i++) {
+        double elapsed = execute_script(o->script, &c, &lines);
+        if (elapsed < 0)
+            return false;
+        times[i] = elapsed / (double)lines;
+    }
+
+    print_result("batch_script", &c, lines, o, times);
+    return true;
+}
+
+/**
+ * @brief Wypisuje opis parametrów programu.
+ * @param[in] name - nazwa programu.
+ */
+static void usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [-r SEED] [-n SCALE] [-k REPS] [-f text|json] "
+            "[-b NAME] [-i SCRIPT]\n", name);
+}
+
+/**
+ * @brief Funkcja główna.
+ * Wczytuje parametry, wykonuje wybrane pomiary i wypisuje ich wyniki.
+ * @param[in] argc - liczba parametrów programu.
+ * @param[in] argv - parametry programu.
+ * @return Zero, gdy wszystkie pomiary się powiodły, jeden w przypadku
+ *         błędnych parametrów lub nieudanego pomiaru.
+ */
+int main(int argc, char *argv[]) {
+    struct options o = {1, 1, BENCH_REPS, false, NULL, NULL};
+    unsigned long long value;
+    bool valid = true;
+
+    int opt;
+    while (valid && (opt = getopt(argc, argv, "r:n:k:f:b:i:")) != -1) {
+        switch (opt) {
+            case 'r':
+                valid = parse_count(optarg, UINT64_MAX, &value);
+                o.seed = value;
+                break;
+            case 'n':
+                // liczba operacji pomiaru to iloczyn mnożnika i liczby
+                // operacji podstawowej, mniejszej od 2^32
+                valid = parse_count(optarg, UINT32_MAX, &value);
+                o.scale = value;
+                break;
+            case 'k':
+                valid = parse_count(optarg, UINT_MAX, &value);
+                o.reps = (unsigned)value;
+                break;
+            case 'f':
+                o.json = strcmp(optarg, "json") == 0;
+                if (!o.json && strcmp(optarg, "text") != 0) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'b': o.filter = optarg; break;
+            case 'i': o.script = optarg; break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (!valid || o.scale == 0 || o.reps == 0 || optind != argc) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    double *times = malloc(o.reps * sizeof(double));
+    if (times == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    if (!o.json) {
+        printf("%-24s %10s %8s %8s %10s %12s %12s %10s\n", "bench", "size",
+               "players", "areas", "ops", "best_ns/op", "median_ns/op",
+               "Mops/s");
+    }
+
+    bool ok = true;
+    if (o.script != NULL && !run_script(&o, times)) {
+        fprintf(stderr, "%s: cannot execute the script\n", o.script);
+        ok = false;
+    }
+    for (size_t i = 0; o.script == NULL &&
+                       i < sizeof(benches) / sizeof(benches[0]); i++) {
+        const struct bench *b = &benches[i];
+        if (o.filter != NULL && strstr(b->name, o.filter) == NULL)
+            continue;
+        if (!run_bench(b, &o, times)) {
+            fprintf(stderr, "%s: benchmark failed\n", b->name);
+            ok = false;
+        }
+    }
+
+    free(times);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,352 @@
+/**
+ * @file
+ * Program generujący skrypty trybu wsadowego do testów wydajności.
+ * Wypisuje linię @p B i zadaną liczbę poleceń wylosowanych na podstawie
+ * ziarna, w proporcjach podanych w parametrach. Generator rozgrywa
+ * wypisywane ruchy na własnej kopii gry, więc ruchy trafiają zwykle w wolne
+ * pola, a złote ruchy w pola innych graczy, tak jak w prawdziwej rozgrywce.
+ * W trybie złośliwym wypisuje zamiast tego rozgrywkę, w której sprawdzanie
+ * złotych ruchów przegląda za każdym razem największy możliwy obszar.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include "gamma.h"
+#include "options.h"
+#include "splitmix.h"
+
+/**
+ * Liczba rodzajów poleceń, których udział można zadać opcją @p -m.
+ */
+#define GEN_COMMANDS 5
+
+/**
+ * Największa odległość w każdej osi pola ruchu skupionego od ostatniego
+ * pola zajętego przez gracza.
+ */
+#define GEN_CLUSTER_RADIUS 2
+
+/**
+ * Liczba prób wylosowania pola innego gracza dla złotego ruchu.
+ */
+#define GEN_GOLDEN_TRIES 16
+
+/**
+ * Znaki poleceń, których udział można zadać opcją @p -m.
+ */
+static const char gen_commands[GEN_COMMANDS] = {'m', 'b', 'f', 'q', 'p'};
+
+/**
+ * Struktura opisująca parametry generowanego skryptu.
+ */
+struct gen {
+    uint32_t width;///< szerokość planszy.
+    uint32_t height;///< wysokość planszy.
+    uint32_t players;///< liczba graczy.
+    uint32_t areas;///< limit obszarów.
+    uint64_t commands;///< liczba poleceń po linii @p B.
+    uint64_t seed;///< stan generatora liczb losowych.
+    uint32_t weights[GEN_COMMANDS];///< udziały kolejnych poleceń.
+    uint32_t golden;///< procent ruchów, które są złotymi ruchami.
+    uint32_t cluster;///< procent ruchów obok ostatniego pola gracza.
+    bool adversarial;///< czy generować rozgrywkę złośliwą.
+};
+
+/**
+ * @brief Losuje współrzędną odległą o co najwyżej @p GEN_CLUSTER_RADIUS od
+ *        współrzędnej @p center.
+ * @param[in, out] state - stan generatora.
+ * @param[in] center - współrzędna środka.
+ * @param[in] size - rozmiar planszy w danej osi.
+ * @return Współrzędna mniejsza od @p size.
+ */
+static uint32_t random_near(uint64_t *state, uint32_t center, uint32_t size) {
+    uint32_t low = center > GEN_CLUSTER_RADIUS ? center - GEN_CLUSTER_RADIUS
+                                               : 0;
+    uint32_t high = size - 1 - center > GEN_CLUSTER_RADIUS
+                    ? center + GEN_CLUSTER_RADIUS : size - 1;
+    return low + splitmix64_below(state, high - low + 1);
+}
+
+/**
+ * @brief Losuje pole ruchu gracza: z prawdopodobieństwem zadanym opcją
+ *        @p -c obok ostatniego pola zajętego przez gracza, a w przeciwnym
+ *        przypadku dowolne.
+ * @param[in, out] gen - parametry skryptu.
+ * @param[in] last - ostatnie pole zajęte przez gracza (x, y) lub
+ *                   (UINT32_MAX, UINT32_MAX), gdy gracz nie zajął pola.
+ * @param[out] x - pierwsza współrzędna pola.
+ * @param[out] y - druga współrzędna pola.
+ */
+static void random_field(struct gen *gen, const uint32_t *last, uint32_t *x,
+                         uint32_t *y) {
+    if (last[0] != UINT32_MAX && splitmix64_below(&gen->seed, 100) < gen->cluster) {
+        *x = random_near(&gen->seed, last[0], gen->width);
+        *y = random_near(&gen->seed, last[1], gen->height);
+    }
+    else {
+        *x = splitmix64_below(&gen->seed, gen->width);
+        *y = splitmix64_below(&gen->seed, gen->height);
+    }
+}
+
+/**
+ * @brief Wypisuje skrypt z poleceniami losowanymi w zadanych proporcjach.
+ * Ruchy i złote ruchy są wykonywane na kopii gry, by kolejne ruchy
+ * uwzględniały stan planszy: pole złotego ruchu jest losowane spośród pól
+ * zajętych przez innych graczy.
+ * @param[in, out] gen - parametry skryptu.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan kopii gry.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool generate_random(struct gen *gen, gamma_t *g) {
+    uint32_t *last = malloc(2 * (size_t)gen->players * sizeof(uint32_t));
+    if (last == NULL)
+        return false;
+    for (uint32_t i = 0; i < 2 * gen->players; i++)
+        last[i] = UINT32_MAX;
+
+    uint32_t total = 0;
+    for (int i = 0; i < GEN_COMMANDS; i++)
+        total += gen->weights[i];
+
+    for (uint64_t i = 0; i < gen->commands; i++) {
+        uint32_t pick = splitmix64_below(&gen->seed, total);
+        int kind = 0;
+        while (pick >= gen->weights[kind])
+            pick -= gen->weights[kind++];
+
+        uint32_t p = splitmix64_below(&gen->seed, gen->players) + 1;
+        uint32_t *player_last = &last[2 * (p - 1)];
+        char name = gen_commands[kind];
+        if (name == 'm' && splitmix64_below(&gen->seed, 100) < gen->golden) {
+            uint32_t x, y;
+            int tries = 0;
+            do {
+                random_field(gen, player_last, &x, &y);
+            } while ((g->board[y][x] == 0 || g->board[y][x] == p) &&
+                     ++tries < GEN_GOLDEN_TRIES);
+            printf("g %" PRIu32 " %" PRIu32 " %" PRIu32 "\n", p, x, y);
+            if (gamma_golden_move(g, p, x, y)) {
+                player_last[0] = x;
+                player_last[1] = y;
+            }
+        }
+        else if (name == 'm') {
+            uint32_t x, y;
+            random_field(gen, player_last, &x, &y);
+            printf("m %" PRIu32 " %" PRIu32 " %" PRIu32 "\n", p, x, y);
+            if (gamma_move(g, p, x, y)) {
+                player_last[0] = x;
+                player_last[1] = y;
+            }
+        }
+        else if (name == 'p') {
+            fputs("p\n", stdout);
+        }
+        else {
+            printf("%c %" PRIu32 "\n", name, p);
+        }
+    }
+
+    free(last);
+    return true;
+}
+
+/**
+ * @brief Wypisuje rozgrywkę złośliwą.
+ * Gracz 2 buduje węża zajmującego wszystkie parzyste wiersze, połączone
+ * na przemian prawym i lewym końcem, a gracz 1 zajmuje pole (1, 3). Przy
+ * limicie jednego obszaru każde pole węża sąsiadujące z graczem 1 rozcina
+ * węża, więc sprawdzenie, czy gracz 1 może wykonać złoty ruch, przegląda
+ * cały wąż dla każdego z nich. Następnie gracz 1 zajmuje kolejne pola
+ * trzeciego wiersza, a po każdym ruchu, który unieważnia zapamiętaną
+ * odpowiedź, pojawia się polecenie @p q. Gdy wiersz jest pełny, pozostałe
+ * polecenia to nieudane złote ruchy gracza 1 na pola węża, z których każdy
+ * przegląda cały wąż.
+ * @param[in, out] gen - parametry skryptu.
+ */
+static void generate_adversarial(struct gen *gen) {
+    uint32_t w = gen->width;
+    for (uint32_t y = 0; y < gen->height; y += 2) {
+        bool rightwards = (y / 2) % 2 == 0;
+        for (uint32_t i = 0; i < w; i++)
+            printf("m 2 %" PRIu32 " %" PRIu32 "\n",
+                   rightwards ? i : w - 1 - i, y);
+        if (y + 2 < gen->height)
+            printf("m 2 %" PRIu32 " %" PRIu32 "\n", rightwards ? w - 1 : 0,
+                   y + 1);
+    }
+    fputs("m 1 1 3\n", stdout);
+
+    uint32_t next = 2;
+    for (uint64_t i = 0; i < gen->commands; i++) {
+        if (next < w && i % 2 == 0) {
+            printf("m 1 %" PRIu32 " 3\n", next++);
+        }
+        else if (next < w) {
+            fputs("q 1\n", stdout);
+        }
+        else {
+            uint32_t x = 1 + splitmix64_below(&gen->seed, w - 2);
+            uint32_t y = splitmix64_below(&gen->seed, 2) == 0 ? 2 : 4;
+            printf("g 1 %" PRIu32 " %" PRIu32 "\n", x, y);
+        }
+    }
+}
+
+/**
+ * @brief Wczytuje rozmiar planszy postaci SZEROKOŚĆxWYSOKOŚĆ.
+ * @param[in] text - napis z rozmiarem.
+ * @param[out] width - szerokość.
+ * @param[out] height - wysokość.
+ * @return @p true, gdy rozmiar jest poprawny, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool parse_size(const char *text, uint32_t *width, uint32_t *height) {
+    char *end;
+    unsigned long w = strtoul(text, &end, 10);
+    if (end == text || *end != 'x' || w == 0 || w > UINT32_MAX)
+        return false;
+
+    text = end + 1;
+    unsigned long h = strtoul(text, &end, 10);
+    if (end == text || *end != '\0' || h == 0 || h > UINT32_MAX)
+        return false;
+
+    *width = (uint32_t)w;
+    *height = (uint32_t)h;
+    return true;
+}
+
+/**
+ * @brief Wczytuje udziały poleceń postaci ZNAK:LICZBA, oddzielone
+ *        przecinkami. Polecenia, których nie wymieniono, mają udział 0.
+ * @param[in] text - napis z udziałami.
+ * @param[out] weights - udziały kolejnych poleceń z @p gen_commands.
+ * @return @p true, gdy udziały są poprawne, a ich suma jest dodatnia,
+ *         @p false w przeciwnym przypadku.
+ */
+static bool parse_mix(const char *text, uint32_t *weights) {
+    memset(weights, 0, GEN_COMMANDS * sizeof(uint32_t));
+
+    uint64_t total = 0;
+    const char *c = text;
+    while (true) {
+        const char *found = memchr(gen_commands, c[0], GEN_COMMANDS);
+        if (c[0] == '\0' || found == NULL || c[1] != ':')
+            return false;
+
+        char *end;
+        unsigned long v = strtoul(c + 2, &end, 10);
+        if (end == c + 2 || v > UINT16_MAX || (*end != ',' && *end != '\0'))
+            return false;
+        weights[found - gen_commands] = (uint32_t)v;
+        total += v;
+
+        if (*end == '\0')
+            break;
+        c = end + 1;
+    }
+
+    return total > 0;
+}
+
+/**
+ * @brief Wypisuje opis parametrów programu.
+ * @param[in] name - nazwa programu.
+ */
+static void usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [-s WxH] [-p PLAYERS] [-a AREAS] [-n COMMANDS] "
+            "[-r SEED] [-m m:W,b:W,f:W,q:W,p:W] [-g PERCENT] [-c PERCENT] "
+            "[-A]\n", name);
+}
+
+/**
+ * @brief Funkcja główna.
+ * Wczytuje parametry i wypisuje skrypt na standardowe wyjście.
+ * @param[in] argc - liczba parametrów programu.
+ * @param[in] argv - parametry programu.
+ * @return Zero, gdy skrypt został wypisany, jeden w przypadku błędnych
+ *         parametrów lub braku pamięci.
+ */
+int main(int argc, char *argv[]) {
+    struct gen gen = {100, 100, 4, 4, 100000, 1, {80, 5, 5, 10, 0}, 5, 0,
+                      false};
+    unsigned long long value = 0;
+    bool ok = true;
+
+    int opt;
+    while (ok && (opt = getopt(argc, argv, "s:p:a:n:r:m:g:c:A")) != -1) {
+        switch (opt) {
+            case 's': ok = parse_size(optarg, &gen.width, &gen.height); break;
+            case 'p':
+                ok = parse_count(optarg, UINT32_MAX, &value);
+                gen.players = (uint32_t)value;
+                break;
+            case 'a':
+                ok = parse_count(optarg, UINT32_MAX, &value);
+                gen.areas = (uint32_t)value;
+                break;
+            case 'n':
+                ok = parse_count(optarg, UINT64_MAX, &value);
+                gen.commands = value;
+                break;
+            case 'r':
+                ok = parse_count(optarg, UINT64_MAX, &value);
+                gen.seed = value;
+                break;
+            case 'm': ok = parse_mix(optarg, gen.weights); break;
+            case 'g':
+                ok = parse_count(optarg, 100, &value);
+                gen.golden = (uint32_t)value;
+                break;
+            case 'c':
+                ok = parse_count(optarg, 100, &value);
+                gen.cluster = (uint32_t)value;
+                break;
+            case 'A': gen.adversarial = true; break;
+            default: ok = false; break;
+        }
+    }
+
+    if (gen.adversarial) {
+        if (gen.players < 2)
+            gen.players = 2;
+        gen.areas = 1;
+        ok = ok && gen.width >= 3 && gen.height >= 7;
+    }
+
+    gamma_t *g = NULL;
+    if (ok && optind == argc)
+        g = gamma_new(gen.width, gen.height, gen.players, gen.areas);
+    if (g == NULL) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    printf("B %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 "\n", gen.width,
+           gen.height, gen.players, gen.areas);
+    if (gen.adversarial)
+        generate_adversarial(&gen);
+    else
+        ok = generate_random(&gen, g);
+
+    gamma_delete(g);
+    if (!ok)
+        fprintf(stderr, "out of memory\n");
+    else if (fflush(stdout) != 0 || ferror(stdout))
+        ok = false;
+    return ok ? 0 : 1;
+}
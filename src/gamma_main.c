@@ -6,18 +6,135 @@
  * @date 17.05.2020
  */
 
+#define _GNU_SOURCE
+#include <limits.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "journal.h"
+#include "latency.h"
+#include "options.h"
 #include "parser.h"
 
+/**
+ * Domyślna liczba ruchów, po których dziennik jest utrwalany na dysku.
+ */
+static const unsigned long DEFAULT_SYNC_EVERY = 4096;
+
+/**
+ * Domyślna liczba ruchów, po których do dziennika zapisywany jest stan gry.
+ */
+static const unsigned long long DEFAULT_SNAPSHOT_EVERY = 1ULL << 20;
+
+/**
+ * @brief Wypisuje opis parametrów programu.
+ * @param[in] name - nazwa programu.
+ */
+static void usage(const char *name) {
+    fprintf(stderr, "usage: %s [-j THREADS] [-w DIR [-r] [-y MOVES] "
+                    "[-s MOVES]] [-t text|json] [FILE]\n", name);
+}
+
 /**
  * @brief Funkcja główna.
- * 
+ * Gdy podano ścieżkę do pliku, wejście jest czytane z niego zamiast ze
+ * standardowego wejścia. Opcja @p -j podaje liczbę wątków, na których
+ * rozgrywane są kolejne sesje trybu wsadowego. Opcja @p -w podaje katalog
+ * dziennika ruchów trybu wsadowego (journal.h), @p -r odtwarza z niego grę
+ * przed wczytaniem wejścia, a @p -y i @p -s podają, co ile ruchów dziennik
+ * jest utrwalany na dysku i co ile zapisywany jest w nim stan gry (0
+ * wyłącza utrwalanie lub zapis stanu). Opcja @p -t włącza pomiary czasu
+ * poleceń trybu wsadowego (latency.h), których podsumowanie w podanym
+ * formacie jest drukowane na standardowe wyjście błędów na końcu działania
+ * programu i po otrzymaniu sygnału @p SIGUSR1.
+ * @param[in] argc - liczba argumentów programu.
+ * @param[in] argv - argumenty programu.
  * @return Zero w przypadku, gdy program nie zakończył swojego działania
  *         wcześniej na skutek problemów lub jeden, gdy w czasie działania
  *         programu doszło do komplikacji.
  */
-int main() {
-    if (read_initial_line() == false)
+int main(int argc, char *argv[]) {
+    unsigned long long workers = 1;
+    const char *journal_dir = NULL;
+    bool recover = false;
+    unsigned long long sync_every = DEFAULT_SYNC_EVERY;
+    unsigned long long snapshot_every = DEFAULT_SNAPSHOT_EVERY;
+    bool journal_options = false;
+    bool timing = false;
+    enum latency_format format = LATENCY_TEXT;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "j:w:ry:s:t:")) != -1) {
+        switch (opt) {
+            case 'j':
+                if (!parse_count(optarg, UINT16_MAX, &workers) ||
+                    workers == 0) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'w':
+                journal_dir = optarg;
+                break;
+            case 'r':
+                recover = true;
+                journal_options = true;
+                break;
+            case 'y':
+                if (!parse_count(optarg, UINT_MAX, &sync_every)) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                journal_options = true;
+                break;
+            case 's':
+                if (!parse_count(optarg, UINT64_MAX, &snapshot_every)) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                journal_options = true;
+                break;
+            case 't':
+                if (strcmp(optarg, "text") != 0 &&
+                    strcmp(optarg, "json") != 0) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                format = optarg[0] == 'j' ? LATENCY_JSON : LATENCY_TEXT;
+                timing = true;
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    // sesje rozgrywane równolegle nie mają wspólnej kolejności ruchów
+    if (argc - optind > 1 || (journal_dir == NULL && journal_options) ||
+        (journal_dir != NULL && workers > 1)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // sygnał SIGUSR1 trzeba zablokować przed uruchomieniem innych wątków
+    if (timing && !latency_start(format)) {
+        fprintf(stderr, "cannot start timing thread\n");
         return 1;
-    return 0;
+    }
+
+    struct journal journal;
+    if (journal_dir != NULL &&
+        !journal_open(&journal, journal_dir, (unsigned)sync_every,
+                      snapshot_every, recover))
+        return 1;
+
+    const char *path = optind < argc ? argv[optind] : NULL;
+    bool success = read_initial_line(path, (unsigned)workers,
+                                     journal_dir != NULL ? &journal : NULL);
+    if (journal_dir != NULL)
+        journal_close(&journal);
+    latency_report();
+    return success ? 0 : 1;
 }
\ No newline at end of file
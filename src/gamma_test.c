@@ -6,12 +6,34 @@
  * 
  */
 
+// testy korzystają z assert, więc nie mogą być wyłączone w wersji Release
+#undef NDEBUG
+
+#define _POSIX_C_SOURCE 200809L
 #include <stdint.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <errno.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <string.h>
 #include "gamma.h"
+#include "snapshot.h"
+
+/**
+ * @brief Funkcja śledząca, zliczająca początki i końce wywołań silnika.
+ * @param[in, out] arg - tablica liczników, dwa na każde wywołanie.
+ * @param[in] g - gra, której dotyczy wywołanie.
+ * @param[in] call - wywołana funkcja.
+ * @param[in] end - czy jest to koniec wywołania.
+ */
+static void count_calls(void *arg, gamma_t *g, enum gamma_call call,
+                        bool end) {
+    unsigned *calls = arg;
 
+    (void)g;
+    calls[2 * call + end]++;
+}
 
 /**
  * @brief Główna funkcja programu.
@@ -25,6 +47,230 @@ int main() {
 gamma_t *test = gamma_new(20, 20, 2, 2);
 gamma_delete(test);
 
+gamma_t *g = gamma_new(3, 3, 2, 1);
+assert(gamma_move(g, 1, 0, 0));
+assert(!gamma_move(g, 1, 2, 2));
+gamma_reset(g);
+assert(gamma_busy_fields(g, 1) == 0);
+assert(gamma_move(g, 1, 2, 2));
+assert(gamma_golden_move(g, 2, 2, 2));
+gamma_delete(g);
+
+gamma_area_t areas[4];
+g = gamma_new(5, 5, 2, 3);
+assert(gamma_move(g, 1, 0, 0));
+assert(gamma_move(g, 1, 2, 0));
+assert(gamma_player_areas(g, 1, areas, 4) == 2);
+assert(gamma_move(g, 1, 1, 0));
+assert(gamma_player_areas(g, 1, areas, 4) == 1);
+assert(areas[0].size == 3 && areas[0].max_x == 2 && areas[0].max_y == 0);
+assert(gamma_golden_move(g, 2, 1, 0));
+assert(gamma_player_areas(g, 1, areas, 4) == 2);
+assert(areas[0].size == 1 && areas[1].size == 1);
+gamma_delete(g);
+
+// część, która nie została przejrzana do końca, dostaje dokładny prostokąt
+g = gamma_new(5, 1, 2, 2);
+for (uint32_t x = 0; x < 4; x++)
+    assert(gamma_move(g, 1, x, 0));
+assert(gamma_move(g, 2, 4, 0));
+assert(gamma_golden_move(g, 2, 1, 0));
+assert(gamma_player_areas(g, 1, areas, 4) == 2);
+for (int i = 0; i < 2; i++) {
+    assert(areas[i].size == 1 ? areas[i].min_x == 0 && areas[i].max_x == 0
+                              : areas[i].min_x == 2 && areas[i].max_x == 3);
+}
+gamma_delete(g);
+
+gamma_player_stats_t stats[2];
+g = gamma_new(3, 3, 2, 1);
+assert(gamma_width(g) == 3 && gamma_height(g) == 3 && gamma_players(g) == 2);
+assert(gamma_areas_limit(g) == 1);
+assert(gamma_players(NULL) == 0);
+assert(gamma_move(g, 1, 0, 1));
+assert(gamma_move(g, 1, 1, 1));
+assert(gamma_move(g, 1, 2, 1));
+assert(gamma_move(g, 2, 1, 0));
+assert(gamma_stats_all(g, stats));
+assert(stats[0].busy == 3 && stats[0].free == 5 && stats[0].golden_possible);
+assert(stats[1].busy == 1 && stats[1].free == 2);
+assert(gamma_occupied_fields(g) == 4);
+assert(!stats[1].golden_possible && !gamma_golden_possible(g, 2));
+gamma_delete(g);
+
+uint32_t next;
+g = gamma_new(2, 1, 2, 1);
+assert(!gamma_is_over(g) && gamma_next_active_player(g, 0, &next) && next == 1);
+assert(gamma_move(g, 1, 0, 0));
+assert(gamma_next_active_player(g, 1, &next) && next == 2);
+assert(gamma_move(g, 2, 1, 0));
+assert(gamma_golden_move(g, 1, 1, 0));
+assert(gamma_next_active_player(g, 1, &next) && next == 2);
+assert(gamma_golden_move(g, 2, 0, 0));
+assert(gamma_is_over(g) && gamma_next_active_player(g, 2, &next) && next == 0);
+assert(!gamma_next_active_player(g, 3, &next));
+gamma_delete(g);
+
+g = gamma_new(3, 1, 2, 1);
+assert(gamma_move(g, 1, 0, 0));
+assert(gamma_move(g, 2, 2, 0));
+gamma_influence_t *map = gamma_influence_map(g, 2);
+assert(map != NULL);
+assert(map[0].owner == 1 && map[0].distance == 0);
+assert(map[1].owner == 0 && map[1].distance == 1);
+assert(map[2].owner == 2 && map[2].distance == 0);
+free(map);
+gamma_delete(g);
+
+g = gamma_new(2, 2, 10, 1);
+const char *view = gamma_board_view(g);
+assert(view != NULL && strcmp(view, "  .  .\n  .  .\n") == 0);
+assert(gamma_move(g, 10, 1, 1));
+assert(gamma_move(g, 3, 0, 0));
+assert(strcmp(view, "  . 10\n  3  .\n") == 0);
+char *copy = gamma_board(g);
+assert(copy != NULL && strcmp(copy, view) == 0);
+free(copy);
+gamma_reset(g);
+assert(strcmp(view, "  .  .\n  .  .\n") == 0);
+gamma_delete(g);
+
+g = gamma_new(3, 2, 2, 2);
+view = gamma_board_view(g);
+assert(gamma_move(g, 2, 2, 1));
+assert(view != NULL && strcmp(view, "..2\n...\n") == 0);
+gamma_reset(g);
+assert(strcmp(view, "...\n...\n") == 0);
+gamma_delete(g);
+
+g = gamma_new(3, 2, 12, 1);
+assert(gamma_move(g, 12, 0, 1));
+assert(gamma_move(g, 7, 2, 0));
+FILE *out = tmpfile();
+assert(out != NULL);
+assert(gamma_board_write(g, fileno(out)));
+char written[32] = {0};
+rewind(out);
+assert(fread(written, 1, sizeof(written) - 1, out) == 20);
+assert(strcmp(written, " 12  .  .\n  .  .  7\n") == 0);
+fclose(out);
+gamma_delete(g);
+
+g = gamma_new(4, 3, 3, 2);
+assert(gamma_move(g, 1, 0, 0));
+assert(gamma_move(g, 1, 1, 0));
+assert(gamma_move(g, 2, 3, 2));
+assert(gamma_move(g, 3, 2, 1));
+assert(gamma_golden_move(g, 2, 1, 0));
+assert(gamma_save(g, "gamma_test.snapshot"));
+gamma_t *loaded = gamma_load("gamma_test.snapshot");
+assert(remove("gamma_test.snapshot") == 0);
+assert(loaded != NULL);
+char *before = gamma_board(g);
+char *after = gamma_board(loaded);
+assert(strcmp(before, after) == 0);
+free(before);
+free(after);
+for (uint32_t p = 1; p <= 3; p++) {
+    assert(gamma_busy_fields(g, p) == gamma_busy_fields(loaded, p));
+    assert(gamma_free_fields(g, p) == gamma_free_fields(loaded, p));
+    assert(gamma_golden_possible(g, p) == gamma_golden_possible(loaded, p));
+    assert(gamma_player_areas(g, p, NULL, 0) ==
+           gamma_player_areas(loaded, p, NULL, 0));
+}
+uint32_t loaded_next;
+assert(gamma_next_active_player(g, 1, &next));
+assert(gamma_next_active_player(loaded, 1, &loaded_next) && next == loaded_next);
+assert(!gamma_is_over(loaded));
+assert(!gamma_golden_possible(loaded, 2));
+assert(gamma_move(loaded, 1, 0, 2));
+assert(!gamma_move(loaded, 1, 2, 2));
+gamma_delete(loaded);
+gamma_delete(g);
+assert(gamma_load("gamma_test.snapshot") == NULL);
+
+// plik z planszą przekraczającą limit obszarów jest odrzucany
+g = gamma_new(3, 1, 1, 2);
+assert(gamma_move(g, 1, 0, 0));
+assert(gamma_move(g, 1, 2, 0));
+assert(gamma_save(g, "gamma_test.snapshot"));
+gamma_delete(g);
+FILE *crafted = fopen("gamma_test.snapshot", "r+b");
+assert(crafted != NULL);
+uint32_t low_limit = 1;
+assert(fseek(crafted, offsetof(struct snapshot_header, areas_limit),
+             SEEK_SET) == 0);
+assert(fwrite(&low_limit, sizeof(low_limit), 1, crafted) == 1);
+fclose(crafted);
+errno = 0;
+assert(gamma_load("gamma_test.snapshot") == NULL && errno == EINVAL);
+assert(remove("gamma_test.snapshot") == 0);
+
+g = gamma_new(130, 2, 2, 2);
+assert(gamma_move(g, 1, 3, 1));
+assert(gamma_move(g, 2, 129, 1));
+uint32_t next_x = 0, next_owner = 0;
+assert(gamma_next_busy(g, 1, &next_x, &next_owner));
+assert(next_x == 3 && next_owner == 1);
+next_x++;
+assert(gamma_next_busy(g, 1, &next_x, &next_owner));
+assert(next_x == 129 && next_owner == 2);
+next_x = 0;
+assert(!gamma_next_busy(g, 0, &next_x, &next_owner));
+gamma_delete(g);
+
+g = gamma_new(3, 3, 2, 3);
+assert(gamma_move(g, 1, 0, 0));
+assert(gamma_track_changes(g, true));
+assert(gamma_changed_fields(g) == 1);
+gamma_clear_changes(g);
+assert(gamma_move(g, 2, 1, 0));
+assert(gamma_golden_move(g, 1, 1, 0));
+assert(gamma_changed_fields(g) == 1);
+next_x = 0;
+assert(gamma_next_changed(g, 0, &next_x, &next_owner));
+assert(next_x == 1 && next_owner == 1);
+next_x++;
+assert(!gamma_next_changed(g, 0, &next_x, &next_owner));
+gamma_reset(g);
+assert(gamma_changed_fields(g) == 2);
+gamma_delete(g);
+
+g = gamma_new(3, 3, 3, 1);
+assert(gamma_move(g, 2, 1, 1));
+assert(gamma_move(g, 1, 1, 0));
+assert(gamma_golden_possible(g, 2));
+assert(gamma_move(g, 3, 2, 2));
+assert(gamma_golden_possible(g, 2));
+assert(gamma_move(g, 1, 0, 0));
+assert(gamma_move(g, 1, 2, 0));
+assert(!gamma_golden_possible(g, 2));
+assert(gamma_move(g, 3, 2, 1));
+assert(gamma_golden_possible(g, 2));
+gamma_delete(g);
+
+g = gamma_new(3, 3, 2, 1);
+unsigned calls[2 * (GAMMA_CALL_BOARD + 1)] = {0};
+gamma_counters_t counters;
+if (gamma_set_trace(g, count_calls, calls)) {
+    assert(gamma_move(g, 1, 0, 0));
+    assert(gamma_move(g, 2, 1, 0));
+    assert(gamma_golden_possible(g, 2));
+    assert(gamma_golden_possible(g, 2));
+    assert(gamma_stats_all(g, stats));
+    assert(calls[2 * GAMMA_CALL_MOVE] == 2 && calls[2 * GAMMA_CALL_MOVE + 1] == 2);
+    assert(calls[2 * GAMMA_CALL_GOLDEN_POSSIBLE + 1] == 2);
+    assert(calls[2 * GAMMA_CALL_STATS_ALL] == 1);
+    assert(calls[2 * GAMMA_CALL_FREE_FIELDS] == 0);
+    assert(gamma_get_counters(g, &counters));
+    assert(counters.arrays_created == 2 && counters.golden_cache_hits >= 1);
+    assert(counters.golden_recomputes == 1);
+}
+else {
+    assert(!gamma_get_counters(g, &counters));
+}
+gamma_delete(g);
+
 return 0;
 }
 
@@ -0,0 +1,480 @@
+/**
+ * @file
+ * Program rozgrywający turnieje botów. Rozgrywa niezależne partie dla
+ * wszystkich zadanych kombinacji rozmiarów planszy, liczby graczy i limitu
+ * obszarów na puli wątków podkradających sobie zadania, a następnie wypisuje
+ * tabelę wyników botów oraz liczbę partii rozgrywanych na sekundę.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <inttypes.h>
+#include <time.h>
+#include <unistd.h>
+#include "gamma.h"
+#include "bots.h"
+#include "options.h"
+#include "splitmix.h"
+#include "tpool.h"
+
+/**
+ * Liczba struktur przechowujących stan gry, które każdy wątek trzyma
+ * w pamięci do ponownego użycia.
+ */
+#define ENGINE_POOL_SIZE 4
+
+/**
+ * Struktura opisująca parametry rozgrywanych partii.
+ */
+struct config {
+    uint32_t width;///< szerokość planszy.
+    uint32_t height;///< wysokość planszy.
+    uint32_t players;///< liczba graczy.
+    uint32_t areas;///< limit obszarów.
+};
+
+/**
+ * Struktura przechowująca wyniki jednego bota.
+ */
+struct bot_stats {
+    uint64_t games;///< liczba partii, w których bot brał udział.
+    uint64_t wins;///< liczba partii wygranych samodzielnie.
+    uint64_t draws;///< liczba partii zakończonych ex aequo na pierwszym miejscu.
+    uint64_t score;///< suma pól zajętych przez bota na koniec partii.
+};
+
+/**
+ * Struktura przechowująca gry, które wątek może wykorzystać ponownie.
+ */
+struct engine_pool {
+    gamma_t *games[ENGINE_POOL_SIZE];///< przechowywane gry.
+    unsigned next_victim;///< indeks gry, która zostanie zastąpiona jako następna.
+};
+
+/**
+ * Struktura przechowująca stan turnieju.
+ */
+struct tournament {
+    struct config *configs;///< kombinacje parametrów partii.
+    size_t n_configs;///< liczba kombinacji parametrów.
+    const bot_t **bots;///< boty biorące udział w turnieju.
+    size_t n_bots;///< liczba botów.
+    uint64_t games;///< liczba partii dla każdej kombinacji parametrów.
+    uint64_t seed;///< ziarno generatora liczb losowych.
+    struct engine_pool *pools;///< pule gier kolejnych wątków.
+    struct bot_stats *stats;///< wyniki botów, osobno dla każdego wątku.
+    atomic_bool failed;///< czy zabrakło pamięci.
+};
+
+/**
+ * @brief Miesza bity liczby (splitmix64), by uzyskać ziarno partii.
+ * @param[in] x - liczba do wymieszania.
+ * @return Wymieszana liczba, różna od zera.
+ */
+static uint64_t mix_seed(uint64_t x) {
+    x = splitmix64(&x);
+    return x == 0 ? 1 : x;
+}
+
+/**
+ * @brief Podaje grę o zadanych parametrach w stanie początkowym.
+ * Wykorzystuje ponownie grę z puli wątku, jeśli są w niej gry o takich
+ * parametrach, a w przeciwnym przypadku zastępuje jedną z nich nową grą.
+ * @param[in, out] pool - pula gier wątku.
+ * @param[in] c - parametry partii.
+ * @return Wskaźnik na grę lub NULL, gdy nie udało się zaalokować pamięci.
+ */
+static gamma_t *get_engine(struct engine_pool *pool, const struct config *c) {
+    for (unsigned i = 0; i < ENGINE_POOL_SIZE; i++) {
+        gamma_t *g = pool->games[i];
+        if (g != NULL && g->b_width == c->width && g->b_height == c->height &&
+            g->b_players == c->players && g->areas_limit == c->areas) {
+            gamma_reset(g);
+            return g;
+        }
+    }
+
+    unsigned victim = pool->next_victim;
+    pool->next_victim = (victim + 1) % ENGINE_POOL_SIZE;
+    gamma_delete(pool->games[victim]);
+    pool->games[victim] = gamma_new(c->width, c->height, c->players, c->areas);
+
+    return pool->games[victim];
+}
+
+/**
+ * @brief Rozgrywa partię o numerze @p task.
+ * Gracze wykonują ruchy po kolei, dopóki wszyscy kolejno nie spasują.
+ * Gracz o numerze @p i + 1 jest sterowany przez bota o indeksie
+ * (numer partii + @p i) modulo liczba botów.
+ * @param[in, out] arg - wskaźnik na strukturę przechowującą stan turnieju.
+ * @param[in] task - numer partii.
+ * @param[in] worker - numer wątku.
+ */
+static void play_game(void *arg, uint64_t task, unsigned worker) {
+    struct tournament *t = arg;
+    const struct config *c = &t->configs[task / t->games];
+    uint64_t game = task % t->games;
+    uint64_t seed = mix_seed(t->seed ^ mix_seed(task));
+    struct bot_stats *stats = &t->stats[worker * t->n_bots];
+
+    gamma_t *g = get_engine(&t->pools[worker], c);
+    if (g == NULL) {
+        atomic_store(&t->failed, true);
+        return;
+    }
+
+    uint32_t idle = 0;
+    uint32_t player = 1;
+    while (idle < c->players) {
+        const bot_t *bot = t->bots[(game + player - 1) % t->n_bots];
+        if (bot->play(g, player, &seed))
+            idle = 0;
+        else
+            idle++;
+        player = player % c->players + 1;
+    }
+
+    uint64_t best = 0;
+    uint32_t winners = 0;
+    for (uint32_t p = 1; p <= c->players; p++) {
+        uint64_t score = gamma_busy_fields(g, p);
+        struct bot_stats *s = &stats[(game + p - 1) % t->n_bots];
+
+        s->games++;
+        s->score += score;
+        if (score > best) {
+            best = score;
+            winners = 1;
+        }
+        else if (score == best) {
+            winners++;
+        }
+    }
+
+    for (uint32_t p = 1; p <= c->players; p++) {
+        if (gamma_busy_fields(g, p) == best) {
+            struct bot_stats *s = &stats[(game + p - 1) % t->n_bots];
+            if (winners == 1)
+                s->wins++;
+            else
+                s->draws++;
+        }
+    }
+}
+
+/**
+ * @brief Wczytuje listę liczb dodatnich oddzielonych przecinkami.
+ * @param[in] text - napis z listą.
+ * @param[out] values - wskaźnik, pod który trafi zaalokowana tablica liczb.
+ * @param[out] n - liczba wczytanych liczb.
+ * @return @p true, gdy lista jest poprawna, @p false w przeciwnym przypadku.
+ */
+static bool parse_list(const char *text, uint32_t **values, size_t *n) {
+    size_t cap = 1;
+    for (const char *c = text; *c != '\0'; c++) {
+        if (*c == ',')
+            cap++;
+    }
+
+    *values = malloc(cap * sizeof(uint32_t));
+    if (*values == NULL)
+        return false;
+
+    *n = 0;
+    const char *c = text;
+    while (*n < cap) {
+        char *end;
+        unsigned long v = strtoul(c, &end, 10);
+        if (end == c || v == 0 || v > UINT32_MAX ||
+            (*end != ',' && *end != '\0')) {
+            free(*values);
+            return false;
+        }
+        (*values)[(*n)++] = (uint32_t)v;
+        c = end + 1;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Wczytuje listę rozmiarów planszy postaci SZEROKOŚĆxWYSOKOŚĆ,
+ *        oddzielonych przecinkami.
+ * @param[in] text - napis z listą.
+ * @param[out] widths - wskaźnik, pod który trafi tablica szerokości.
+ * @param[out] heights - wskaźnik, pod który trafi tablica wysokości.
+ * @param[out] n - liczba wczytanych rozmiarów.
+ * @return @p true, gdy lista jest poprawna, @p false w przeciwnym przypadku.
+ */
+static bool parse_sizes(const char *text, uint32_t **widths,
+                        uint32_t **heights, size_t *n) {
+    size_t cap = 1;
+    for (const char *c = text; *c != '\0'; c++) {
+        if (*c == ',')
+            cap++;
+    }
+
+    *widths = malloc(cap * sizeof(uint32_t));
+    *heights = malloc(cap * sizeof(uint32_t));
+    if (*widths == NULL || *heights == NULL) {
+        free(*widths);
+        free(*heights);
+        return false;
+    }
+
+    *n = 0;
+    const char *c = text;
+    while (*n < cap) {
+        char *end;
+        unsigned long w = strtoul(c, &end, 10);
+        bool ok = end != c && *end == 'x' && w > 0 && w <= UINT32_MAX;
+        unsigned long h = 0;
+        if (ok) {
+            c = end + 1;
+            h = strtoul(c, &end, 10);
+            ok = end != c && h > 0 && h <= UINT32_MAX &&
+                 (*end == ',' || *end == '\0');
+        }
+        if (!ok) {
+            free(*widths);
+            free(*heights);
+            return false;
+        }
+        (*widths)[*n] = (uint32_t)w;
+        (*heights)[*n] = (uint32_t)h;
+        (*n)++;
+        c = end + 1;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Wczytuje listę nazw botów oddzielonych przecinkami.
+ * @param[in] text - napis z listą.
+ * @param[out] bots - wskaźnik, pod który trafi tablica botów.
+ * @param[out] n - liczba wczytanych botów.
+ * @return @p true, gdy lista jest poprawna, @p false w przeciwnym przypadku.
+ */
+static bool parse_bots(const char *text, const bot_t ***bots, size_t *n) {
+    char *copy = strdup(text);
+    size_t cap = 1;
+    for (const char *c = text; *c != '\0'; c++) {
+        if (*c == ',')
+            cap++;
+    }
+
+    *bots = malloc(cap * sizeof(bot_t *));
+    if (copy == NULL || *bots == NULL) {
+        free(copy);
+        free(*bots);
+        return false;
+    }
+
+    *n = 0;
+    char *save;
+    for (char *name = strtok_r(copy, ",", &save); name != NULL;
+         name = strtok_r(NULL, ",", &save)) {
+        const bot_t *bot = find_bot(name);
+        if (bot == NULL) {
+            fprintf(stderr, "unknown bot: %s (available: %s)\n", name,
+                    bot_names());
+            free(copy);
+            free(*bots);
+            return false;
+        }
+        (*bots)[(*n)++] = bot;
+    }
+
+    free(copy);
+    return *n > 0;
+}
+
+/**
+ * @brief Wypisuje opis parametrów programu.
+ * @param[in] name - nazwa programu.
+ */
+static void usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [-s WxH,...] [-p PLAYERS,...] [-a AREAS,...] "
+            "[-b BOT,...] [-n GAMES] [-j THREADS] [-r SEED]\n"
+            "  bots: %s\n", name, bot_names());
+}
+
+/**
+ * @brief Tworzy wszystkie kombinacje parametrów partii.
+ * @param[in, out] t - wskaźnik na strukturę przechowującą stan turnieju.
+ * @param[in] sizes - tekstowa lista rozmiarów planszy.
+ * @param[in] players - tekstowa lista liczb graczy.
+ * @param[in] areas - tekstowa lista limitów obszarów.
+ * @return @p true, gdy listy są poprawne, @p false w przeciwnym przypadku.
+ */
+static bool make_configs(struct tournament *t, const char *sizes,
+                         const char *players, const char *areas) {
+    uint32_t *widths = NULL, *heights = NULL, *ps = NULL, *as = NULL;
+    size_t n_sizes = 0, n_ps = 0, n_as = 0;
+    bool ok = parse_sizes(sizes, &widths, &heights, &n_sizes);
+
+    if (ok)
+        ok = parse_list(players, &ps, &n_ps);
+    if (ok)
+        ok = parse_list(areas, &as, &n_as);
+    if (ok) {
+        t->n_configs = n_sizes * n_ps * n_as;
+        t->configs = malloc(t->n_configs * sizeof(struct config));
+        ok = t->configs != NULL;
+    }
+    if (ok) {
+        size_t k = 0;
+        for (size_t i = 0; i < n_sizes; i++)
+            for (size_t j = 0; j < n_ps; j++)
+                for (size_t l = 0; l < n_as; l++) {
+                    struct config c = {widths[i], heights[i], ps[j], as[l]};
+                    t->configs[k++] = c;
+                }
+    }
+
+    free(widths);
+    free(heights);
+    free(ps);
+    free(as);
+    return ok;
+}
+
+/**
+ * @brief Wypisuje zsumowane wyniki botów.
+ * @param[in] t - wskaźnik na strukturę przechowującą stan turnieju.
+ * @param[in] workers - liczba wątków.
+ * @param[in] seconds - czas trwania turnieju w sekundach.
+ */
+static void print_results(struct tournament *t, unsigned workers,
+                          double seconds) {
+    uint64_t total = t->games * t->n_configs;
+
+    printf("games %" PRIu64 " threads %u time %.3f s throughput %.1f games/s\n",
+           total, workers, seconds, seconds > 0 ? total / seconds : 0.0);
+    printf("%-10s %12s %12s %12s %12s\n", "bot", "games", "wins", "draws",
+           "avg_score");
+
+    for (size_t b = 0; b < t->n_bots; b++) {
+        struct bot_stats sum = {0, 0, 0, 0};
+        for (unsigned w = 0; w < workers; w++) {
+            struct bot_stats *s = &t->stats[w * t->n_bots + b];
+            sum.games += s->games;
+            sum.wins += s->wins;
+            sum.draws += s->draws;
+            sum.score += s->score;
+        }
+        printf("%-10s %12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %12.2f\n",
+               t->bots[b]->name, sum.games, sum.wins, sum.draws,
+               sum.games > 0 ? (double)sum.score / sum.games : 0.0);
+    }
+}
+
+/**
+ * @brief Funkcja główna.
+ * Wczytuje parametry turnieju, rozgrywa go i wypisuje wyniki.
+ * @param[in] argc - liczba parametrów programu.
+ * @param[in] argv - parametry programu.
+ * @return Zero, gdy turniej został rozegrany, jeden w przypadku błędnych
+ *         parametrów lub braku pamięci.
+ */
+int main(int argc, char *argv[]) {
+    const char *sizes = "10x10,20x20";
+    const char *players = "2,4";
+    const char *areas = "2,4";
+    const char *bots = "random,greedy,golden";
+    unsigned workers = tpool_default_workers();
+    unsigned long long value;
+    struct tournament t;
+    memset(&t, 0, sizeof(t));
+    t.games = 100;
+    t.seed = 1;
+    atomic_init(&t.failed, false);
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:p:a:b:n:j:r:")) != -1) {
+        switch (opt) {
+            case 's': sizes = optarg; break;
+            case 'p': players = optarg; break;
+            case 'a': areas = optarg; break;
+            case 'b': bots = optarg; break;
+            case 'n':
+                if (!parse_count(optarg, UINT64_MAX, &value)) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                t.games = value;
+                break;
+            case 'j':
+                if (!parse_count(optarg, UINT16_MAX, &value)) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                workers = (unsigned)value;
+                break;
+            case 'r':
+                if (!parse_count(optarg, UINT64_MAX, &value)) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                t.seed = value;
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    // numery partii wszystkich kombinacji parametrów muszą się zmieścić
+    // w zakresie numerów zadań puli wątków
+    if (t.games == 0 || workers == 0 ||
+        !make_configs(&t, sizes, players, areas) ||
+        t.games > UINT64_MAX / t.n_configs ||
+        !parse_bots(bots, &t.bots, &t.n_bots)) {
+        usage(argv[0]);
+        free(t.configs);
+        return 1;
+    }
+
+    t.pools = calloc(workers, sizeof(struct engine_pool));
+    t.stats = calloc((size_t)workers * t.n_bots, sizeof(struct bot_stats));
+    bool ok = t.pools != NULL && t.stats != NULL;
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (ok)
+        ok = tpool_run(workers, t.games * t.n_configs, play_game, &t);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (ok && !atomic_load(&t.failed)) {
+        double seconds = (double)(end.tv_sec - start.tv_sec) +
+                         (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+        print_results(&t, workers, seconds);
+    }
+    else {
+        ok = false;
+        fprintf(stderr, "out of memory\n");
+    }
+
+    for (unsigned w = 0; t.pools != NULL && w < workers; w++) {
+        for (unsigned i = 0; i < ENGINE_POOL_SIZE; i++) {
+            gamma_delete(t.pools[w].games[i]);
+        }
+    }
+    free(t.pools);
+    free(t.stats);
+    free(t.configs);
+    free(t.bots);
+
+    return ok ? 0 : 1;
+}
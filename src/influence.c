@@ -0,0 +1,308 @@
+/** @file
+ * Implementacja modułu liczącego mapę wpływów graczy.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "influence.h"
+
+/**
+ * Stan pola, do którego przeszukiwanie jeszcze nie dotarło.
+ */
+static const uint64_t UNVISITED = UINT64_MAX;
+
+/**
+ * Numer gracza oznaczający pole sporne w trakcie przeszukiwania.
+ */
+static const uint32_t CONTESTED = 0;
+
+/**
+ * Najmniejsza liczba pól planszy przypadająca na jeden wątek.
+ */
+static const uint64_t FIELDS_PER_WORKER = UINT64_C(1) << 14;
+
+/**
+ * Rozmiar lokalnego bufora wątku na pola następnego poziomu.
+ */
+#define LOCAL_FIELDS 1024
+
+/**
+ * Struktura przechowująca stan przeszukiwania wspólny dla wszystkich wątków.
+ */
+struct influence {
+    gamma_t *g;///< wskaźnik na strukturę przechowującą stan gry.
+    _Atomic uint64_t *fields;
+    /**<
+     * Stan pól, indeksowany numerem y * szerokość + x: odległość w starszych
+     * 32 bitach i numer najbliższego gracza w młodszych lub @p UNVISITED.
+     */
+    uint64_t *levels[2];///< numery pól bieżącego i następnego poziomu.
+    _Atomic uint64_t counts[2];///< liczby pól bieżącego i następnego poziomu.
+    unsigned workers;///< liczba wątków biorących udział w przeszukiwaniu.
+    pthread_barrier_t barrier;///< bariera kończąca kolejne etapy.
+    pthread_mutex_t lock;///< blokada chroniąca @p ready.
+    pthread_cond_t start;///< zmienna warunkowa, na której czekają wątki.
+    bool ready;///< czy utworzono już wszystkie wątki.
+    gamma_influence_t *out;///< wynikowa mapa wpływów.
+};
+
+/**
+ * Struktura przechowująca lokalny bufor wątku na pola kolejnego poziomu.
+ */
+struct level_buffer {
+    uint64_t fields[LOCAL_FIELDS];///< numery pól.
+    uint32_t n;///< liczba pól w buforze.
+};
+
+/**
+ * Struktura przekazywana nowo utworzonemu wątkowi.
+ */
+struct influence_worker {
+    struct influence *inf;///< wspólny stan przeszukiwania.
+    unsigned id;///< numer wątku.
+};
+
+/**
+ * @brief Przepisuje pola z bufora wątku na koniec listy pól poziomu @p level.
+ * @param[in, out] inf - wspólny stan przeszukiwania.
+ * @param[in, out] buf - bufor wątku.
+ * @param[in] level - numer listy, 0 lub 1.
+ */
+static void flush_level(struct influence *inf, struct level_buffer *buf,
+                        int level) {
+    if (buf->n == 0)
+        return;
+
+    uint64_t pos = atomic_fetch_add(&inf->counts[level], buf->n);
+    memcpy(inf->levels[level] + pos, buf->fields, buf->n * sizeof(uint64_t));
+    buf->n = 0;
+}
+
+/**
+ * @brief Dopisuje pole do bufora wątku, opróżniając go, gdy jest pełny.
+ * @param[in, out] inf - wspólny stan przeszukiwania.
+ * @param[in, out] buf - bufor wątku.
+ * @param[in] level - numer listy, 0 lub 1.
+ * @param[in] field - numer pola.
+ */
+static void push_level(struct influence *inf, struct level_buffer *buf,
+                       int level, uint64_t field) {
+    if (buf->n == LOCAL_FIELDS)
+        flush_level(inf, buf, level);
+    buf->fields[buf->n++] = field;
+}
+
+/**
+ * @brief Próbuje zająć pole @p field w odległości @p distance od pionka
+ *        gracza @p owner.
+ * Pole jeszcze nieodwiedzone dostaje gracza @p owner i trafia do bufora.
+ * Pole zajęte na tym samym poziomie przez innego gracza staje się sporne.
+ * @param[in, out] inf - wspólny stan przeszukiwania.
+ * @param[in, out] buf - bufor wątku.
+ * @param[in] level - numer listy następnego poziomu.
+ * @param[in] field - numer pola.
+ * @param[in] distance - odległość pola.
+ * @param[in] owner - numer gracza lub @p CONTESTED.
+ */
+static void claim(struct influence *inf, struct level_buffer *buf, int level,
+                  uint64_t field, uint32_t distance, uint32_t owner) {
+    _Atomic uint64_t *f = &inf->fields[field];
+    uint64_t seen = atomic_load_explicit(f, memory_order_relaxed);
+
+    if (seen == UNVISITED) {
+        if (atomic_compare_exchange_strong(f, &seen,
+                                           (uint64_t)distance << 32 | owner)) {
+            push_level(inf, buf, level, field);
+            return;
+        }
+    }
+
+    while (seen >> 32 == distance && (uint32_t)seen != owner &&
+           (uint32_t)seen != CONTESTED) {
+        if (atomic_compare_exchange_weak(f, &seen,
+                                         (uint64_t)distance << 32 | CONTESTED))
+            return;
+    }
+}
+
+/**
+ * @brief Podaje przedział wierszy lub pozycji listy przypadający wątkowi.
+ * @param[in] n - liczba elementów do podziału.
+ * @param[in] id - numer wątku.
+ * @param[in] workers - liczba wątków.
+ * @param[out] begin - pierwszy element przedziału.
+ * @param[out] end - element tuż za ostatnim elementem przedziału.
+ */
+static void split(uint64_t n, unsigned id, unsigned workers, uint64_t *begin,
+                  uint64_t *end) {
+    *begin = n * id / workers;
+    *end = n * (id + 1) / workers;
+}
+
+/**
+ * @brief Przeszukuje planszę razem z pozostałymi wątkami.
+ * Najpierw oznacza zajęte pola ze swoich wierszy jako poziom 0, potem
+ * rozwija swoją część każdego kolejnego poziomu, a na końcu przepisuje swoje
+ * wiersze do wynikowej mapy.
+ * @param[in] p - wskaźnik na strukturę influence_worker.
+ * @return @p NULL.
+ */
+static void *influence_worker(void *p) {
+    struct influence_worker *w = p;
+    struct influence *inf = w->inf;
+    gamma_t *g = inf->g;
+    uint64_t width = g->b_width;
+    struct level_buffer buf;
+    uint64_t begin, end;
+
+    pthread_mutex_lock(&inf->lock);
+    while (!inf->ready) {
+        pthread_cond_wait(&inf->start, &inf->lock);
+    }
+    pthread_mutex_unlock(&inf->lock);
+
+    buf.n = 0;
+    split(g->b_height, w->id, inf->workers, &begin, &end);
+    for (uint64_t y = begin; y < end; y++) {
+        for (uint64_t x = 0; x < width; x++) {
+            uint32_t owner = g->board[y][x];
+
+            if (owner == 0) {
+                atomic_init(&inf->fields[y * width + x], UNVISITED);
+            }
+            else {
+                atomic_init(&inf->fields[y * width + x], owner);
+                push_level(inf, &buf, 0, y * width + x);
+            }
+        }
+    }
+    flush_level(inf, &buf, 0);
+    pthread_barrier_wait(&inf->barrier);
+
+    for (uint32_t distance = 1;; distance++) {
+        int cur = (distance - 1) % 2, next = distance % 2;
+        uint64_t n = atomic_load(&inf->counts[cur]);
+
+        if (n == 0)
+            break;
+
+        split(n, w->id, inf->workers, &begin, &end);
+        for (uint64_t i = begin; i < end; i++) {
+            uint64_t field = inf->levels[cur][i];
+            uint32_t owner = (uint32_t)atomic_load_explicit(
+                &inf->fields[field], memory_order_relaxed);
+            uint64_t x = field % width, y = field / width;
+
+            if (x > 0)
+                claim(inf, &buf, next, field - 1, distance, owner);
+            if (x < width - 1)
+                claim(inf, &buf, next, field + 1, distance, owner);
+            if (y > 0)
+                claim(inf, &buf, next, field - width, distance, owner);
+            if (y < g->b_height - 1)
+                claim(inf, &buf, next, field + width, distance, owner);
+        }
+        flush_level(inf, &buf, next);
+
+        // wszystkie wątki odczytały już liczbę pól bieżącego poziomu
+        pthread_barrier_wait(&inf->barrier);
+        if (w->id == 0)
+            atomic_store(&inf->counts[cur], 0);
+        pthread_barrier_wait(&inf->barrier);
+    }
+
+    split(g->b_height, w->id, inf->workers, &begin, &end);
+    for (uint64_t i = begin * width; i < end * width; i++) {
+        uint64_t state = atomic_load_explicit(&inf->fields[i],
+                                              memory_order_relaxed);
+        if (state == UNVISITED) {
+            inf->out[i].owner = 0;
+            inf->out[i].distance = UINT32_MAX;
+        }
+        else {
+            inf->out[i].owner = (uint32_t)state;
+            inf->out[i].distance = (uint32_t)(state >> 32);
+        }
+    }
+
+    return NULL;
+}
+
+gamma_influence_t *influence_map(gamma_t *g, unsigned workers) {
+    uint64_t size = (uint64_t)g->b_width * g->b_height;
+    struct influence inf;
+
+    if (workers > size / FIELDS_PER_WORKER)
+        workers = (unsigned)(size / FIELDS_PER_WORKER);
+    if (workers < 1)
+        workers = 1;
+
+    inf.g = g;
+    inf.out = malloc(size * sizeof(gamma_influence_t));
+    inf.fields = malloc(size * sizeof(uint64_t));
+    inf.levels[0] = malloc(size * sizeof(uint64_t));
+    inf.levels[1] = malloc(size * sizeof(uint64_t));
+    struct influence_worker *args =
+        malloc(workers * sizeof(struct influence_worker));
+    pthread_t *threads = malloc(workers * sizeof(pthread_t));
+
+    if (inf.out == NULL || inf.fields == NULL || inf.levels[0] == NULL ||
+        inf.levels[1] == NULL || args == NULL || threads == NULL) {
+        free(inf.out);
+        free(inf.fields);
+        free(inf.levels[0]);
+        free(inf.levels[1]);
+        free(args);
+        free(threads);
+        return NULL;
+    }
+
+    atomic_init(&inf.counts[0], 0);
+    atomic_init(&inf.counts[1], 0);
+    pthread_mutex_init(&inf.lock, NULL);
+    pthread_cond_init(&inf.start, NULL);
+    inf.ready = false;
+
+    // liczba wątków jest znana dopiero po ich utworzeniu, więc czekają one
+    // na zainicjowanie bariery
+    unsigned started = 1;
+    for (unsigned i = 1; i < workers; i++) {
+        args[started].inf = &inf;
+        args[started].id = started;
+        if (pthread_create(&threads[started], NULL, influence_worker,
+                           &args[started]) == 0)
+            started++;
+    }
+
+    inf.workers = started;
+    pthread_barrier_init(&inf.barrier, NULL, started);
+    pthread_mutex_lock(&inf.lock);
+    inf.ready = true;
+    pthread_cond_broadcast(&inf.start);
+    pthread_mutex_unlock(&inf.lock);
+
+    args[0].inf = &inf;
+    args[0].id = 0;
+    influence_worker(&args[0]);
+
+    for (unsigned i = 1; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    pthread_barrier_destroy(&inf.barrier);
+    pthread_cond_destroy(&inf.start);
+    pthread_mutex_destroy(&inf.lock);
+    free(inf.fields);
+    free(inf.levels[0]);
+    free(inf.levels[1]);
+    free(args);
+    free(threads);
+
+    return inf.out;
+}
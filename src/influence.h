@@ -0,0 +1,30 @@
+/** @file
+ * Interfejs modułu liczącego mapę wpływów graczy, czyli dla każdego pola
+ * najbliższego mu gracza i odległość od jego najbliższego pionka.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#ifndef INFLUENCE_H
+#define INFLUENCE_H
+
+#include "gamma.h"
+
+/**
+ * @brief Liczy mapę wpływów graczy przeszukiwaniem wszerz, zaczynając
+ *        jednocześnie od wszystkich zajętych pól.
+ * Kolejne poziomy przeszukiwania (pola w tej samej odległości od najbliższego
+ * pionka) są przetwarzane równolegle przez @p workers wątków, które czekają
+ * na siebie po każdym poziomie. Wątki zajmują pola operacjami atomowymi.
+ * Pole, do którego w tej samej odległości dochodzą pionki różnych graczy,
+ * jest sporne.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] workers - największa liczba wątków, liczba dodatnia.
+ * @return Wskaźnik na zaalokowaną tablicę opisaną przy funkcji
+ *         gamma_influence_map(...) lub NULL, gdy nie udało się zaalokować
+ *         pamięci.
+ */
+extern gamma_influence_t *influence_map(gamma_t *g, unsigned workers);
+
+#endif /* INFLUENCE_H */
@@ -17,11 +17,6 @@
 #include "gamma.h"
 #include "interactive.h"
 
-/**
- * Numer znaku '0' w ASCII.
- */
-static const int ASCII_ZERO = 48;
-
 void clear_console() {
     printf("\033[2J");
     printf("\033[1;1H");
@@ -74,7 +69,7 @@ static unsigned int find_on_board(uint32_t x, uint32_t y, uint32_t players,
  * @param[in] width - szerokość planszy.
  * @param[in] height wysokość planszy.
  */
-static void print_board(char *p, uint32_t players, uint32_t x, uint32_t y,
+static void print_board(const char *p, uint32_t players, uint32_t x, uint32_t y,
                 uint32_t width, uint32_t height) {
     unsigned int place;
     place = find_on_board(x, y, players, height, width);
@@ -109,8 +104,8 @@ static void print_board(char *p, uint32_t players, uint32_t x, uint32_t y,
 /**
  * @brief Drukuje sformatowaną przez funkcję print_board(...) planszę oraz
  *        pasek, zawierający: napis "PLAYER", liczbę zajętych przez gracza pól,
- *        liczbę pól, które gracz może zająć oraz "G" w przypadku, gdy funkcja
- *        gamma_golden_possible(...) zwraca dla podanego gracza @p true.
+ *        liczbę pól, które gracz może zająć oraz "G" w przypadku, gdy gracz
+ *        może wykonać złoty ruch.
  * @param[in] p - wskaźnik na tablicę znaków, która przechowuje obecny stan
  *            planszy.
  * @param[in] players - liczba graczy, biorących udział w grze.
@@ -120,107 +115,24 @@ static void print_board(char *p, uint32_t players, uint32_t x, uint32_t y,
  *            funkcję print_board(...).
  * @param[in] width - szerokość planszy.
  * @param[in] height - wysokość planszy.
- * @param[in, out] g - wskaźnik na strukturę, przechowującą obecny stan gry.
+ * @param[in] stats - statystyki gracza, który wykonuje w danym momencie ruch.
  * @param[in] current_player - gracz, który wykonuje w danym momencie ruch.
  */
-static void print_all(char *p, uint32_t players, uint32_t x, uint32_t y,
-                uint32_t width, uint32_t height, gamma_t *g,
-                uint32_t current_player) {
+static void print_all(const char *p, uint32_t players, uint32_t x, uint32_t y,
+                uint32_t width, uint32_t height,
+                const gamma_player_stats_t *stats, uint32_t current_player) {
     printf("\033[1;1H");
     print_board(p, players, x, y, width, height);
     printf("\x1b[2K");
     printf("PLAYER %d %" PRIu64 " %" PRIu64, current_player,
-            gamma_busy_fields(g, current_player),
-            gamma_free_fields(g, current_player));
-    if (gamma_golden_possible(g, current_player)) {
+            stats->busy, stats->free);
+    if (stats->golden_possible) {
         printf("\033[32m");
         printf(" G");
         printf("\033[0m");
     }
 }
 
-/**
- * @brief Wywołuje funcję gamma_move(...).
- * Jeśli funkcja zwraca @p true, funkcja wstawia numer gracza na pole
- * (@p x, @p y) wewnątrz tablicy, do której wskaźnik jest przechowywany w @p p.
- * @param[in, out] g - wskaźnik na strukturę, przechowującą obecny stan gry.
- * @param[in] players - liczba graczy, biorących udział w grze.
- * @param[in] width - szerokość planszy.
- * @param[in] height - wysokość planszy.
- * @param[in] current_player - gracz, który wykonuje w danym momencie ruch.
- * @param[in] x - pierwsza współrzędna pola, na którym stoi w danym momencie
- *            kursor.
- * @param[in] y - druga współrzędna pola, na którym stoi w danym momencie
- *                kursor.
- * @param[in, out] p - wskaźnik na tablicę znaków, która przechowuje obecny
- *                     stan planszy.
- * @return @p true, gdy funkcja gamma_move(...) zawraca @p true,
- *         @p false w przeciwnym przypadku.
- */
-static bool interactive_move(gamma_t *g, uint32_t players, uint32_t width,
-                    uint32_t height, uint32_t current_player,
-                    uint32_t x, uint32_t y, char *p) {
-    bool final_ans = gamma_move(g, current_player, x, y);
-    unsigned int place = find_on_board(x, y, players, height, width);
-    unsigned int start = place - num_len(players);
-    if (final_ans == true) {
-        while (current_player > 0 ) {
-            p[place] = (char)((current_player % 10) + ASCII_ZERO);
-            current_player /= 10;
-            if (current_player > 0)
-                place--;
-        }
-        if (players > 9) {
-            while (place > start) {
-                place--;
-                p[place] = ' ';
-            }
-        }
-    }
-    return final_ans;
-}
-
-/**
- * @brief Wywołuje funcję gamma_golden_move(...).
- * Jeśli funkcja zwraca @p true, funkcja wstawia numer gracza na pole
- * (@p x, @p y) wewnątrz tablicy, do której wskaźnik jest przechowywany w @p p.
- * @param[in, out] g - wskaźnik na strukturę, przechowującą obecny stan gry.
- * @param[in] players - liczba graczy, biorących udział w grze.
- * @param[in] width - szerokość planszy.
- * @param[in] height - wysokość planszy.
- * @param[in] current_player - gracz, który wykonuje w danym momencie ruch.
- * @param[in] x - pierwsza współrzędna pola, na którym stoi w danym momencie
- *            kursor.
- * @param[in] y - druga współrzędna pola, na którym stoi w danym momencie
- *                kursor.
- * @param[in, out] p - wskaźnik na tablicę znaków, która przechowuje obecny
- *                     stan planszy.
- * @return @p true, gdy funkcja gamma_golden_move(...) zawraca @p true,
- *         @p false w przeciwnym przypadku.
- */
-static bool interactive_g_move(gamma_t *g, uint32_t players, uint32_t width,
-                        uint32_t height, uint32_t current_player,
-                        uint32_t x, uint32_t y, char *p) {
-    bool final_ans = gamma_golden_move(g, current_player, x, y);
-    unsigned int place = find_on_board(x, y, players, height, width);
-    unsigned int start = place - num_len(players);
-    if (final_ans == true) {
-        while (current_player > 0) {
-            p[place] = (char)((current_player % 10) + 48);
-            current_player /= 10;
-            if (current_player > 0)
-                place--;
-        }
-        if (players > 9) {
-            while (place > start) {
-                place--;
-                p[place] = ' ';
-            }
-        }
-    }
-    return final_ans;
-}
-
 /**
  * @brief Sprawdza, czy wczytane zostały strzałki oraz, jeśli tak, obsługuje
  *        przesunięcie kursora.
@@ -274,8 +186,9 @@ static bool check_arrows(char first, char second, char third, uint32_t *x,
  * @param[in] width - szerokość planszy.
  * @param[in] height - wysokość planszy.
  * @param[in] current_player - gracz, wykonujący w danym momencie ruch.
- * @param[in, out] p - wskaźnik na tablicę znaków, przechowującą obecny stan
- *                     planszy.
+ * @param[in] stats - statystyki gracza @p current_player.
+ * @param[in] p - wskaźnik na napis opisujący obecny stan planszy,
+ *                udostępniony przez funkcję gamma_board_view(...).
  * @param[in, out] x - wskaźnik na pierwszą współrzędną pola, na którym w danym
  *                     momencie ustawiony jest kursor.
  * @param[in, out] y - wskaźnik na drugą współrzędną pola, na którym w danym
@@ -289,7 +202,8 @@ static bool check_arrows(char first, char second, char third, uint32_t *x,
  *         problemy z pamięcią, @p false w przeciwnym przypadku.
  */
 static bool read_and_move(gamma_t *g, uint32_t players, uint32_t width,
-                    uint32_t height, uint32_t current_player, char *p,
+                    uint32_t height, uint32_t current_player,
+                    const gamma_player_stats_t *stats, const char *p,
                     uint32_t *x, uint32_t *y, bool *end_game) {
     char first = '\0';
     char second = '\0';
@@ -297,10 +211,7 @@ static bool read_and_move(gamma_t *g, uint32_t players, uint32_t width,
     bool success = true;
 
     while (third != '\4') {
-        print_all(p, players, *x, *y, width, height, g, current_player);
-        if (errno == ENOMEM) {
-            return false;
-        }
+        print_all(p, players, *x, *y, width, height, stats, current_player);
         first = second;
         second = third;
         third = getchar();
@@ -308,8 +219,7 @@ static bool read_and_move(gamma_t *g, uint32_t players, uint32_t width,
         if (check_arrows(first, second, third, x, y, width, height)) {
         }
         else if (third == '\40') {
-            success = interactive_move(g, players, width, height,
-                                        current_player, *x, *y, p);
+            success = gamma_move(g, current_player, *x, *y);
             if (success == false) {
                 if (errno == ENOMEM)
                     return false;
@@ -319,8 +229,7 @@ static bool read_and_move(gamma_t *g, uint32_t players, uint32_t width,
             }
         }
         else if (third == 'g' || third == 'G') {
-            success = interactive_g_move(g, players, width, height,
-                                        current_player, *x, *y, p);
+            success = gamma_golden_move(g, current_player, *x, *y);
             if (success == false) {
                 if (errno == ENOMEM)
                     return false;
@@ -340,53 +249,41 @@ static bool read_and_move(gamma_t *g, uint32_t players, uint32_t width,
     return true;
 }
 
-bool interactive_mode(gamma_t *g, char **words) {
+bool interactive_mode(gamma_t *g) {
     printf("\033[?25l");// ukrywa kursor
-    char *pointer_to_end;
-    uint32_t width = (uint32_t)strtoul(words[1], &pointer_to_end, 10);
-    uint32_t height = (uint32_t)strtoul(words[2], &pointer_to_end, 10);
-    uint32_t players = (uint32_t)strtoul(words[3], &pointer_to_end, 10);
+    uint32_t width = g->b_width;
+    uint32_t height = g->b_height;
+    uint32_t players = g->b_players;
     uint32_t x = 0;
     uint32_t y = height - 1;
-    char *p = gamma_board(g);
+    // napis opisujący planszę jest poprawiany przez silnik przy każdym ruchu
+    const char *p = gamma_board_view(g);
     if (p == NULL)
         return false;
-    uint32_t current_player = 1;
+    uint32_t current_player;
+    if (!gamma_next_active_player(g, 0, &current_player))
+        return false;
     bool end_game = false;
-    unsigned int players_who_play = 0;
-    print_all(p, players, x, y, width, height, g, current_player);
-
-    while (!end_game) {
-        if (current_player == 1)
-            players_who_play = 0;
+    gamma_player_stats_t stats;
 
-        if (gamma_free_fields(g, current_player) > 0 || 
-            gamma_golden_possible(g, current_player)) {
-            if (errno == ENOMEM) {
-                free(p);
-                return false;
-            }
-            players_who_play++;
-            errno = 0;
-            if (!read_and_move(g, players, width, height, current_player,
-                                p, &x, &y, &end_game)) {
-                free(p);
-                return false;
-            }
-        }
+    while (!end_game && current_player != 0) {
+        // statystyki zmieniają się tylko po wykonaniu ruchu, więc są liczone
+        // raz na turę, a nie przy każdym odświeżeniu ekranu
+        errno = 0;
+        stats.busy = gamma_busy_fields(g, current_player);
+        stats.free = gamma_free_fields(g, current_player);
+        stats.golden_possible = gamma_golden_possible(g, current_player);
         if (errno == ENOMEM) {
-            free(p);
             return false;
         }
-        if (current_player == players && players_who_play == 0) {
-            end_game = true;
-        }
-        else if (current_player == players) {
-            current_player = 1;
-        }
-        else {
-            current_player++;
+
+        if (!read_and_move(g, players, width, height, current_player,
+                            &stats, p, &x, &y, &end_game)) {
+            return false;
         }
+
+        if (!gamma_next_active_player(g, current_player, &current_player))
+            return false;
     }
     printf("\033[1;1H");
     printf("%s", p);
@@ -395,7 +292,7 @@ bool interactive_mode(gamma_t *g, char **words) {
         printf("\x1b[2K");
         printf("PLAYER %d %" PRIu64 "\n", i, gamma_busy_fields(g, i));
     }
-    free(p);
+    gamma_board_cache(g, false);
     printf("\033[?25h");// pokazuje kursor
     return true;
 }
\ No newline at end of file
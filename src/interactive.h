@@ -31,14 +31,12 @@ extern unsigned int num_len(uint32_t number);
 
 /**
  * @brief Funkcja przygotowująca terminal do wykonania ruchu oraz pobierająca
- *        parametry gry z tablicy @p words.
+ *        parametry gry ze struktury @p g.
  * 
  * @param[in, out] g - wskaźnik na strukturę, przechowującą obecny stan gry.
- * @param[in] words - tablica, zawierająca wskaźniki do kolejnych parametrów
- *                    gry, podanych na wejściu.
  * @return @p true w przypadku, gdy udało się bezproblemowo obsłużyć grę,
  *         @p false w przeciwnym przypadku.
  */
-extern bool interactive_mode(gamma_t *g, char **words);
+extern bool interactive_mode(gamma_t *g);
 
 #endif /*INTERACTIVE_H*/
\ No newline at end of file
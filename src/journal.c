@@ -0,0 +1,657 @@
+/** @file
+ * Implementacja dziennika ruchów trybu wsadowego.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "snapshot.h"
+#include "journal.h"
+
+/**
+ * Napis rozpoczynający każdy plik @p journal.
+ */
+static const char JOURNAL_MAGIC[8] = {'G', 'A', 'M', 'M', 'A', 'W', 'A', 'L'};
+
+/**
+ * Liczba zapisywana w nagłówku, pozwalająca wykryć plik utworzony na
+ * komputerze o innej kolejności bajtów.
+ */
+static const uint32_t BYTE_ORDER_MARK = UINT32_C(0x01020304);
+
+/**
+ * Nazwa pliku z rekordami ruchów.
+ */
+static const char LOG_NAME[] = "journal";
+
+/**
+ * Nazwa pliku, w którym powstaje nowy plik @p journal.
+ */
+static const char LOG_TMP_NAME[] = "journal.tmp";
+
+/**
+ * Nazwa pliku, w którym powstaje nowy plik ze stanem gry.
+ */
+static const char SNAPSHOT_TMP_NAME[] = "snapshot.tmp";
+
+/**
+ * Rozmiar bufora na nazwę pliku w katalogu dziennika.
+ */
+#define NAME_SIZE 32
+
+/**
+ * Rozmiar bufora rekordów oczekujących na zapis.
+ */
+#define JOURNAL_BUFFER_SIZE 65536
+
+/**
+ * Największa liczba bajtów liczby typu uint64_t zapisanej jako varint.
+ */
+#define VARINT_BYTES 10
+
+/**
+ * Największy rozmiar rekordu: przyrost numeru linii, numer gracza i dwa
+ * przyrosty współrzędnych.
+ */
+#define RECORD_BYTES (4 * VARINT_BYTES)
+
+/**
+ * @brief Drukuje komunikat o błędzie operacji na pliku dziennika.
+ * @param[in] j - dziennik.
+ * @param[in] name - nazwa pliku w katalogu dziennika.
+ * @param[in] message - opis błędu.
+ */
+static void report(const struct journal *j, const char *name,
+                   const char *message) {
+    fprintf(stderr, "%.*s/%s: %s\n", (int)j->dir_length, j->path, name,
+            message);
+}
+
+/**
+ * @brief Podaje pełną ścieżkę pliku w katalogu dziennika.
+ * @param[in, out] j - dziennik, w którego buforze powstaje ścieżka.
+ * @param[in] name - nazwa pliku.
+ * @return Wskaźnik na ścieżkę, ważny do następnego wywołania.
+ */
+static const char *full_path(struct journal *j, const char *name) {
+    snprintf(j->path + j->dir_length, NAME_SIZE + 1, "/%s", name);
+    return j->path;
+}
+
+/**
+ * @brief Podaje nazwę pliku ze stanem gry, od którego zaczyna się plik
+ *        @p journal o numerze @p generation.
+ * @param[out] name - bufor o rozmiarze @p NAME_SIZE.
+ * @param[in] generation - numer pliku @p journal.
+ */
+static void snapshot_name(char *name, uint64_t generation) {
+    snprintf(name, NAME_SIZE, "snapshot.%llu",
+             (unsigned long long)generation);
+}
+
+/**
+ * @brief Sprawdza nagłówek pliku @p journal.
+ * @param[in] header - nagłówek.
+ * @return @p true, gdy nagłówek jest poprawny, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool header_valid(const struct journal_header *header) {
+    return memcmp(header->magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) == 0 &&
+           header->version == JOURNAL_VERSION &&
+           header->byte_order == BYTE_ORDER_MARK &&
+           header->generation > 0 && header->snapshot <= 1;
+}
+
+/**
+ * @brief Podaje numer istniejącego pliku @p journal, by kolejne pliki
+ *        dostały większe numery, a nieaktualny plik ze stanem gry został
+ *        usunięty przy rozpoczęciu nowej gry.
+ * @param[in] j - dziennik.
+ * @return Numer pliku lub 0, gdy pliku nie ma lub jest niepoprawny.
+ */
+static uint64_t last_generation(const struct journal *j) {
+    struct journal_header header;
+    int fd = openat(j->dir_fd, LOG_NAME, O_RDONLY);
+
+    if (fd < 0)
+        return 0;
+
+    bool ok = read(fd, &header, sizeof(header)) == sizeof(header) &&
+              header_valid(&header);
+    close(fd);
+
+    return ok ? header.generation : 0;
+}
+
+bool journal_open(struct journal *j, const char *dir,
+                  unsigned sync_every, uint64_t snapshot_every,
+                  bool recover) {
+    j->dir_length = strlen(dir);
+    j->path = malloc(j->dir_length + NAME_SIZE + 1);
+    j->buffer = malloc(JOURNAL_BUFFER_SIZE);
+    j->dir_fd = -1;
+    j->fd = -1;
+    j->sync_every = sync_every;
+    j->snapshot_every = snapshot_every;
+    j->recover = recover;
+    j->generation = 0;
+    j->used = 0;
+    j->unsynced = 0;
+    j->since_snapshot = 0;
+    j->last_line = 0;
+    j->last_x = 0;
+    j->last_y = 0;
+
+    if (j->path == NULL || j->buffer == NULL) {
+        free(j->path);
+        free(j->buffer);
+        return false;
+    }
+    memcpy(j->path, dir, j->dir_length + 1);
+
+    if (mkdir(dir, 0777) != 0 && errno != EEXIST) {
+        fprintf(stderr, "%s: %s\n", dir, strerror(errno));
+        journal_close(j);
+        return false;
+    }
+    j->dir_fd = open(dir, O_RDONLY | O_DIRECTORY);
+    if (j->dir_fd < 0) {
+        fprintf(stderr, "%s: %s\n", dir, strerror(errno));
+        journal_close(j);
+        return false;
+    }
+
+    j->generation = last_generation(j);
+    return true;
+}
+
+/**
+ * @brief Zapisuje do deskryptora cały fragment pamięci, ponawiając zapis po
+ *        zapisaniu części danych lub przerwaniu sygnałem.
+ * @param[in] fd - deskryptor.
+ * @param[in] data - dane.
+ * @param[in] length - liczba bajtów.
+ * @return @p true, gdy udało się zapisać dane, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool write_all(int fd, const void *data, size_t length) {
+    const char *next = data;
+
+    while (length > 0) {
+        ssize_t written = write(fd, next, length);
+
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        next += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+/**
+ * @brief Zapisuje do pliku @p journal rekordy z bufora.
+ * @param[in, out] j - dziennik.
+ * @return @p true, gdy udało się zapisać rekordy, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool write_buffer(struct journal *j) {
+    if (j->used > 0 && !write_all(j->fd, j->buffer, j->used)) {
+        report(j, LOG_NAME, strerror(errno));
+        return false;
+    }
+    j->used = 0;
+    return true;
+}
+
+/**
+ * @brief Utrwala na dysku zmiany w katalogu dziennika, np. zmiany nazw
+ *        plików.
+ * @param[in] j - dziennik.
+ * @return @p true, gdy udało się utrwalić zmiany, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool sync_dir(const struct journal *j) {
+    if (fsync(j->dir_fd) != 0) {
+        fprintf(stderr, "%.*s: %s\n", (int)j->dir_length, j->path,
+                strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Zastępuje plik @p journal pustym plikiem o numerze
+ *        @p generation, zaczynającym się od stanu gry @p g.
+ * Nowy plik powstaje pod inną nazwą i po utrwaleniu zastępuje stary,
+ * więc w każdej chwili na dysku jest kompletny nagłówek.
+ * @param[in, out] j - dziennik.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] generation - numer nowego pliku.
+ * @param[in] base_line - numer linii, od którego liczony jest przyrost
+ *                        w pierwszym rekordzie.
+ * @param[in] snapshot - czy stan gry zapisano w pliku
+ *                       @p snapshot.generation.
+ * @return @p true, gdy udało się zastąpić plik, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool start_log(struct journal *j, gamma_t *g, uint64_t generation,
+                      unsigned long long base_line, bool snapshot) {
+    struct journal_header header;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+    header.version = JOURNAL_VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.width = gamma_width(g);
+    header.height = gamma_height(g);
+    header.players = gamma_players(g);
+    header.areas_limit = gamma_areas_limit(g);
+    header.generation = generation;
+    header.base_line = base_line;
+    header.snapshot = snapshot;
+
+    int fd = openat(j->dir_fd, LOG_TMP_NAME, O_WRONLY | O_CREAT | O_TRUNC,
+                    0666);
+    if (fd < 0) {
+        report(j, LOG_TMP_NAME, strerror(errno));
+        return false;
+    }
+    if (!write_all(fd, &header, sizeof(header)) || fdatasync(fd) != 0) {
+        report(j, LOG_TMP_NAME, strerror(errno));
+        close(fd);
+        return false;
+    }
+    if (renameat(j->dir_fd, LOG_TMP_NAME, j->dir_fd, LOG_NAME) != 0) {
+        report(j, LOG_NAME, strerror(errno));
+        close(fd);
+        return false;
+    }
+    if (!sync_dir(j)) {
+        close(fd);
+        return false;
+    }
+
+    // poprzedni plik ze stanem gry nie jest już potrzebny do odtworzenia
+    char name[NAME_SIZE];
+    snapshot_name(name, j->generation);
+    unlinkat(j->dir_fd, name, 0);
+
+    if (j->fd >= 0)
+        close(j->fd);
+    j->fd = fd;
+    j->generation = generation;
+    j->used = 0;
+    j->unsynced = 0;
+    j->since_snapshot = 0;
+    j->last_line = base_line;
+    j->last_x = 0;
+    j->last_y = 0;
+
+    return true;
+}
+
+bool journal_begin(struct journal *j, gamma_t *g,
+                   unsigned long long line_number) {
+    return start_log(j, g, j->generation + 1, line_number, false);
+}
+
+/**
+ * @brief Zapisuje stan gry do pliku @p snapshot.n i rozpoczyna od niego
+ *        nowy plik @p journal o numerze @p n.
+ * Do chwili zastąpienia pliku @p journal grę odtwarza poprzedni plik ze
+ * stanem gry i stary plik @p journal.
+ * @param[in, out] j - dziennik.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @return @p true, gdy udało się zapisać stan gry, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool take_snapshot(struct journal *j, gamma_t *g) {
+    char name[NAME_SIZE];
+    uint64_t generation = j->generation + 1;
+
+    snapshot_name(name, generation);
+    if (!snapshot_save(g, full_path(j, SNAPSHOT_TMP_NAME))) {
+        if (errno != ENOMEM)
+            report(j, SNAPSHOT_TMP_NAME, strerror(errno));
+        return false;
+    }
+
+    int fd = openat(j->dir_fd, SNAPSHOT_TMP_NAME, O_RDONLY);
+    bool ok = fd >= 0 && fsync(fd) == 0;
+    if (!ok)
+        report(j, SNAPSHOT_TMP_NAME, strerror(errno));
+    if (fd >= 0)
+        close(fd);
+    if (ok && renameat(j->dir_fd, SNAPSHOT_TMP_NAME, j->dir_fd, name) != 0) {
+        report(j, name, strerror(errno));
+        ok = false;
+    }
+
+    return ok && start_log(j, g, generation, j->last_line, true);
+}
+
+/**
+ * @brief Zapisuje liczbę jako varint.
+ * @param[out] out - bufor na co najmniej @p VARINT_BYTES bajtów.
+ * @param[in] value - liczba.
+ * @return Liczba zapisanych bajtów.
+ */
+static size_t put_varint(unsigned char *out, uint64_t value) {
+    size_t length = 0;
+
+    while (value >= 0x80) {
+        out[length++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    out[length++] = (unsigned char)value;
+    return length;
+}
+
+/**
+ * @brief Odczytuje liczbę zapisaną jako varint.
+ * @param[in, out] data - początek zapisu, przesuwany za odczytaną liczbę.
+ * @param[in] end - koniec danych.
+ * @param[out] value - odczytana liczba.
+ * @return @p true, gdy zapis jest pełny i mieści się w typie uint64_t,
+ *         @p false w przeciwnym przypadku.
+ */
+static bool get_varint(const unsigned char **data, const unsigned char *end,
+                       uint64_t *value) {
+    uint64_t result = 0;
+
+    for (unsigned shift = 0; *data < end && shift < 64; shift += 7) {
+        unsigned char byte = *(*data)++;
+
+        result |= (uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Koduje różnicę współrzędnych tak, by liczby o małej wartości
+ *        bezwzględnej miały krótki zapis (kodowanie zigzag).
+ * @param[in] from - poprzednia współrzędna.
+ * @param[in] to - nowa współrzędna.
+ * @return Zakodowana różnica.
+ */
+static uint64_t encode_delta(uint32_t from, uint32_t to) {
+    int64_t delta = (int64_t)to - from;
+
+    return delta >= 0 ? (uint64_t)delta * 2 : (uint64_t)(-delta) * 2 - 1;
+}
+
+/**
+ * @brief Odtwarza współrzędną z różnicy zakodowanej funkcją
+ *        encode_delta(...).
+ * @param[in] from - poprzednia współrzędna.
+ * @param[in] code - zakodowana różnica.
+ * @param[out] to - nowa współrzędna.
+ * @return @p true, gdy współrzędna mieści się w typie uint32_t, @p false
+ *         w przeciwnym przypadku.
+ */
+static bool decode_delta(uint32_t from, uint64_t code, uint32_t *to) {
+    if (code > (UINT64_C(1) << 33))
+        return false;
+
+    int64_t delta = code % 2 == 0 ? (int64_t)(code / 2)
+                                  : -(int64_t)((code + 1) / 2);
+    int64_t value = (int64_t)from + delta;
+
+    if (value < 0 || value > UINT32_MAX)
+        return false;
+
+    *to = (uint32_t)value;
+    return true;
+}
+
+bool journal_move(struct journal *j, gamma_t *g, bool golden,
+                  uint32_t player, uint32_t x, uint32_t y,
+                  unsigned long long line_number) {
+    unsigned char *record = j->buffer + j->used;
+
+    record += put_varint(record, line_number - j->last_line);
+    record += put_varint(record, (uint64_t)player * 2 + golden);
+    record += put_varint(record, encode_delta(j->last_x, x));
+    record += put_varint(record, encode_delta(j->last_y, y));
+    j->used = (size_t)(record - j->buffer);
+    j->last_line = line_number;
+    j->last_x = x;
+    j->last_y = y;
+    j->unsynced++;
+    j->since_snapshot++;
+
+    if (j->snapshot_every > 0 && j->since_snapshot >= j->snapshot_every)
+        return write_buffer(j) && take_snapshot(j, g);
+
+    if (j->sync_every > 0 && j->unsynced >= j->sync_every) {
+        if (!write_buffer(j))
+            return false;
+        if (fdatasync(j->fd) != 0) {
+            report(j, LOG_NAME, strerror(errno));
+            return false;
+        }
+        j->unsynced = 0;
+    }
+    else if (JOURNAL_BUFFER_SIZE - j->used < RECORD_BYTES) {
+        return write_buffer(j);
+    }
+
+    return true;
+}
+
+bool journal_finish(struct journal *j) {
+    if (j->fd < 0)
+        return true;
+
+    bool ok = write_buffer(j);
+    if (ok && j->sync_every > 0 && j->unsynced > 0 && fdatasync(j->fd) != 0) {
+        report(j, LOG_NAME, strerror(errno));
+        ok = false;
+    }
+    close(j->fd);
+    j->fd = -1;
+
+    return ok;
+}
+
+void journal_close(struct journal *j) {
+    if (j->fd >= 0)
+        close(j->fd);
+    if (j->dir_fd >= 0)
+        close(j->dir_fd);
+    free(j->path);
+    free(j->buffer);
+    j->path = NULL;
+    j->buffer = NULL;
+}
+
+/**
+ * @brief Tworzy grę, od której zaczyna się plik @p journal: wczytuje ją
+ *        z pliku ze stanem gry lub tworzy pustą.
+ * @param[in, out] j - dziennik.
+ * @param[in] header - poprawny nagłówek pliku @p journal.
+ * @return Wskaźnik na strukturę przechowującą stan gry lub NULL, gdy nie
+ *         udało się jej utworzyć.
+ */
+static gamma_t *initial_game(struct journal *j,
+                             const struct journal_header *header) {
+    if (!header->snapshot) {
+        gamma_t *g = gamma_new(header->width, header->height,
+                               header->players, header->areas_limit);
+        if (g == NULL && errno != ENOMEM)
+            report(j, LOG_NAME, "invalid journal");
+        return g;
+    }
+
+    char name[NAME_SIZE];
+    snapshot_name(name, header->generation);
+    errno = 0;
+    gamma_t *g = snapshot_load(full_path(j, name));
+    if (g == NULL) {
+        if (errno != ENOMEM)
+            report(j, name, errno != 0 ? strerror(errno) : "invalid snapshot");
+        return NULL;
+    }
+    if (gamma_width(g) != header->width ||
+        gamma_height(g) != header->height ||
+        gamma_players(g) != header->players ||
+        gamma_areas_limit(g) != header->areas_limit) {
+        report(j, name, "snapshot does not match the journal");
+        gamma_delete(g);
+        return NULL;
+    }
+    return g;
+}
+
+/**
+ * @brief Powtarza ruchy z rekordów pliku @p journal, aż do końca pliku lub
+ *        pierwszego uszkodzonego rekordu.
+ * Rekord jest uszkodzony, gdy jest niepełny, przyrost numeru linii jest
+ * zerowy lub ruch się nie udaje.
+ * @param[in, out] j - dziennik, w którym zapamiętywany jest ostatni ruch.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] data - początek rekordów.
+ * @param[in] end - koniec pliku.
+ * @param[out] valid_end - koniec ostatniego poprawnego rekordu.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią, @p false
+ *         w przeciwnym przypadku.
+ */
+static bool replay(struct journal *j, gamma_t *g, const unsigned char *data,
+                   const unsigned char *end, const unsigned char **valid_end) {
+    uint64_t line_delta, kind, dx, dy;
+    uint32_t x, y;
+
+    *valid_end = data;
+    while (get_varint(&data, end, &line_delta) &&
+           get_varint(&data, end, &kind) && get_varint(&data, end, &dx) &&
+           get_varint(&data, end, &dy) && line_delta > 0 &&
+           kind / 2 <= UINT32_MAX && decode_delta(j->last_x, dx, &x) &&
+           decode_delta(j->last_y, dy, &y)) {
+        uint32_t player = (uint32_t)(kind / 2);
+        bool moved;
+
+        errno = 0;
+        if (kind % 2 == 0)
+            moved = gamma_move(g, player, x, y);
+        else
+            moved = gamma_golden_move(g, player, x, y);
+        if (!moved)
+            return errno != ENOMEM;
+
+        *valid_end = data;
+        j->last_line += line_delta;
+        j->last_x = x;
+        j->last_y = y;
+        j->since_snapshot++;
+    }
+    return true;
+}
+
+/**
+ * @brief Odtwarza grę z odwzorowanego w pamięci pliku @p journal.
+ * @param[in, out] j - dziennik.
+ * @param[in] data - zawartość pliku.
+ * @param[in] size - rozmiar pliku.
+ * @param[out] valid_size - długość poprawnej części pliku.
+ * @return Wskaźnik na strukturę przechowującą stan gry lub NULL, gdy nie
+ *         udało się jej odtworzyć.
+ */
+static gamma_t *recover_mapped(struct journal *j, const unsigned char *data,
+                               size_t size, size_t *valid_size) {
+    struct journal_header header;
+
+    if (size < sizeof(header)) {
+        report(j, LOG_NAME, "invalid journal");
+        return NULL;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (!header_valid(&header)) {
+        report(j, LOG_NAME, "invalid journal");
+        return NULL;
+    }
+
+    gamma_t *g = initial_game(j, &header);
+    if (g == NULL)
+        return NULL;
+
+    const unsigned char *valid_end;
+    j->generation = header.generation;
+    j->last_line = header.base_line;
+    j->last_x = 0;
+    j->last_y = 0;
+    j->since_snapshot = 0;
+    if (!replay(j, g, data + sizeof(header), data + size, &valid_end)) {
+        gamma_delete(g);
+        return NULL;
+    }
+
+    *valid_size = (size_t)(valid_end - data);
+    return g;
+}
+
+bool journal_recover(struct journal *j, gamma_t **g,
+                     unsigned long long *line_number) {
+    *g = NULL;
+    int fd = openat(j->dir_fd, LOG_NAME, O_RDWR);
+    if (fd < 0) {
+        if (errno == ENOENT)
+            return true;
+        report(j, LOG_NAME, strerror(errno));
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        report(j, LOG_NAME, strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void *data = size > 0 ? mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0)
+                          : NULL;
+    if (data == MAP_FAILED) {
+        report(j, LOG_NAME, strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    size_t valid_size = 0;
+    *g = recover_mapped(j, data, size, &valid_size);
+    if (data != NULL)
+        munmap(data, size);
+
+    // uszkodzony koniec pliku zostaje zastąpiony kolejnymi rekordami
+    if (*g != NULL && (ftruncate(fd, (off_t)valid_size) != 0 ||
+                       lseek(fd, (off_t)valid_size, SEEK_SET) < 0)) {
+        report(j, LOG_NAME, strerror(errno));
+        gamma_delete(*g);
+        *g = NULL;
+    }
+    if (*g == NULL) {
+        close(fd);
+        return false;
+    }
+
+    j->fd = fd;
+    j->used = 0;
+    j->unsynced = 0;
+    *line_number = j->last_line;
+    return true;
+}
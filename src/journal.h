@@ -0,0 +1,169 @@
+/** @file
+ * Interfejs dziennika ruchów trybu wsadowego, pozwalającego odtworzyć grę
+ * po awarii programu.
+ *
+ * Dziennik to katalog z plikiem @p journal i co najwyżej jednym plikiem
+ * @p snapshot.n ze stanem gry zapisanym funkcją snapshot_save(...). Plik
+ * @p journal zaczyna się nagłówkiem (struktura journal_header), po którym
+ * następują rekordy kolejnych udanych ruchów. Rekord to cztery liczby
+ * zapisane jako varint (po 7 bitów na bajt, od najmłodszych, z najstarszym
+ * bitem bajtu oznaczającym kontynuację): przyrost numeru linii względem
+ * poprzedniego rekordu, numer gracza pomnożony przez 2 powiększony o 1 dla
+ * złotego ruchu oraz przyrosty współrzędnych @p x i @p y względem
+ * poprzedniego rekordu w kodowaniu zigzag. Co zadaną liczbę ruchów stan gry
+ * jest zapisywany do nowego pliku @p snapshot.n, a plik @p journal jest
+ * zastępowany pustym, więc odtworzenie gry wymaga powtórzenia co najwyżej
+ * tej liczby ruchów.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "gamma.h"
+
+/**
+ * Wersja formatu pliku @p journal, zwiększana przy każdej jego zmianie.
+ */
+#define JOURNAL_VERSION 1
+
+/**
+ * Struktura opisująca nagłówek pliku @p journal.
+ */
+struct journal_header {
+    char magic[8];///< napis "GAMMAWAL" bez kończącego znaku '\0'.
+    uint32_t version;///< wersja formatu, @p JOURNAL_VERSION.
+    uint32_t byte_order;///< liczba 0x01020304, pozwalająca wykryć kolejność bajtów.
+    uint32_t width;///< szerokość planszy.
+    uint32_t height;///< wysokość planszy.
+    uint32_t players;///< liczba graczy.
+    uint32_t areas_limit;///< limit obszarów.
+    uint64_t generation;
+    /**<
+     * Numer pliku, zwiększany przy każdym zastąpieniu pliku @p journal.
+     * Gdy @p snapshot jest niezerowe, stan gry sprzed pierwszego rekordu
+     * znajduje się w pliku @p snapshot.generation.
+     */
+    uint64_t base_line;
+    /**<
+     * Numer linii ostatniego ruchu zapisanego w pliku ze stanem gry lub
+     * linii rozpoczynającej grę, od którego liczony jest przyrost
+     * w pierwszym rekordzie.
+     */
+    uint32_t snapshot;///< czy gra zaczyna się od zapisanego stanu.
+    uint32_t reserved;///< zero.
+};
+
+/**
+ * Struktura przechowująca stan dziennika.
+ */
+struct journal {
+    int dir_fd;///< deskryptor katalogu dziennika.
+    char *path;///< bufor na pełną ścieżkę pliku w katalogu.
+    size_t dir_length;///< długość ścieżki katalogu.
+    int fd;///< deskryptor pliku @p journal lub -1 poza sesją.
+    unsigned sync_every;
+    /**<
+     * Liczba ruchów, po których rekordy są zapisywane i utrwalane na dysku
+     * funkcją fdatasync, lub 0, gdy dziennik nie jest utrwalany.
+     */
+    uint64_t snapshot_every;
+    /**<
+     * Liczba ruchów, po których zapisywany jest stan gry, lub 0, gdy stan
+     * nie jest zapisywany.
+     */
+    bool recover;///< czy przed wczytaniem wejścia odtworzyć grę.
+    uint64_t generation;///< numer bieżącego pliku @p journal.
+    unsigned char *buffer;///< rekordy oczekujące na zapis.
+    size_t used;///< liczba bajtów w buforze.
+    uint64_t unsynced;///< liczba ruchów od ostatniego utrwalenia.
+    uint64_t since_snapshot;///< liczba ruchów od zapisu stanu gry.
+    unsigned long long last_line;///< numer linii ostatniego ruchu.
+    uint32_t last_x;///< pierwsza współrzędna ostatniego ruchu.
+    uint32_t last_y;///< druga współrzędna ostatniego ruchu.
+};
+
+/**
+ * @brief Otwiera dziennik w katalogu @p dir, tworząc katalog, jeśli nie
+ *        istnieje.
+ * W razie niepowodzenia drukuje komunikat na standardowe wyjście błędów.
+ * @param[out] j - dziennik.
+ * @param[in] dir - ścieżka do katalogu.
+ * @param[in] sync_every - liczba ruchów między utrwaleniami lub 0.
+ * @param[in] snapshot_every - liczba ruchów między zapisami stanu gry lub 0.
+ * @param[in] recover - czy przed wczytaniem wejścia odtworzyć grę.
+ * @return @p true, gdy udało się otworzyć dziennik, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool journal_open(struct journal *j, const char *dir,
+                         unsigned sync_every, uint64_t snapshot_every,
+                         bool recover);
+
+/**
+ * @brief Odtwarza grę z dziennika: wczytuje zapisany stan gry i powtarza
+ *        ruchy zapisane po nim. Dalsze ruchy są dopisywane do dziennika.
+ * Uszkodzony koniec pliku @p journal, np. niepełny rekord, jest pomijany
+ * i obcinany. W razie niepowodzenia drukuje komunikat na standardowe wyjście
+ * błędów, chyba że zabrakło pamięci.
+ * @param[in, out] j - dziennik.
+ * @param[out] g - odtworzona gra lub NULL, gdy dziennik jest pusty.
+ * @param[out] line_number - numer linii ostatniego ruchu zapisanego
+ *                           w dzienniku lub linii rozpoczynającej grę.
+ * @return @p true, gdy udało się odtworzyć grę lub dziennik jest pusty,
+ *         @p false w przeciwnym przypadku.
+ */
+extern bool journal_recover(struct journal *j, gamma_t **g,
+                            unsigned long long *line_number);
+
+/**
+ * @brief Rozpoczyna w dzienniku nową grę, zastępując poprzednią.
+ * W razie niepowodzenia drukuje komunikat na standardowe wyjście błędów.
+ * @param[in, out] j - dziennik.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan nowej gry.
+ * @param[in] line_number - numer linii rozpoczynającej grę.
+ * @return @p true, gdy udało się zapisać dziennik, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool journal_begin(struct journal *j, gamma_t *g,
+                          unsigned long long line_number);
+
+/**
+ * @brief Dopisuje do dziennika udany ruch, a co zadaną liczbę ruchów
+ *        utrwala dziennik lub zapisuje stan gry.
+ * W razie niepowodzenia drukuje komunikat na standardowe wyjście błędów.
+ * @param[in, out] j - dziennik.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry po ruchu.
+ * @param[in] golden - czy był to złoty ruch.
+ * @param[in] player - numer gracza.
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @param[in] line_number - numer linii z ruchem.
+ * @return @p true, gdy udało się zapisać dziennik, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool journal_move(struct journal *j, gamma_t *g, bool golden,
+                         uint32_t player, uint32_t x, uint32_t y,
+                         unsigned long long line_number);
+
+/**
+ * @brief Zapisuje i utrwala oczekujące rekordy oraz zamyka plik bieżącej
+ *        gry.
+ * W razie niepowodzenia drukuje komunikat na standardowe wyjście błędów.
+ * @param[in, out] j - dziennik.
+ * @return @p true, gdy udało się zapisać dziennik, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool journal_finish(struct journal *j);
+
+/**
+ * @brief Zamyka dziennik, nie zapisując oczekujących rekordów.
+ * @param[in, out] j - dziennik.
+ */
+extern void journal_close(struct journal *j);
+
+#endif /* JOURNAL_H */
@@ -0,0 +1,375 @@
+/** @file
+ * Implementacja modułu mierzącego czas wykonywania poleceń trybu wsadowego.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <inttypes.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "latency.h"
+
+/**
+ * Mierzone polecenia, w kolejności drukowania.
+ */
+static const char COMMANDS[] = "mgbfqp";
+
+/**
+ * Liczba mierzonych poleceń.
+ */
+#define LATENCY_COMMANDS (sizeof(COMMANDS) - 1)
+
+/**
+ * Liczba bitów numeru przedziału w obrębie potęgi dwójki.
+ */
+static const unsigned SUB_BITS = 4;
+
+/**
+ * Drukowane percentyle, w dziesiątych częściach procenta.
+ */
+static const unsigned PERCENTILES[] = {500, 900, 990, 999};
+
+/**
+ * Liczba drukowanych percentyli.
+ */
+#define LATENCY_PERCENTILES (sizeof(PERCENTILES) / sizeof(PERCENTILES[0]))
+
+/**
+ * Struktura przechowująca pomiary jednego polecenia.
+ */
+struct latency_histogram {
+    atomic_uint_fast64_t buckets[LATENCY_BUCKETS];///< liczby pomiarów w przedziałach.
+    atomic_uint_fast64_t total;///< suma czasów w jednostkach zegara.
+    atomic_uint_fast64_t max;///< największy czas w jednostkach zegara.
+};
+
+/**
+ * Nazwy liczników pracy silnika, w kolejności pól struktury
+ * gamma_counters.
+ */
+static const char *const COUNTER_NAMES[] = {
+    "arrays_created", "floods", "flood_fields", "take_checks", "take_floods",
+    "golden_scanned", "golden_cache_hits", "golden_recomputes"
+};
+
+/**
+ * Liczba liczników pracy silnika.
+ */
+#define LATENCY_COUNTERS (sizeof(COUNTER_NAMES) / sizeof(COUNTER_NAMES[0]))
+
+bool latency_enabled = false;
+
+/**
+ * Sumy liczników pracy silnika zakończonych gier.
+ */
+static atomic_uint_fast64_t counters[LATENCY_COUNTERS];
+
+/**
+ * Czy do podsumowania dodano liczniki pracy silnika.
+ */
+static atomic_bool counters_added;
+
+/**
+ * Format podsumowania.
+ */
+static enum latency_format report_format;
+
+/**
+ * Pomiary kolejnych poleceń z @p COMMANDS, w jednostkach zegara
+ * zwracanego przez funkcję read_clock().
+ */
+static struct latency_histogram histograms[LATENCY_COMMANDS];
+
+/**
+ * Odczyt funkcji read_clock() w chwili włączenia pomiarów.
+ */
+static uint64_t start_ticks;
+
+/**
+ * Czas w nanosekundach w chwili włączenia pomiarów.
+ */
+static uint64_t start_ns;
+
+/**
+ * @brief Podaje bieżący czas zegara monotonicznego w nanosekundach.
+ * @return Czas w nanosekundach.
+ */
+static uint64_t monotonic_ns(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Odczytuje zegar, którym mierzone są polecenia.
+ * Na procesorach x86-64 jest to licznik cykli procesora, którego odczyt
+ * kosztuje kilka razy mniej niż clock_gettime(...), a na pozostałych zegar
+ * monotoniczny.
+ * @return Bieżący odczyt zegara.
+ */
+static uint64_t read_clock(void) {
+#if defined(__x86_64__)
+    return __builtin_ia32_rdtsc();
+#else
+    return monotonic_ns();
+#endif
+}
+
+/**
+ * @brief Podaje liczbę nanosekund przypadającą na jednostkę zegara
+ *        read_clock(), porównując oba zegary od włączenia pomiarów.
+ * @return Liczba nanosekund na jednostkę zegara.
+ */
+static long double ns_per_tick(void) {
+    uint64_t ticks_elapsed = read_clock() - start_ticks;
+    uint64_t ns_elapsed = monotonic_ns() - start_ns;
+
+    return ticks_elapsed > 0 ? (long double)ns_elapsed / ticks_elapsed : 1;
+}
+
+/**
+ * @brief Podaje numer przedziału histogramu, do którego należy czas.
+ * Czasy mniejsze od 2 * @p LATENCY_SUB_BUCKETS jednostek zegara mają osobne
+ * przedziały, a większe są zaokrąglane w dół do @p SUB_BITS + 1 najstarszych
+ * bitów.
+ * @param[in] value - czas w jednostkach zegara read_clock(): na x86-64
+ * w cyklach licznika @p TSC, a na pozostałych procesorach w nanosekundach.
+ * @return Numer przedziału.
+ */
+static unsigned bucket_of(uint64_t value) {
+    if (value < 2 * LATENCY_SUB_BUCKETS)
+        return (unsigned)value;
+
+    unsigned shift = 63 - (unsigned)__builtin_clzll(value) - SUB_BITS;
+    return shift * LATENCY_SUB_BUCKETS + (unsigned)(value >> shift);
+}
+
+/**
+ * @brief Podaje największy czas należący do przedziału histogramu.
+ * @param[in] bucket - numer przedziału.
+ * @return Czas w jednostkach zegara read_clock().
+ */
+static uint64_t bucket_max(unsigned bucket) {
+    if (bucket < 2 * LATENCY_SUB_BUCKETS)
+        return bucket;
+
+    unsigned shift = bucket / LATENCY_SUB_BUCKETS - 1;
+    uint64_t top = bucket % LATENCY_SUB_BUCKETS + LATENCY_SUB_BUCKETS;
+    return ((top + 1) << shift) - 1;
+}
+
+/**
+ * @brief Drukuje podsumowanie po każdym otrzymaniu sygnału @p SIGUSR1
+ *        (funkcja wątku obsługującego sygnał).
+ * @param[in] arg - zbiór sygnałów, na które czeka wątek.
+ * @return NULL.
+ */
+static void *report_on_signal(void *arg) {
+    const sigset_t *set = arg;
+    int sig;
+
+    while (sigwait(set, &sig) == 0)
+        latency_report();
+    return NULL;
+}
+
+bool latency_start(enum latency_format format) {
+    static sigset_t set;
+    pthread_t thread;
+
+    report_format = format;
+    start_ns = monotonic_ns();
+    start_ticks = read_clock();
+    latency_enabled = true;
+
+    sigemptyset(&set);
+    sigaddset(&set, SIGUSR1);
+    if (pthread_sigmask(SIG_BLOCK, &set, NULL) != 0 ||
+        pthread_create(&thread, NULL, report_on_signal, &set) != 0)
+        return false;
+
+    pthread_detach(thread);
+    return true;
+}
+
+uint64_t latency_begin(void) {
+    // zero oznacza wyłączone pomiary, a zegar nie cofa się do niego
+    return latency_enabled ? read_clock() - start_ticks + 1 : 0;
+}
+
+void latency_end(char command, uint64_t start) {
+    if (start == 0 || command == '\0')
+        return;
+
+    uint64_t elapsed = latency_begin() - start;
+    const char *found = strchr(COMMANDS, command);
+    if (found == NULL)
+        return;
+
+    struct latency_histogram *h = &histograms[found - COMMANDS];
+    uint_fast64_t max = atomic_load_explicit(&h->max, memory_order_relaxed);
+
+    atomic_fetch_add_explicit(&h->buckets[bucket_of(elapsed)], 1,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&h->total, elapsed, memory_order_relaxed);
+    while (elapsed > max &&
+           !atomic_compare_exchange_weak_explicit(&h->max, &max, elapsed,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed))
+        ;
+}
+
+void latency_add_game(gamma_t *g) {
+    gamma_counters_t c;
+
+    if (!latency_enabled || !gamma_get_counters(g, &c))
+        return;
+
+    // liczniki są kolejnymi polami typu uint64_t
+    _Static_assert(sizeof(c) == LATENCY_COUNTERS * sizeof(uint64_t),
+                   "COUNTER_NAMES does not match struct gamma_counters");
+    uint64_t values[LATENCY_COUNTERS];
+    memcpy(values, &c, sizeof(values));
+    for (size_t i = 0; i < LATENCY_COUNTERS; i++)
+        atomic_fetch_add_explicit(&counters[i], values[i],
+                                  memory_order_relaxed);
+    atomic_store(&counters_added, true);
+}
+
+/**
+ * @brief Liczy percentyle pomiarów jednego polecenia.
+ * Pomiary zapisywane w trakcie liczenia mogą zostać pominięte.
+ * @param[in] h - pomiary polecenia.
+ * @param[out] values - kolejne percentyle z @p PERCENTILES, w jednostkach
+ *                      zegara.
+ * @return Liczba pomiarów w histogramie.
+ */
+static uint64_t percentiles(struct latency_histogram *h, uint64_t *values) {
+    uint64_t counts[LATENCY_BUCKETS];
+    uint64_t count = 0, seen = 0;
+    size_t next = 0;
+
+    for (unsigned i = 0; i < LATENCY_BUCKETS; i++) {
+        counts[i] = atomic_load_explicit(&h->buckets[i], memory_order_relaxed);
+        count += counts[i];
+    }
+
+    for (unsigned i = 0; i < LATENCY_BUCKETS && next < LATENCY_PERCENTILES;
+         i++) {
+        seen += counts[i];
+        // percentyl to najmniejszy czas, od którego nie jest większe
+        // co najmniej tyle pomiarów
+        while (next < LATENCY_PERCENTILES &&
+               seen * 1000 >= count * PERCENTILES[next] && seen > 0)
+            values[next++] = bucket_max(i);
+    }
+    while (next < LATENCY_PERCENTILES)
+        values[next++] = 0;
+
+    return count;
+}
+
+/**
+ * @brief Zapisuje sumy liczników pracy silnika w formacie podsumowania:
+ *        linię na licznik albo pole @p counters obiektu JSON.
+ * @param[out] text - bufor.
+ * @param[in] size - rozmiar bufora, wystarczający na wszystkie liczniki.
+ * @return Liczba zapisanych znaków.
+ */
+static size_t print_counters(char *text, size_t size) {
+    size_t used = 0;
+
+    if (report_format == LATENCY_JSON)
+        used += (size_t)snprintf(text, size, ",\"counters\":{");
+
+    for (size_t i = 0; i < LATENCY_COUNTERS; i++) {
+        uint64_t value = atomic_load_explicit(&counters[i],
+                                              memory_order_relaxed);
+
+        if (report_format == LATENCY_TEXT)
+            used += (size_t)snprintf(text + used, size - used, "%-20s %12"
+                                     PRIu64 "\n", COUNTER_NAMES[i], value);
+        else
+            used += (size_t)snprintf(text + used, size - used, "%s\"%s\":%"
+                                     PRIu64, i > 0 ? "," : "",
+                                     COUNTER_NAMES[i], value);
+    }
+
+    if (report_format == LATENCY_JSON)
+        used += (size_t)snprintf(text + used, size - used, "}");
+    return used;
+}
+
+void latency_report(void) {
+    if (!latency_enabled)
+        return;
+
+    long double scale = ns_per_tick();
+    char text[2048];
+    size_t used = 0;
+    int n;
+
+    if (report_format == LATENCY_TEXT)
+        n = snprintf(text, sizeof(text), "%-7s %12s %12s %12s %12s %12s "
+                     "%12s %12s\n", "command", "count", "mean_ns", "p50_ns",
+                     "p90_ns", "p99_ns", "p99.9_ns", "max_ns");
+    else
+        n = snprintf(text, sizeof(text), "{\"unit\":\"ns\",\"commands\":{");
+    used += (size_t)n;
+
+    for (size_t c = 0; c < LATENCY_COMMANDS; c++) {
+        struct latency_histogram *h = &histograms[c];
+        uint64_t values[LATENCY_PERCENTILES];
+        uint64_t count = percentiles(h, values);
+        uint64_t total = atomic_load_explicit(&h->total, memory_order_relaxed);
+        uint64_t max = atomic_load_explicit(&h->max, memory_order_relaxed);
+        uint64_t mean = count > 0 ? (uint64_t)(total * scale / count) : 0;
+
+        for (size_t i = 0; i < LATENCY_PERCENTILES; i++) {
+            if (values[i] > max)
+                values[i] = max;
+            values[i] = (uint64_t)(values[i] * scale);
+        }
+        max = (uint64_t)(max * scale);
+
+        if (report_format == LATENCY_TEXT)
+            n = snprintf(text + used, sizeof(text) - used, "%-7c %12" PRIu64
+                         " %12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %12"
+                         PRIu64 " %12" PRIu64 " %12" PRIu64 "\n",
+                         COMMANDS[c], count, mean, values[0], values[1],
+                         values[2], values[3], max);
+        else
+            n = snprintf(text + used, sizeof(text) - used, "%s\"%c\":{"
+                         "\"count\":%" PRIu64 ",\"mean\":%" PRIu64 ","
+                         "\"p50\":%" PRIu64 ",\"p90\":%" PRIu64 ","
+                         "\"p99\":%" PRIu64 ",\"p99.9\":%" PRIu64 ","
+                         "\"max\":%" PRIu64 "}", c > 0 ? "," : "",
+                         COMMANDS[c], count, mean, values[0], values[1],
+                         values[2], values[3], max);
+        used += (size_t)n;
+    }
+
+    if (report_format == LATENCY_JSON)
+        used += (size_t)snprintf(text + used, sizeof(text) - used, "}");
+    if (atomic_load(&counters_added))
+        used += print_counters(text + used, sizeof(text) - used);
+    if (report_format == LATENCY_JSON)
+        used += (size_t)snprintf(text + used, sizeof(text) - used, "}\n");
+
+    // jeden zapis, by podsumowanie nie przeplatało się z komunikatami
+    // o błędach drukowanymi przez inne wątki
+    for (size_t done = 0; done < used;) {
+        ssize_t written = write(STDERR_FILENO, text + done, used - done);
+        if (written <= 0)
+            break;
+        done += (size_t)written;
+    }
+}
@@ -0,0 +1,98 @@
+/** @file
+ * Interfejs modułu mierzącego czas wykonywania poleceń trybu wsadowego.
+ *
+ * Dla każdego z poleceń @p m, @p g, @p b, @p f, @p q i @p p zliczane są
+ * wywołania oraz budowany jest histogram czasów. Czasy są zapisywane
+ * w jednostkach zegara, którym mierzone są polecenia: na procesorach x86-64
+ * w cyklach licznika @p TSC, a na pozostałych w nanosekundach. Na
+ * nanosekundy są zamieniane dopiero przy drukowaniu podsumowania, według
+ * tempa licznika zmierzonego od włączenia pomiarów. Przedziały histogramu
+ * rosną wykładniczo: każda potęga dwójki jest dzielona na
+ * @p LATENCY_SUB_BUCKETS równych części, więc względny błąd odczytanego czasu
+ * nie przekracza 1 / @p LATENCY_SUB_BUCKETS, a zapis pomiaru to kilka
+ * operacji na liczbach całkowitych. Liczniki są atomowe, więc pomiary mogą
+ * być zapisywane jednocześnie przez wiele wątków. W programie skompilowanym
+ * z makrem @p GAMMA_INSTRUMENT podsumowanie zawiera też sumy liczników pracy
+ * silnika (@ref gamma_get_counters) gier zakończonych przed jego wydrukowaniem.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "gamma.h"
+
+/**
+ * Liczba przedziałów histogramu, na które dzielona jest każda potęga dwójki
+ * jednostek zegara (cykli licznika @p TSC na x86-64, a nanosekund na
+ * pozostałych procesorach).
+ */
+#define LATENCY_SUB_BUCKETS 16
+
+/**
+ * Liczba przedziałów histogramu jednego polecenia, obejmujących wszystkie
+ * czasy w jednostkach zegara mieszczące się w 64 bitach.
+ */
+#define LATENCY_BUCKETS (64 * LATENCY_SUB_BUCKETS)
+
+/**
+ * Format podsumowania pomiarów.
+ */
+enum latency_format {
+    LATENCY_TEXT,///< tabela z jedną linią na polecenie.
+    LATENCY_JSON///< obiekt JSON w jednej linii.
+};
+
+/**
+ * Czy pomiary są włączone. Ustawiane tylko przez latency_start(...).
+ */
+extern bool latency_enabled;
+
+/**
+ * @brief Włącza pomiary i uruchamia wątek, który po otrzymaniu sygnału
+ *        @p SIGUSR1 drukuje podsumowanie na standardowe wyjście błędów.
+ * Sygnał @p SIGUSR1 jest blokowany w wątku wywołującym, a więc także we
+ * wszystkich wątkach uruchomionych później, dlatego funkcję należy wywołać,
+ * zanim program uruchomi inne wątki.
+ * @param[in] format - format podsumowania.
+ * @return @p true, gdy udało się uruchomić wątek, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool latency_start(enum latency_format format);
+
+/**
+ * @brief Podaje chwilę rozpoczęcia mierzonego polecenia.
+ * @return Niezerowy odczyt zegara lub 0, gdy pomiary są wyłączone.
+ */
+extern uint64_t latency_begin(void);
+
+/**
+ * @brief Zapisuje czas wykonania polecenia rozpoczętego w chwili @p start.
+ * Nie robi nic, gdy @p start jest zerem lub polecenie nie jest mierzone.
+ * @param[in] command - znak polecenia.
+ * @param[in] start - wynik funkcji latency_begin().
+ */
+extern void latency_end(char command, uint64_t start);
+
+/**
+ * @brief Dodaje do podsumowania liczniki pracy silnika zakończonej gry.
+ * Nie robi nic, gdy pomiary są wyłączone lub program skompilowano bez makra
+ * @p GAMMA_INSTRUMENT.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ */
+extern void latency_add_game(gamma_t *g);
+
+/**
+ * @brief Drukuje podsumowanie pomiarów na standardowe wyjście błędów:
+ *        liczbę wywołań, średni czas, percentyle 50, 90, 99 i 99,9 oraz
+ *        największy czas każdego polecenia, w nanosekundach.
+ * Percentyle są górnymi końcami przedziałów histogramu. Nie robi nic, gdy
+ * pomiary są wyłączone.
+ */
+extern void latency_report(void);
+
+#endif /* LATENCY_H */
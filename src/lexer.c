@@ -0,0 +1,331 @@
+/** @file
+ * Implementacja wczytywania wejścia dużymi blokami i rozkładania kolejnych
+ * linii na polecenia.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "lexer.h"
+
+/**
+ * Początkowy rozmiar bufora wejścia. Bufor rośnie tylko wtedy, gdy nie mieści
+ * się w nim jedna linia.
+ */
+static const size_t READ_BUFFER_SIZE = (size_t)1 << 20;
+
+bool reader_init(struct line_reader *r, int fd) {
+    r->fd = fd;
+    r->buffer = malloc(READ_BUFFER_SIZE);
+    r->capacity = READ_BUFFER_SIZE;
+    r->begin = 0;
+    r->end = 0;
+    r->eof = false;
+    r->mapped = false;
+    r->owns_fd = false;
+
+    return r->buffer != NULL;
+}
+
+bool reader_open(struct line_reader *r, const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+
+    if (S_ISREG(st.st_mode) && st.st_size > 0 &&
+        (uintmax_t)st.st_size <= SIZE_MAX) {
+        size_t size = (size_t)st.st_size;
+        void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            close(fd);
+            // plik jest czytany jednokrotnie, od początku do końca
+            posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+            r->fd = -1;
+            r->buffer = data;
+            r->capacity = size;
+            r->begin = 0;
+            r->end = size;
+            r->eof = true;
+            r->mapped = true;
+            r->owns_fd = false;
+            return true;
+        }
+    }
+
+    if (!reader_init(r, fd)) {
+        close(fd);
+        errno = ENOMEM;
+        return false;
+    }
+    r->owns_fd = true;
+
+    return true;
+}
+
+void reader_free(struct line_reader *r) {
+    if (r->mapped)
+        munmap(r->buffer, r->capacity);
+    else
+        free(r->buffer);
+    if (r->owns_fd)
+        close(r->fd);
+    r->buffer = NULL;
+}
+
+/**
+ * @brief Dopełnia bufor kolejnym blokiem wejścia.
+ * Przesuwa nieprzetworzoną część bufora na jego początek, a gdy zajmuje ona
+ * cały bufor, podwaja go.
+ * @param[in, out] r - stan wczytywania.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool fill_buffer(struct line_reader *r) {
+    if (r->begin > 0) {
+        memmove(r->buffer, r->buffer + r->begin, r->end - r->begin);
+        r->end -= r->begin;
+        r->begin = 0;
+    }
+
+    if (r->end == r->capacity) {
+        char *buffer = realloc(r->buffer, 2 * r->capacity);
+        if (buffer == NULL)
+            return false;
+        r->buffer = buffer;
+        r->capacity *= 2;
+    }
+
+    ssize_t n;
+    do {
+        n = read(r->fd, r->buffer + r->end, r->capacity - r->end);
+    } while (n < 0 && errno == EINTR);
+
+    // błąd odczytu jest traktowany jak koniec wejścia
+    if (n <= 0)
+        r->eof = true;
+    else
+        r->end += (size_t)n;
+
+    return true;
+}
+
+/**
+ * @brief Znajduje kolejną linię wejścia.
+ * @param[in, out] r - stan wczytywania.
+ * @param[out] line - początek linii.
+ * @param[out] length - długość linii bez kończącego ją znaku nowej linii.
+ * @param[out] complete - czy linia kończy się znakiem nowej linii.
+ * @return @p true, gdy znaleziono linię, @p false, gdy wejście się skończyło
+ *         lub nie udało się zaalokować pamięci (wtedy @p errno to ENOMEM).
+ */
+static bool next_line(struct line_reader *r, const char **line,
+                      size_t *length, bool *complete) {
+    size_t scanned = r->begin;
+    char *newline;
+
+    while ((newline = memchr(r->buffer + scanned, '\n',
+                             r->end - scanned)) == NULL) {
+        if (r->eof)
+            break;
+        // przesunięcie bufora zmienia pozycję już przejrzanych znaków
+        scanned = r->end - r->begin;
+        if (!fill_buffer(r)) {
+            errno = ENOMEM;
+            return false;
+        }
+    }
+
+    if (newline == NULL) {
+        if (r->begin == r->end)
+            return false;
+        *line = r->buffer + r->begin;
+        *length = r->end - r->begin;
+        *complete = false;
+        r->begin = r->end;
+        return true;
+    }
+
+    *line = r->buffer + r->begin;
+    *length = (size_t)(newline - *line);
+    *complete = true;
+    r->begin += *length + 1;
+    return true;
+}
+
+/**
+ * @brief Sprawdza, czy znak @p c oddziela słowa w linii.
+ * @param[in] c - znak.
+ * @return @p true, gdy znak jest białym znakiem, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool is_delimiter(char c) {
+    return c == ' ' || c == '\t' || c == '\v' || c == '\f' || c == '\r' ||
+           c == '\n';
+}
+
+/**
+ * @brief Rozkłada linię na słowa, zamieniając parametry na liczby w tym
+ *        samym przejściu.
+ * @param[in] line - początek linii.
+ * @param[in] length - długość linii.
+ * @param[out] cmd - polecenie z linii.
+ */
+static void lex_line(const char *line, size_t length, struct command *cmd) {
+    size_t i = 0;
+
+    cmd->name = '\0';
+    cmd->words = 0;
+    cmd->numbers_valid = true;
+
+    while (i < length && line[i] != '\0') {
+        if (is_delimiter(line[i])) {
+            i++;
+            continue;
+        }
+
+        size_t start = i;
+        uint64_t value = 0;
+        bool valid = true;
+
+        while (i < length && line[i] != '\0' && !is_delimiter(line[i])) {
+            char c = line[i];
+            if (c < '0' || c > '9') {
+                valid = false;
+            }
+            else if (valid) {
+                value = value * 10 + (uint64_t)(c - '0');
+                if (value > UINT32_MAX)
+                    valid = false;
+            }
+            i++;
+        }
+
+        if (cmd->words == 0) {
+            if (start == 0 && i == 1)
+                cmd->name = line[0];
+        }
+        else if (!valid) {
+            cmd->numbers_valid = false;
+        }
+        else if (cmd->words <= COMMAND_MAX_PARAMS) {
+            cmd->params[cmd->words - 1] = (uint32_t)value;
+        }
+        cmd->words++;
+    }
+}
+
+/**
+ * @brief Wczytuje kolejną linię wejścia, pomijając linie puste i zaczynające
+ *        się znakiem '#'.
+ * @param[in, out] r - stan wczytywania.
+ * @param[out] line - początek linii.
+ * @param[out] length - długość linii.
+ * @param[in, out] line_number - numer ostatnio wczytanej linii.
+ * @return Wynik wczytania linii. Linię do rozłożenia na polecenie oznacza
+ *         wartość LINE_COMMAND.
+ */
+static enum line_status next_content(struct line_reader *r, const char **line,
+                                     size_t *length,
+                                     unsigned long long *line_number) {
+    bool complete;
+
+    errno = 0;
+    while (next_line(r, line, length, &complete)) {
+        (*line_number)++;
+
+        if (!complete)
+            return (*line)[0] == '#' ? LINE_END : LINE_ERROR;
+        if (*length == 0 || (*line)[0] == '#')
+            continue;
+
+        return LINE_COMMAND;
+    }
+
+    if (errno == ENOMEM)
+        return LINE_NO_MEMORY;
+
+    return LINE_END;
+}
+
+enum line_status next_command(struct line_reader *r, struct command *cmd,
+                              unsigned long long *line_number) {
+    const char *line;
+    size_t length;
+    enum line_status status = next_content(r, &line, &length, line_number);
+
+    if (status == LINE_COMMAND)
+        lex_line(line, length, cmd);
+
+    return status;
+}
+
+enum line_status next_tagged_command(struct line_reader *r, uint32_t *tag,
+                                     struct command *cmd,
+                                     unsigned long long *line_number) {
+    const char *line;
+    size_t length;
+    enum line_status status = next_content(r, &line, &length, line_number);
+
+    if (status != LINE_COMMAND)
+        return status;
+    if (line[0] != '@')
+        return LINE_ERROR;
+
+    size_t i = 1;
+    uint64_t value = 0;
+
+    while (i < length && line[i] >= '0' && line[i] <= '9') {
+        value = value * 10 + (uint64_t)(line[i] - '0');
+        if (value > UINT32_MAX)
+            return LINE_ERROR;
+        i++;
+    }
+    if (i == 1 || i == length || !is_delimiter(line[i]))
+        return LINE_ERROR;
+    while (i < length && is_delimiter(line[i]))
+        i++;
+
+    *tag = (uint32_t)value;
+    lex_line(line + i, length - i, cmd);
+    return LINE_COMMAND;
+}
+
+size_t reader_buffered(const struct line_reader *r) {
+    return r->end - r->begin;
+}
+
+bool next_record(struct line_reader *r, size_t size,
+                 const unsigned char **record) {
+    errno = 0;
+    while (r->end - r->begin < size) {
+        if (r->eof)
+            return false;
+        if (!fill_buffer(r)) {
+            errno = ENOMEM;
+            return false;
+        }
+    }
+
+    *record = (const unsigned char *)r->buffer + r->begin;
+    r->begin += size;
+    return true;
+}
+
+bool reader_line_ready(const struct line_reader *r) {
+    return r->eof ||
+           memchr(r->buffer + r->begin, '\n', r->end - r->begin) != NULL;
+}
@@ -0,0 +1,160 @@
+/** @file
+ * Interfejs modułu wczytującego wejście dużymi blokami lub odwzorowującego
+ * plik wejściowy w pamięci i rozkładającego kolejne linie na polecenia
+ * w jednym przejściu, bez kopiowania linii.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#ifndef LEXER_H
+#define LEXER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Największa liczba parametrów liczbowych polecenia.
+ */
+#define COMMAND_MAX_PARAMS 4
+
+/**
+ * Struktura przechowująca stan wczytywania wejścia.
+ */
+struct line_reader {
+    int fd;///< deskryptor, z którego czytane jest wejście.
+    char *buffer;
+    /**<
+     * Bufor, do którego trafiają kolejne bloki wejścia, lub odwzorowany
+     * w pamięci plik wejściowy.
+     */
+    size_t capacity;///< rozmiar bufora.
+    bool mapped;///< czy bufor jest odwzorowanym w pamięci plikiem.
+    bool owns_fd;///< czy deskryptor ma zostać zamknięty przy zwalnianiu.
+    size_t begin;///< początek nieprzetworzonej części bufora.
+    size_t end;///< koniec wczytanej części bufora.
+    bool eof;///< czy wczytano już całe wejście.
+};
+
+/**
+ * Struktura opisująca polecenie z jednej linii wejścia.
+ */
+struct command {
+    char name;
+    /**<
+     * Nazwa polecenia: pierwsze słowo linii, gdy jest jednoznakowe i zaczyna
+     * się na początku linii, w przeciwnym przypadku '\0'.
+     */
+    int words;///< liczba słów oddzielonych białymi znakami.
+    bool numbers_valid;
+    /**<
+     * Czy wszystkie słowa poza pierwszym są liczbami dziesiętnymi
+     * mieszczącymi się w typie uint32_t.
+     */
+    uint32_t params[COMMAND_MAX_PARAMS];///< kolejne parametry liczbowe.
+};
+
+/**
+ * Wynik wczytania kolejnej linii wejścia.
+ */
+enum line_status {
+    LINE_COMMAND,///< linia zawiera polecenie do sprawdzenia.
+    LINE_ERROR,///< linia jest błędna, niezależnie od trybu gry.
+    LINE_END,///< wejście się skończyło.
+    LINE_NO_MEMORY///< nie udało się zaalokować pamięci.
+};
+
+/**
+ * @brief Przygotowuje wczytywanie wejścia z deskryptora @p fd.
+ * @param[out] r - stan wczytywania.
+ * @param[in] fd - deskryptor pliku otwartego do odczytu.
+ * @return @p true, gdy udało się zaalokować bufor, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool reader_init(struct line_reader *r, int fd);
+
+/**
+ * @brief Przygotowuje wczytywanie pliku @p path.
+ * Zwykły niepusty plik jest odwzorowywany w pamięci w całości i przeglądany
+ * bez kopiowania. Pozostałe pliki, np. potoki, są czytane blokami tak jak
+ * w funkcji reader_init(...).
+ * @param[out] r - stan wczytywania.
+ * @param[in] path - ścieżka do pliku.
+ * @return @p true, gdy udało się otworzyć plik, @p false w przeciwnym
+ *         przypadku (wtedy @p errno opisuje błąd).
+ */
+extern bool reader_open(struct line_reader *r, const char *path);
+
+/**
+ * @brief Zwalnia bufor wczytywania wejścia oraz zamyka plik otwarty przez
+ *        funkcję reader_open(...).
+ * @param[in, out] r - stan wczytywania.
+ */
+extern void reader_free(struct line_reader *r);
+
+/**
+ * @brief Wczytuje kolejną linię wejścia i rozkłada ją na polecenie.
+ * Pomija linie puste i zaczynające się znakiem '#', zwiększając dla nich
+ * numer linii. Linia niezakończona znakiem nowej linii jest błędna, chyba że
+ * zaczyna się znakiem '#'. Tak jak przy porównywaniu napisów, znak '\0'
+ * kończy treść linii.
+ * @param[in, out] r - stan wczytywania.
+ * @param[out] cmd - polecenie z wczytanej linii.
+ * @param[in, out] line_number - numer ostatnio wczytanej linii.
+ * @return Wynik wczytania linii.
+ */
+extern enum line_status next_command(struct line_reader *r,
+                                     struct command *cmd,
+                                     unsigned long long *line_number);
+
+/**
+ * @brief Wczytuje kolejną linię wejścia, oznaczoną numerem @p tag, i rozkłada
+ *        ją na polecenie.
+ * Linia zaczyna się znakiem '@', po którym następuje numer i białe znaki,
+ * a po nich polecenie, tak jak w funkcji next_command(...). Linia bez
+ * poprawnego oznaczenia jest błędna.
+ * @param[in, out] r - stan wczytywania.
+ * @param[out] tag - numer, którym oznaczono linię.
+ * @param[out] cmd - polecenie z wczytanej linii.
+ * @param[in, out] line_number - numer ostatnio wczytanej linii.
+ * @return Wynik wczytania linii.
+ */
+extern enum line_status next_tagged_command(struct line_reader *r,
+                                            uint32_t *tag,
+                                            struct command *cmd,
+                                            unsigned long long *line_number);
+
+/**
+ * @brief Sprawdza, czy kolejną linię wejścia można wczytać bez czekania na
+ *        wejście.
+ * @param[in] r - stan wczytywania.
+ * @return @p true, gdy w buforze jest cała kolejna linia lub wejście się
+ *         skończyło, @p false w przeciwnym przypadku.
+ */
+extern bool reader_line_ready(const struct line_reader *r);
+
+/**
+ * @brief Podaje liczbę wczytanych, a jeszcze nieprzetworzonych bajtów
+ *        wejścia.
+ * Pozwala sprawdzić, czy pobranie kolejnego rekordu będzie wymagało
+ * czekania na wejście.
+ * @param[in] r - stan wczytywania.
+ * @return Liczba bajtów.
+ */
+extern size_t reader_buffered(const struct line_reader *r);
+
+/**
+ * @brief Pobiera z wejścia rekord o rozmiarze @p size bajtów.
+ * @param[in, out] r - stan wczytywania.
+ * @param[in] size - rozmiar rekordu.
+ * @param[out] record - początek rekordu w buforze, ważny do kolejnego
+ *                      pobrania z wejścia.
+ * @return @p true, gdy pobrano cały rekord, @p false, gdy wejście skończyło
+ *         się wcześniej lub nie udało się zaalokować pamięci (wtedy @p errno
+ *         to ENOMEM).
+ */
+extern bool next_record(struct line_reader *r, size_t size,
+                        const unsigned char **record);
+
+#endif /* LEXER_H */
@@ -7,88 +7,91 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include "queue.h"
+#include <string.h>
 #include "moves.h"
 
 uint32_t **create_new_arr(gamma_t *g) {
+    uint64_t fields = (uint64_t)g->b_width * g->b_height;
+    if (fields > SIZE_MAX / sizeof(uint32_t))
+        return NULL;
+
     uint32_t **check_array;
-    check_array = malloc(g->b_width * sizeof(uint32_t *));
+    check_array = malloc(g->b_height * sizeof(uint32_t *));
     if (check_array == NULL)
         return NULL;
-    
-    for (uint32_t i = 0; i < g->b_width; i++) {
-        check_array[i] = calloc(g->b_height, sizeof(uint32_t));
 
-        if (check_array[i] == NULL) {
-            for (uint32_t j = 0; j < i; j++)
-                free(check_array[i]);
-                
-            free(check_array);
+    // wszystkie wiersze leżą w jednym bloku, jeden za drugim
+    check_array[0] = calloc(fields, sizeof(uint32_t));
+    if (check_array[0] == NULL) {
+        free(check_array);
+        return NULL;
+    }
 
-            return NULL;
-        }
+    for (uint32_t i = 1; i < g->b_height; i++) {
+        check_array[i] = check_array[i - 1] + g->b_width;
     }
 
+    GAMMA_COUNT(g, arrays_created, 1);
     return check_array;
 }
 
+void clear_arr(gamma_t *g, uint32_t **b_arr) {
+    memset(b_arr[0], 0,
+           (uint64_t)g->b_width * g->b_height * sizeof(uint32_t));
+}
+
 void free_arr(gamma_t *g, uint32_t **b_arr) {
-    for (uint32_t i = 0; i < g->b_width; i++) {
-        free(b_arr[i]);
-    }
+    (void)g;
+    free(b_arr[0]);
     free(b_arr);
 }
 
-bool make_help_arr(gamma_t *g, uint32_t player_arr[][2], uint32_t player_arr_2[][2],
-                    uint32_t ***check_arr, uint32_t x, uint32_t y) {
-    for (int i = 0 ; i < ADJACENT_FIELDS; i++) {
-        player_arr[i][0] = 0;
-        player_arr[i][1] = 0;
-        player_arr_2[i][0] = 0;
-        player_arr_2[i][1] = 0;
-    }
-    if (x > 0 && g->board[x - 1][y] > 0) {
-        player_arr[0][0] = g->board[x - 1][y];
-        player_arr_2[0][0] = g->board[x - 1][y];
-    }
-    if (x < g->b_width - 1 && g->board[x + 1][y] > 0) {
-        player_arr[1][0] = g->board[x + 1][y];
-        player_arr_2[1][0] = g->board[x + 1][y];
-        // sprawdzanie, czy numer gracza nie został wcześniej pobrany
-        if (player_arr[0][0] == player_arr[1][0]) {
-            player_arr[1][0] = 0;
-            player_arr_2[1][0] = 0;
-        }
-    }
-    if (y > 0 && g->board[x][y - 1] > 0) {
-        player_arr[2][0] = g->board[x][y - 1];
-        player_arr_2[2][0] = g->board[x][y - 1];
-       // sprawdzanie, czy numer gracza nie został wcześniej pobrany 
-        if (player_arr[0][0] == player_arr[2][0] ||
-            player_arr[1][0] == player_arr[2][0]) {
-            player_arr[2][0] = 0;
-            player_arr_2[2][0] = 0;
-        }
+/**
+ * @brief Podaje liczbę słów 64-bitowych, które zajmuje w mapie bitowej jeden
+ *        wiersz planszy.
+ * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @return Liczba słów.
+ */
+static uint64_t bitmap_row_words(gamma_t *g) {
+    return ((uint64_t)g->b_width + 63) / 64;
+}
 
-    }
-    if (y < g->b_height - 1 && g->board[x][y + 1] > 0) {
-        player_arr[3][0] = g->board[x][y + 1];
-        player_arr_2[3][0] = g->board[x][y + 1];
-        // sprawdzanie, czy numer gracza nie został wcześniej pobrany
-        if (player_arr[0][0] == player_arr[3][0] ||
-            player_arr[1][0] == player_arr[3][0] ||
-            player_arr[2][0] == player_arr[3][0]) {
-            player_arr[3][0] = 0;
-            player_arr_2[3][0] = 0;
-        }
-    }
+uint64_t *create_bitmap(gamma_t *g) {
+    return calloc(bitmap_row_words(g) * g->b_height, sizeof(uint64_t));
+}
 
-    *check_arr = create_new_arr(g);
-    if ((*check_arr) == NULL) {
-        return false;
+void clear_bitmap(gamma_t *g, uint64_t *bits) {
+    memset(bits, 0, bitmap_row_words(g) * g->b_height * sizeof(uint64_t));
+}
+
+void set_field_bit(gamma_t *g, uint64_t *bits, uint32_t x, uint32_t y) {
+    bits[y * bitmap_row_words(g) + x / 64] |= UINT64_C(1) << (x % 64);
+}
+
+bool test_field_bit(gamma_t *g, const uint64_t *bits, uint32_t x,
+                    uint32_t y) {
+    return (bits[y * bitmap_row_words(g) + x / 64] >> (x % 64)) & 1;
+}
+
+uint32_t next_field_bit(gamma_t *g, const uint64_t *bits, uint32_t x,
+                        uint32_t y) {
+    const uint64_t *row = bits + y * bitmap_row_words(g);
+    uint64_t words = bitmap_row_words(g);
+
+    if (x >= g->b_width)
+        return g->b_width;
+
+    uint64_t i = x / 64;
+    // bity pól na lewo od pola (x, y) są pomijane
+    uint64_t word = row[i] & (~UINT64_C(0) << (x % 64));
+
+    while (word == 0) {
+        if (++i == words)
+            return g->b_width;
+        word = row[i];
     }
 
-    return true;
+    return (uint32_t)(i * 64 + (uint64_t)__builtin_ctzll(word));
 }
 
 bool check_move_parameters(gamma_t *g, uint32_t player, uint32_t x,
@@ -102,7 +105,7 @@ bool check_move_parameters(gamma_t *g, uint32_t player, uint32_t x,
     if (x > g->b_width - 1 || y > g->b_height - 1) {
         return false;
     }
-    if (g->board[x][y] != 0) {
+    if (g->board[y][x] != 0) {
         return false;
     }
 
@@ -110,172 +113,23 @@ bool check_move_parameters(gamma_t *g, uint32_t player, uint32_t x,
     
 }
 
-/**
- * @brief Oznacza zbiór sąsiadujących ze sobą pól danego gracza.
- * Podstawą funkcji jest algorytm BFS.
- * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
- * @param[in] x - pierwsza współrzędna pola startowego. 
- * @param[in] y - druga współrzędna pola startowego.
- * @param[in] check_arr - tablica pól odwiedzonych.
- * @return @p True jeśli udało się bezproblemowo zaalokować pamięć na kolejkę,
- *         @p false w przeciwnym wypadku.
- */
-static bool mark_set(gamma_t *g, uint32_t x, uint32_t y, uint32_t **check_arr) {
-    TQueue *field_queue = init();
-    if (field_queue == NULL) {
-        return false;
-    }
-
-    push_q(field_queue, x, y);
-
-    uint32_t x_tmp, y_tmp;
-
-    while (!empty_q(field_queue)) {
-        pop_q(field_queue, &x_tmp, &y_tmp);
-        check_arr[x_tmp][y_tmp] = 1;
-
-        if (x_tmp > 0 &&
-            g->board[x_tmp - 1][y_tmp] == g->board[x_tmp][y_tmp] &&
-            check_arr[x_tmp - 1][y_tmp] == 0) {
-            if (!push_q(field_queue, x_tmp - 1, y_tmp)) {
-                del_queue(field_queue);
-                return false;
-            }
-        }
-        if (x_tmp < g->b_width - 1 &&
-            g->board[x_tmp + 1][y_tmp] == g->board[x_tmp][y_tmp] &&
-            check_arr[x_tmp + 1][y_tmp] == 0) {
-            if (!push_q(field_queue, x_tmp + 1, y_tmp)) {
-                del_queue(field_queue);
-                return false;
-            }
-        }
-        if (y_tmp > 0 &&
-            g->board[x_tmp][y_tmp - 1] == g->board[x_tmp][y_tmp] &&
-            check_arr[x_tmp][y_tmp - 1] == 0) {
-            if (!push_q(field_queue, x_tmp, y_tmp - 1)) {
-                del_queue(field_queue);
-                return false;
-            }
-        }
-        if (y_tmp < g->b_height - 1 &&
-            g->board[x_tmp][y_tmp + 1] == g->board[x_tmp][y_tmp] &&
-            check_arr[x_tmp][y_tmp + 1] == 0) {
-            if (!push_q(field_queue, x_tmp, y_tmp + 1)) {
-                del_queue(field_queue);
-                return false;
-            }
-        }
-    }
-
-    del_queue(field_queue);
-    return true;
-}
-
-/**
- * @brief Szuka liczby spójnych obszarów danego gracza wokół pola (@p x, @p y).
- * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
- * @param[in] x - pierwsza współrzędna pola, wokół którego szukane są liczby
- *            spójnych obszarów.
- * @param[in] y - druga współrzędna pola, wokół którego szukane są liczby
- *            spójnych obszarów.
- * @param[in] check_arr - tablica, trzymająca stan pól na planszy
- *                        (odwiedzony, nieodwiedzony).
- * @param[out] player_arr - tablica trzymająca liczbę rożnych obszarów zajętych
- *                      przez danego gracza wokół pola (@p x, @p y).
- *                     
- * @return @p True gdy udało się zaalokować pamięć w funkcji mark_set(...),
- *         @p false w przeciwnym przypadku.
- */
-static bool find_sets(gamma_t *g, uint32_t x, uint32_t y, uint32_t **check_arr,
-                uint32_t player_arr[][2]) {
-    if (x > 0 && g->board[x - 1][y] > 0) {
-        if (!mark_set(g, x - 1, y, check_arr)) {
-            return false;
-        }
-        for (int i = 0; i < ADJACENT_FIELDS; i++) {
-            if (player_arr[i][0] == g->board[x - 1][y])
-                player_arr[i][1]++;
-        }
-    }
-    if (x < g->b_width - 1 && g->board[x + 1][y] > 0 &&
-        check_arr[x + 1][y] == 0) {
-        if (!mark_set(g, x + 1, y, check_arr)) {
-            return false;
-        }
-        for (int i = 0; i < ADJACENT_FIELDS; i++) {
-            if (player_arr[i][0] == g->board[x + 1][y])
-                player_arr[i][1]++;
-        }
-    }
-    if (y > 0 && g->board[x][y - 1] > 0 &&
-        check_arr[x][y - 1] == 0) {
-        if (!mark_set(g, x, y - 1, check_arr)) {
-            return false;
-        }
-        for (int i = 0; i < ADJACENT_FIELDS; i++) {
-            if (player_arr[i][0] == g->board[x][y - 1])
-                player_arr[i][1]++;
-        }
-    }
-    if (y < g->b_height - 1 && g->board[x][y + 1] > 0 &&
-        check_arr[x][y + 1] == 0) {
-        for (int i = 0; i < ADJACENT_FIELDS; i++) {
-            if (player_arr[i][0] == g->board[x][y + 1])
-                player_arr[i][1]++;
-        }
-    }
-    
-    return true;
-}
-
 bool check_neighbors(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
-    if (x > 0 && g->board[x - 1][y] == player) {
+    if (x > 0 && g->board[y][x - 1] == player) {
         return true;
     }
-    if (x < g->b_width - 1 && g->board[x + 1][y] == player) {
+    if (x < g->b_width - 1 && g->board[y][x + 1] == player) {
         return true;
     }
-    if (y < g->b_height - 1 && g->board[x][y + 1] == player) {
+    if (y < g->b_height - 1 && g->board[y + 1][x] == player) {
         return true;
     }
-    if (y > 0 && g->board[x][y - 1] == player) {
+    if (y > 0 && g->board[y - 1][x] == player) {
         return true;
     }
 
     return false;
 }
 
-bool find_sets_of_player(gamma_t *g, uint32_t player, uint32_t x, uint32_t y,
-                            uint32_t **check_arr, uint32_t *counter) {
-    if (x > 0 && g->board[x - 1][y] == player) {
-        if (!mark_set(g, x - 1, y, check_arr)) {
-            return false;
-        }
-        (*counter)++;
-    }
-    if (x < g->b_width - 1 && g->board[x + 1][y] == player &&
-        check_arr[x + 1][y] == 0) {
-        if (!mark_set(g, x + 1, y, check_arr)) {
-            return false;
-        }
-        (*counter)++;
-    }
-    if (y > 0 && g->board[x][y - 1] == player &&
-        check_arr[x][y - 1] == 0) {
-        if (!mark_set(g, x, y - 1, check_arr)) {
-            return false;
-        }
-        (*counter)++;
-    }
-    if (y < g->b_height - 1 && g->board[x][y + 1] == player &&
-        check_arr[x][y + 1] == 0) {
-        (*counter)++;
-    }
-    
-    return true;
-}
-
 bool check_golden_parameters(gamma_t *g, uint32_t player, uint32_t x,
                             uint32_t y) {
     if (g == NULL)
@@ -286,65 +140,12 @@ bool check_golden_parameters(gamma_t *g, uint32_t player, uint32_t x,
         return false;
     if (y > g->b_height - 1)
         return false;
-    if (g->board[x][y] == 0)
+    if (g->board[y][x] == 0)
         return false;
     if (g->golden_move_available[player - 1] == false)
         return false;
-    if (g->board[x][y] == player)
+    if (g->board[y][x] == player)
         return false;
 
     return true;
 }
-
-bool find_and_mark_sets(gamma_t *g, uint32_t player, uint32_t x, uint32_t y,
-                        uint32_t player_arr[][2], uint32_t player_arr_2[][2],
-                        uint32_t **check_arr) {
-    if (!find_sets(g, x, y, check_arr, player_arr)) { 
-        free_arr(g, check_arr);
-        return false;
-    }
-
-    for (uint32_t i = 0; i < g->b_width; i++) {
-        for (uint32_t j = 0; j < g->b_height; j++) {
-            check_arr[i][j] = 0;
-        }
-    }
-    uint32_t prev_player = g->board[x][y];
-    g->board[x][y] = player;
-
-    if (!find_sets(g, x, y, check_arr, player_arr_2)) {
-        g->board[x][y] = prev_player;
-        free_arr(g, check_arr);
-        return false;
-    }
-
-    return true;
-}
-
-void change_busy_areas(gamma_t *g, uint32_t player, uint32_t player_arr[][2]) {
-    for (uint32_t i = 0; i < ADJACENT_FIELDS; i++) {
-        if (player_arr[i][0] != player && player_arr[i][0] > 0) {
-            g->busy_areas[player_arr[i][0] - 1] += player_arr[i][1];
-        }
-    }
-}
-
-bool check_busy_areas(gamma_t *g, uint32_t player, uint32_t x, uint32_t y,
-                        uint32_t player_arr[][2], uint32_t player_arr_2[][2],
-                        uint32_t original_player, uint32_t **check_arr) {
-    for (uint32_t i = 0; i < ADJACENT_FIELDS; i++) {
-        if (player_arr[i][0] != player)
-            player_arr[i][1] = player_arr_2[i][1] - player_arr[i][1];
-        if (player_arr[i][0] != player && player_arr[i][0] > 0 &&
-            g->busy_areas[player_arr[i][0] - 1] + player_arr[i][1] 
-            > g->areas_limit) {
-            g->board[x][y] = original_player;
-
-            free_arr(g, check_arr);
-            return false;
-        }
-    }
-
-    return true;
-}
-
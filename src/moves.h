@@ -18,47 +18,93 @@
 #include <stdbool.h>
 #include "gamma.h"
 
+#ifdef GAMMA_INSTRUMENT
 /**
- * @brief Tworzy nową tablicę o wymiarach @p g->b_width na @p g->b_height.
- * Wpisuje w każde pole w tej tablicy 0.
+ * Zwiększa licznik @p counter gry @p g o @p n. Bez makra
+ * @p GAMMA_INSTRUMENT nie robi nic i nie oblicza swoich argumentów.
+ */
+#define GAMMA_COUNT(g, counter, n) ((g)->counters.counter += (n))
+#else
+#define GAMMA_COUNT(g, counter, n) ((void)0)
+#endif
+
+/**
+ * @brief Tworzy nową tablicę o wymiarach @p g->b_height na @p g->b_width.
+ * Wpisuje w każde pole w tej tablicy 0. Pole (@p x, @p y) planszy odpowiada
+ * elementowi [@p y][@p x], a kolejne wiersze leżą w pamięci jeden za drugim
+ * w bloku wskazywanym przez element [0].
  * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
- * @return Wyzerowany wskaźnik na tablicę o wymiarach 
- *         @p g->b_width na @p g->b_height.
+ * @return Wyzerowany wskaźnik na tablicę o wymiarach
+ *         @p g->b_height na @p g->b_width lub NULL, gdy nie udało się
+ *         zaalokować pamięci.
  */
 extern uint32_t **create_new_arr(gamma_t* g);
 
 /**
- * @brief Usuwa tablicę @p b_arr o dowolnej wielkości pierwszego wymiaru oraz o
- *        wielkości drugiego wymiaru równej @p g->b_height.
+ * @brief Wpisuje 0 w każde pole tablicy @p b_arr utworzonej przez funkcję
+ *        create_new_arr(...).
+ * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @param[in, out] b_arr - tablica, którą zeruje funkcja.
+ */
+extern void clear_arr(gamma_t *g, uint32_t **b_arr);
+
+/**
+ * @brief Usuwa tablicę @p b_arr utworzoną przez funkcję create_new_arr(...).
  * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
  * @param[in] b_arr - tablica, którą usuwa funkcja.
  */
 extern void free_arr(gamma_t *g, uint32_t **b_arr);
 
 /**
- * @brief Tworzy tablice pomocnicze dla funkcji gamma_golden_move(...).
- * 
+ * @brief Tworzy wyzerowaną mapę bitową z jednym bitem na każde pole planszy.
+ * Każdy wiersz planszy zaczyna się od nowego słowa 64-bitowego.
+ * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @return Wskaźnik na mapę bitową lub NULL, gdy nie udało się zaalokować
+ *         pamięci.
+ */
+extern uint64_t *create_bitmap(gamma_t *g);
+
+/**
+ * @brief Zeruje wszystkie bity mapy bitowej @p bits.
+ * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @param[in, out] bits - mapa bitowa utworzona funkcją create_bitmap(...).
+ */
+extern void clear_bitmap(gamma_t *g, uint64_t *bits);
+
+/**
+ * @brief Ustawia bit pola (@p x, @p y) w mapie bitowej @p bits.
  * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
- * @param[in, out] player_arr - tablica, która będzie zawierać numer gracza
- *                              oraz liczbę obszarów przez niego zajętych,
- *                              sąsiadujących z polem (@p x, @p y) przed 
- *                              wykonaniem złotego ruchu.
- * @param[in, out] player_arr_2 - tablica, która będzie zawierać numer gracza
- *                                oraz liczbę obszarów przez niego zajętych,
- *                                sąsiadujących z polem (@p x, @p y) po
- *                                wykonaniu złotego ruchu.
- * @param[in, out] check_arr - tablica, która będzie zawierać informację o tym,
- *                             czy dane pole było odwiedzone podczas oznaczanie
- *                             obszarów.
- * @param[in] x - pierwsza współrzędna pola, na którym ma być zrobiony złoty
- *                ruch.
- * @param[in] y - druga współrzędna pola, na którym ma być zrobiony złoty ruch.
- * @return @p True, gdy alokacja pamięci dla check_arr się powiedzie, @p false
- *         w przeciwnym przypadku.
+ * @param[in, out] bits - mapa bitowa utworzona funkcją create_bitmap(...).
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
  */
-extern bool make_help_arr(gamma_t *g, uint32_t player_arr[][2],
-            uint32_t player_arr_2[][2], uint32_t ***check_arr,
-            uint32_t x, uint32_t y);
+extern void set_field_bit(gamma_t *g, uint64_t *bits, uint32_t x, uint32_t y);
+
+/**
+ * @brief Sprawdza, czy bit pola (@p x, @p y) w mapie bitowej @p bits jest
+ *        ustawiony.
+ * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @param[in] bits - mapa bitowa utworzona funkcją create_bitmap(...).
+ * @param[in] x - pierwsza współrzędna pola.
+ * @param[in] y - druga współrzędna pola.
+ * @return @p true, gdy bit jest ustawiony, @p false w przeciwnym przypadku.
+ */
+extern bool test_field_bit(gamma_t *g, const uint64_t *bits, uint32_t x,
+                           uint32_t y);
+
+/**
+ * @brief Szuka w wierszu @p y pierwszego pola o ustawionym bicie, którego
+ *        pierwsza współrzędna jest nie mniejsza niż @p x.
+ * Przegląda wiersz po 64 pola naraz.
+ * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
+ * @param[in] bits - mapa bitowa utworzona funkcją create_bitmap(...).
+ * @param[in] x - pierwsza współrzędna, od której zaczyna się szukanie.
+ * @param[in] y - numer wiersza.
+ * @return Pierwsza współrzędna znalezionego pola lub @p g->b_width, gdy
+ *         takiego pola nie ma.
+ */
+extern uint32_t next_field_bit(gamma_t *g, const uint64_t *bits, uint32_t x,
+                               uint32_t y);
 
 /**
  * @brief Sprawdza, czy podane parametry ruchu są poprawne.
@@ -88,26 +134,6 @@ extern bool check_move_parameters(gamma_t *g, uint32_t player, uint32_t x,
 extern bool check_neighbors(gamma_t *g, uint32_t player, uint32_t x,
                             uint32_t y);
 
-/**
- * @brief Sprawdza liczbę spójnych obszarów gracza @p player, sąsiadujących
- *        z polem (@p x, @p y).
- * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
- * @param[in] player - numer gracza, którego spójnych obszarów funkcja szuka
- *                 sąsiadujących z polem (@p x, @p y).
- * @param[in] x - pierwsza współrzędna pola, z którym sąsiądujących spójnych
- *                obszarów gracza @p player szuka funkcja.
- * @param[in] y - druga współrzędna pola, z którym sąsiądujących spójnych
- *                obszarów gracza @p player szuka funkcja.
- * @param[in] check_arr - tablica, trzymająca stan pól na planszy
- *                        (odwiedzony, nieodwiedzony).
- * @param[out] counter - wskaźnik na licznik spójnych obszarów gracza
- *                       @p player, sąsiadujących z polem (@p x, @p y).
- * @return @p True gdy udało się zaalokować pamięć w funkcji mark_set(...),
- *         @p false w przeciwnym przypadku.
- */
-extern bool find_sets_of_player(gamma_t *g, uint32_t player, uint32_t x,
-                        uint32_t y, uint32_t **check_arr, uint32_t *counter);
-
 /**
  * @brief Sprawdza, czy podane parametry są poprawne.
  * Sprawdza, czy dla podanych parametrów można wykonać złoty ruch.
@@ -122,69 +148,4 @@ extern bool find_sets_of_player(gamma_t *g, uint32_t player, uint32_t x,
 extern bool check_golden_parameters(gamma_t *g, uint32_t player, uint32_t x,
                             uint32_t y);
 
-/**
- * @brief Uzupełnia tablice @p player_arr oraz @p player_arr_2 o
- *        liczby należących do kolejnych graczy spójnych obszarów, 
- *        sąsiadujących z polem (@p x, @p y).
- * @param[in] g - wskaźnik na strukturę, przechowującą stan gry.
- * @param[in] player - numer gracza, wykonującego złoty ruch.
- * @param[in] x - pierwsza współrzędna pola, na którym wykonywany jest
- *                złoty ruch.
- * @param[in] y - druga współrzędna pola, na którym wykonywany jest
- *                złoty ruch.
- * @param[out] player_arr - tablica, trzymająca liczbę należących do kolejnych
- *                          graczy spójnych obszarów przed wykonaniem
- *                          złotego ruchu.
- * @param[out] player_arr_2 - tablica, trzymająca liczbę należących do 
- *                            kolejnych graczy spójnych obszarów po 
- *                            wykonaniu złotgo ruchu.
- * @param[in] check_arr - tablica, trzymająca stan pól na planszy
- *                        (odwiedzony, nieodwiedzony).
- * @return @p true, jeśli udało się zaalokować pamięć w funkcji mark_set(...),
- *         @p false w przeciwnym przypadku. 
- */
-extern bool find_and_mark_sets(gamma_t *g, uint32_t player, uint32_t x,
-                            uint32_t y, uint32_t player_arr[][2],
-                            uint32_t player_arr_2[][2], uint32_t **check_arr);
-
-/**
- * @brief Zmienia liczbę zajętych obszarów przez graczy, których obszary
- *        sąsiadują z polem, na którym wykonywany jest złoty ruch.
- * @param[in, out] g - wskaźnik na strukturę, przechowującą stan gry.
- * @param[in] player - gracz, który wykonuje złoty ruch.
- * @param[in] player_arr - tablica liczby obszarów, które należy dodać do
- *                         obecnej liczby zajętych przez danego gracza
- *                         obszarów.
- */
-extern void change_busy_areas(gamma_t *g, uint32_t player, 
-                                uint32_t player_arr[][2]);
-
-/**
- * @brief Sprawdza, czy złoty ruch nie sprawi, że gracze, którzy mają obszar
- *        sąsiadujący z polem (@p x, @p y), przekroczą limit obszarów.
- * @param[in, out] g - wskaźnik na strukturę, przechowującą stan gry.
- * @param[in] player - gracz, wykonujący złoty ruch.
- * @param x - pierwsza współrzędna pola, na którym wykonywany jest
- *            złoty ruch.
- * @param[in] y - druga współrzędna pola, na którym wykonywany jest
- *                złoty ruch.
- * @param[in, out] player_arr - tablica liczby obszarów danego gracza,
- *                              sąsiadujących z polem (@p x, @p y) przed
- *                              wykonaniem złotego ruchu.
- * @param[in] player_arr_2 - tablica liczby obszarów danego gracza,
- *                           sąsiadujących z polem (@p x, @p y) przed
- *                           wykonaniem złotego ruchu.
- * @param[in] tmp - numer gracza, który zajmował pole (@p x, @p y) przed
- *                  wykonaniem złotego ruchu.
- * @param[in] check_arr - tablica, trzymająca stan pól
- *                        (odwiedzone, nieodwiedzone).
- * @return @p True, gdy złoty ruch nie spowoduje przekroczenie limitu
- *         zajętych obszarów przez żadnego z graczy, z wyjątkiem gracza
- *         @p player, @p false w przeciwnym przypadku.
- */
-extern bool check_busy_areas(gamma_t *g, uint32_t player, uint32_t x,
-                            uint32_t y, uint32_t player_arr[][2],
-                            uint32_t player_arr_2[][2],
-                            uint32_t tmp, uint32_t **check_arr);
-
 #endif /* MOVES_H */
\ No newline at end of file
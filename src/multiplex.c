@@ -0,0 +1,394 @@
+/** @file
+ * Implementacja modułu obsługującego wiele jednocześnie toczonych gier
+ * w jednym strumieniu poleceń trybu wsadowego.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "gamma.h"
+#include "batch.h"
+#include "output.h"
+#include "tpool.h"
+#include "latency.h"
+#include "multiplex.h"
+
+/**
+ * Największa liczba poleceń wykonywanych razem.
+ */
+#define MULTIPLEX_CHUNK 65536
+
+/**
+ * Oznaczenie braku kolejnego polecenia gry.
+ */
+static const size_t NO_ENTRY = SIZE_MAX;
+
+/**
+ * Numer gry linii bez poprawnego oznaczenia.
+ */
+static const uint32_t NO_GAME = MULTIPLEX_MAX_GAMES;
+
+/**
+ * Liczba słów w poleceniu tworzącym grę.
+ */
+static const int NEW_GAME_WORDS = 5;
+
+/**
+ * Struktura przechowująca grę o jednym numerze.
+ */
+struct mux_game {
+    gamma_t *g;///< stan gry lub NULL, gdy gra nie istnieje.
+    struct output out;///< wyniki poleceń gry z bieżącej porcji.
+    struct output err;///< komunikaty o błędach z bieżącej porcji.
+    size_t first;///< pierwsze polecenie gry w bieżącej porcji.
+    size_t last;///< ostatnie polecenie gry w bieżącej porcji.
+    size_t failed;
+    /**<
+     * Polecenie, przy którym zabrakło pamięci, lub NO_ENTRY.
+     */
+    size_t out_pos;///< początek wyników kolejnego polecenia w @p out.
+    size_t err_pos;///< początek komunikatów kolejnego polecenia w @p err.
+};
+
+/**
+ * Struktura przechowująca polecenie z bieżącej porcji.
+ */
+struct mux_entry {
+    struct batch_line line;///< linia wejścia.
+    uint32_t id;///< numer gry lub NO_GAME.
+    size_t next;///< następne polecenie tej samej gry lub NO_ENTRY.
+    size_t out_end;///< koniec wyników polecenia w buforze gry.
+    size_t err_end;///< koniec komunikatów polecenia w buforze gry.
+};
+
+/**
+ * Struktura przechowująca stan trybu.
+ */
+struct multiplexer {
+    unsigned workers;///< liczba wątków.
+    struct mux_game **games;///< gry indeksowane numerami.
+    uint32_t capacity;///< rozmiar tablicy @p games.
+    struct mux_entry *entries;///< polecenia bieżącej porcji.
+    size_t count;///< liczba poleceń w bieżącej porcji.
+    uint32_t *touched;///< numery gier, których polecenia są w porcji.
+    size_t touched_count;///< liczba numerów w tablicy @p touched.
+    struct output out;///< standardowe wyjście.
+    struct output separate_err;///< standardowe wyjście błędów.
+    struct output *err;
+    /**<
+     * Strumień komunikatów o błędach: @p out, gdy oba strumienie wskazują
+     * ten sam plik, w przeciwnym przypadku @p separate_err.
+     */
+};
+
+/**
+ * @brief Podaje grę o numerze @p id, w razie potrzeby tworząc pusty wpis.
+ * @param[in, out] m - stan trybu.
+ * @param[in] id - numer gry, mniejszy od MULTIPLEX_MAX_GAMES.
+ * @return Wskaźnik na wpis gry lub NULL, gdy nie udało się zaalokować
+ *         pamięci.
+ */
+static struct mux_game *get_game(struct multiplexer *m, uint32_t id) {
+    if (id >= m->capacity) {
+        uint32_t capacity = m->capacity > 0 ? m->capacity : 64;
+        while (capacity <= id)
+            capacity *= 2;
+        if (capacity > MULTIPLEX_MAX_GAMES)
+            capacity = MULTIPLEX_MAX_GAMES;
+
+        struct mux_game **games =
+            realloc(m->games, capacity * sizeof(struct mux_game *));
+        if (games == NULL)
+            return NULL;
+        for (uint32_t i = m->capacity; i < capacity; i++)
+            games[i] = NULL;
+        m->games = games;
+        m->capacity = capacity;
+    }
+
+    if (m->games[id] == NULL) {
+        struct mux_game *game = malloc(sizeof(struct mux_game));
+        if (game == NULL)
+            return NULL;
+        game->g = NULL;
+        output_init_memory(&game->out);
+        output_init_memory(&game->err);
+        game->first = NO_ENTRY;
+        game->out_pos = 0;
+        game->err_pos = 0;
+        m->games[id] = game;
+    }
+
+    return m->games[id];
+}
+
+/**
+ * @brief Wykonuje polecenie gry.
+ * @param[in, out] game - wpis gry.
+ * @param[in] line - linia wejścia.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią, @p false
+ *         w przeciwnym przypadku.
+ */
+static bool run_entry(struct mux_game *game, const struct batch_line *line) {
+    const struct command *cmd = &line->cmd;
+
+    if (line->status == LINE_COMMAND && cmd->name == 'B') {
+        bool created = false;
+
+        if (game->g == NULL && cmd->words == NEW_GAME_WORDS &&
+            cmd->numbers_valid) {
+            game->g = gamma_new(cmd->params[0], cmd->params[1],
+                                cmd->params[2], cmd->params[3]);
+            created = game->g != NULL;
+        }
+
+        if (!created) {
+            batch_print_error(&game->err, line->line_number);
+        }
+        else {
+            output_bytes(&game->out, "OK ", 3);
+            output_u64(&game->out, line->line_number);
+            output_char(&game->out, '\n');
+        }
+        return true;
+    }
+
+    if (line->status == LINE_COMMAND && cmd->name == 'E' && cmd->words == 1) {
+        if (game->g == NULL)
+            batch_print_error(&game->err, line->line_number);
+        latency_add_game(game->g);
+        gamma_delete(game->g);
+        game->g = NULL;
+        return true;
+    }
+
+    if (game->g == NULL) {
+        batch_print_error(&game->err, line->line_number);
+        return true;
+    }
+
+    return batch_execute_line(&game->out, &game->err, game->g, line);
+}
+
+/**
+ * @brief Wykonuje po kolei polecenia jednej gry z bieżącej porcji (funkcja
+ *        wykonywana przez pulę wątków).
+ * @param[in, out] arg - wskaźnik na stan trybu.
+ * @param[in] task - indeks gry w tablicy @p touched.
+ * @param[in] worker - numer wątku.
+ */
+static void run_game(void *arg, uint64_t task, unsigned worker) {
+    (void)worker;
+    struct multiplexer *m = arg;
+    struct mux_game *game = m->games[m->touched[task]];
+
+    game->failed = NO_ENTRY;
+    for (size_t i = game->first; i != NO_ENTRY; i = m->entries[i].next) {
+        struct mux_entry *e = &m->entries[i];
+
+        if (game->failed == NO_ENTRY &&
+            (!run_entry(game, &e->line) || game->out.failed ||
+             game->err.failed))
+            game->failed = i;
+        e->out_end = game->out.used;
+        e->err_end = game->err.used;
+    }
+}
+
+/**
+ * @brief Drukuje wynik polecenia, poprzedzając każdą jego linię numerem
+ *        gry.
+ * @param[in, out] out - strumień wyników.
+ * @param[in] id - numer gry.
+ * @param[in] text - wynik polecenia, złożony z pełnych linii.
+ * @param[in] length - długość wyniku.
+ */
+static void print_tagged(struct output *out, uint32_t id, const char *text,
+                         size_t length) {
+    size_t begin = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        if (text[i] != '\n')
+            continue;
+        output_char(out, '@');
+        output_u64(out, id);
+        output_char(out, ' ');
+        output_bytes(out, text + begin, i + 1 - begin);
+        begin = i + 1;
+    }
+}
+
+/**
+ * @brief Wykonuje polecenia bieżącej porcji i drukuje ich wyniki
+ *        w kolejności z wejścia.
+ * @param[in, out] m - stan trybu.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią, @p false
+ *         w przeciwnym przypadku.
+ */
+static bool run_chunk(struct multiplexer *m) {
+    bool success = tpool_run(m->workers, m->touched_count, run_game, m);
+
+    for (size_t i = 0; i < m->count && success; i++) {
+        struct mux_entry *e = &m->entries[i];
+
+        if (e->id == NO_GAME) {
+            batch_print_error(m->err, e->line.line_number);
+            continue;
+        }
+
+        struct mux_game *game = m->games[e->id];
+        if (e->out_end > game->out_pos)
+            print_tagged(&m->out, e->id, game->out.buffer + game->out_pos,
+                         e->out_end - game->out_pos);
+        if (e->err_end > game->err_pos)
+            output_bytes(m->err, game->err.buffer + game->err_pos,
+                         e->err_end - game->err_pos);
+        game->out_pos = e->out_end;
+        game->err_pos = e->err_end;
+        success = game->failed != i;
+    }
+
+    for (size_t i = 0; i < m->touched_count; i++) {
+        struct mux_game *game = m->games[m->touched[i]];
+
+        game->first = NO_ENTRY;
+        game->out.used = 0;
+        game->err.used = 0;
+        game->out_pos = 0;
+        game->err_pos = 0;
+    }
+    m->count = 0;
+    m->touched_count = 0;
+
+    return success && !m->out.failed && !m->err->failed;
+}
+
+/**
+ * @brief Dodaje linię do bieżącej porcji.
+ * @param[in, out] m - stan trybu.
+ * @param[in] line - linia wejścia.
+ * @param[in] id - numer gry lub NO_GAME.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool add_entry(struct multiplexer *m, const struct batch_line *line,
+                      uint32_t id) {
+    struct mux_entry *e = &m->entries[m->count];
+
+    e->line = *line;
+    e->id = id;
+    e->next = NO_ENTRY;
+
+    if (id != NO_GAME) {
+        struct mux_game *game = get_game(m, id);
+        if (game == NULL)
+            return false;
+
+        if (game->first == NO_ENTRY) {
+            game->first = m->count;
+            m->touched[m->touched_count++] = id;
+        }
+        else {
+            m->entries[game->last].next = m->count;
+        }
+        game->last = m->count;
+    }
+
+    m->count++;
+    return true;
+}
+
+/**
+ * @brief Wczytuje kolejne linie i wykonuje je porcjami.
+ * Porcja kończy się, gdy jest pełna lub gdy wczytanie kolejnej linii
+ * wymagałoby czekania na wejście, więc druga strona dostaje wyniki, zanim
+ * wyśle kolejne polecenia.
+ * @param[in, out] m - stan trybu.
+ * @param[in, out] r - stan wczytywania wejścia.
+ * @param[in, out] line_number - numer ostatnio wczytanej linii.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią, @p false
+ *         w przeciwnym przypadku.
+ */
+static bool run_lines(struct multiplexer *m, struct line_reader *r,
+                      unsigned long long *line_number) {
+    struct batch_line line;
+    uint32_t id;
+
+    while ((line.status = next_tagged_command(r, &id, &line.cmd,
+                                              line_number)) != LINE_END) {
+        if (line.status == LINE_NO_MEMORY) {
+            run_chunk(m);
+            return false;
+        }
+
+        line.line_number = *line_number;
+        if (line.status != LINE_COMMAND || id >= MULTIPLEX_MAX_GAMES)
+            id = NO_GAME;
+        if (!add_entry(m, &line, id)) {
+            run_chunk(m);
+            return false;
+        }
+
+        if (m->count == MULTIPLEX_CHUNK || !reader_line_ready(r)) {
+            if (!run_chunk(m))
+                return false;
+            if (!reader_line_ready(r)) {
+                output_flush(&m->out);
+                output_flush(m->err);
+            }
+        }
+    }
+
+    return run_chunk(m);
+}
+
+bool multiplex_mode(struct line_reader *r, unsigned long long *line_number,
+                    unsigned workers) {
+    struct multiplexer m = {.workers = workers};
+    bool shared = output_same_file(STDOUT_FILENO, STDERR_FILENO);
+
+    m.entries = malloc(MULTIPLEX_CHUNK * sizeof(struct mux_entry));
+    m.touched = malloc(MULTIPLEX_CHUNK * sizeof(uint32_t));
+    m.err = shared ? &m.out : &m.separate_err;
+
+    // linia rozpoczynająca tryb mogła zostać wydrukowana przez stdio
+    fflush(stdout);
+    bool success = m.entries != NULL && m.touched != NULL;
+    if (success && !output_init(&m.out, STDOUT_FILENO)) {
+        output_free(&m.out);
+        success = false;
+    }
+    if (success && !shared && !output_init(&m.separate_err, STDERR_FILENO)) {
+        output_free(&m.separate_err);
+        output_free(&m.out);
+        success = false;
+    }
+    if (!success) {
+        free(m.entries);
+        free(m.touched);
+        return false;
+    }
+
+    success = run_lines(&m, r, line_number);
+
+    for (uint32_t i = 0; i < m.capacity; i++) {
+        if (m.games[i] != NULL) {
+            latency_add_game(m.games[i]->g);
+            gamma_delete(m.games[i]->g);
+            output_free(&m.games[i]->out);
+            output_free(&m.games[i]->err);
+            free(m.games[i]);
+        }
+    }
+    free(m.games);
+    free(m.entries);
+    free(m.touched);
+    if (!shared)
+        success = output_free(&m.separate_err) && success;
+    success = output_free(&m.out) && success;
+
+    return success;
+}
@@ -0,0 +1,45 @@
+/** @file
+ * Interfejs modułu obsługującego wiele jednocześnie toczonych gier w jednym
+ * strumieniu poleceń trybu wsadowego. Każde polecenie jest oznaczone numerem
+ * gry, a polecenia różnych gier mogą być wykonywane na różnych wątkach.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#ifndef MULTIPLEX_H
+#define MULTIPLEX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lexer.h"
+
+/**
+ * Liczba numerów gier: poprawne numery są mniejsze od tej wartości.
+ */
+#define MULTIPLEX_MAX_GAMES (UINT32_C(1) << 20)
+
+/**
+ * @brief Wykonuje polecenia oznaczone numerami gier, aż do końca wejścia.
+ * Linia @p \@n @p B @p szerokość @p wysokość @p gracze @p obszary tworzy grę
+ * o numerze @p n i drukuje @p \@n @p OK @p numer_linii, linia @p \@n @p E
+ * usuwa grę, a linia @p \@n, po której następuje polecenie trybu wsadowego,
+ * wykonuje je w grze @p n. Każda linia wyniku polecenia jest poprzedzona
+ * numerem gry, np. @p \@17 @p 1. Komunikaty o błędach mają postać
+ * @p ERROR @p numer_linii, jak w trybie wsadowym. Polecenia wczytane bez
+ * czekania na wejście są wykonywane razem: polecenia każdej gry w kolejności
+ * z wejścia, różne gry na @p workers wątkach, a wyniki są drukowane
+ * w kolejności poleceń na wejściu.
+ * @param[in, out] r - stan wczytywania wejścia, ustawiony za linią
+ *                     rozpoczynającą tryb.
+ * @param[in, out] line_number - numer linii rozpoczynającej tryb, a po
+ *                               zakończeniu numer ostatnio wczytanej linii.
+ * @param[in] workers - liczba wątków.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią, @p false
+ *         w przeciwnym przypadku.
+ */
+extern bool multiplex_mode(struct line_reader *r,
+                           unsigned long long *line_number,
+                           unsigned workers);
+
+#endif /* MULTIPLEX_H */
@@ -0,0 +1,20 @@
+/** @file
+ * Implementacja funkcji odczytujących argumenty opcji programów.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include "options.h"
+
+bool parse_count(const char *arg, unsigned long long max,
+                 unsigned long long *value) {
+    char *end;
+
+    errno = 0;
+    *value = strtoull(arg, &end, 10);
+    return arg[0] >= '0' && arg[0] <= '9' && *end == '\0' && errno == 0 &&
+           *value <= max;
+}
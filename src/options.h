@@ -0,0 +1,25 @@
+/** @file
+ * Interfejs funkcji odczytujących argumenty opcji programów.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Odczytuje nieujemną liczbę z argumentu opcji.
+ * Argument musi składać się z samych cyfr dziesiętnych.
+ * @param[in] arg - argument opcji.
+ * @param[in] max - największa dopuszczalna wartość.
+ * @param[out] value - odczytana liczba.
+ * @return @p true, gdy argument jest liczbą nie większą niż @p max,
+ *         @p false w przeciwnym przypadku.
+ */
+extern bool parse_count(const char *arg, unsigned long long max,
+                        unsigned long long *value);
+
+#endif /* OPTIONS_H */
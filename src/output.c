@@ -0,0 +1,179 @@
+/** @file
+ * Implementacja modułu buforującego wyniki trybu wsadowego.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "chboard.h"
+#include "output.h"
+
+/**
+ * Rozmiar bufora strumienia wyjścia.
+ */
+static const size_t OUTPUT_BUFFER_SIZE = (size_t)1 << 18;
+
+/**
+ * Początkowy rozmiar bufora strumienia gromadzącego wyniki w pamięci.
+ */
+static const size_t MEMORY_BUFFER_SIZE = 256;
+
+/**
+ * Największa liczba znaków zapisu dziesiętnego liczby typu uint64_t.
+ */
+#define U64_DIGITS 20
+
+bool output_init(struct output *o, int fd) {
+    o->fd = fd;
+    o->buffer = malloc(OUTPUT_BUFFER_SIZE);
+    o->capacity = OUTPUT_BUFFER_SIZE;
+    o->used = 0;
+    o->interactive = isatty(fd);
+    o->failed = false;
+
+    return o->buffer != NULL;
+}
+
+void output_init_memory(struct output *o) {
+    o->fd = -1;
+    o->buffer = NULL;
+    o->capacity = 0;
+    o->used = 0;
+    o->interactive = false;
+    o->failed = false;
+}
+
+bool output_free(struct output *o) {
+    bool ok = output_flush(o);
+
+    free(o->buffer);
+    o->buffer = NULL;
+    return ok;
+}
+
+bool output_same_file(int fd1, int fd2) {
+    struct stat st1, st2;
+
+    if (fstat(fd1, &st1) != 0 || fstat(fd2, &st2) != 0)
+        return false;
+
+    return st1.st_dev == st2.st_dev && st1.st_ino == st2.st_ino;
+}
+
+/**
+ * @brief Zapisuje do strumienia kolejne fragmenty pamięci @p iov, ponawiając
+ *        zapis po zapisaniu części danych lub przerwaniu sygnałem.
+ * Po pierwszym nieudanym zapisie kolejne zapisy do strumienia są pomijane.
+ * @param[in, out] o - strumień wyjścia.
+ * @param[in, out] iov - fragmenty pamięci, zmieniane w trakcie zapisu.
+ * @param[in] count - liczba fragmentów.
+ */
+static void write_vectors(struct output *o, struct iovec *iov, int count) {
+    while (count > 0 && !o->failed) {
+        ssize_t written = writev(o->fd, iov, count);
+
+        if (written < 0) {
+            if (errno != EINTR)
+                o->failed = true;
+            continue;
+        }
+
+        size_t left = (size_t)written;
+        while (count > 0 && left >= iov->iov_len) {
+            left -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char *)iov->iov_base + left;
+            iov->iov_len -= left;
+        }
+    }
+}
+
+bool output_flush(struct output *o) {
+    if (o->fd < 0)
+        return !o->failed;
+
+    struct iovec iov = {o->buffer, o->used};
+
+    if (o->used > 0)
+        write_vectors(o, &iov, 1);
+    o->used = 0;
+
+    return !o->failed;
+}
+
+/**
+ * @brief Zapewnia w buforze miejsce na @p length znaków, opróżniając go lub,
+ *        w przypadku strumienia gromadzącego wyniki w pamięci, powiększając.
+ * @param[in, out] o - strumień wyjścia.
+ * @param[in] length - liczba znaków, nie większa niż rozmiar bufora strumienia
+ *                     zapisywanego do deskryptora.
+ * @return @p true, gdy w buforze jest miejsce, @p false, gdy nie udało się
+ *         zaalokować pamięci.
+ */
+static bool reserve(struct output *o, size_t length) {
+    if (length <= o->capacity - o->used)
+        return true;
+    if (o->fd >= 0) {
+        output_flush(o);
+        return true;
+    }
+
+    size_t capacity = o->capacity > 0 ? o->capacity : MEMORY_BUFFER_SIZE;
+    while (capacity - o->used < length)
+        capacity *= 2;
+
+    char *buffer = realloc(o->buffer, capacity);
+    if (buffer == NULL) {
+        o->failed = true;
+        return false;
+    }
+    o->buffer = buffer;
+    o->capacity = capacity;
+
+    return true;
+}
+
+void output_bytes(struct output *o, const char *data, size_t length) {
+    if (length <= o->capacity - o->used ||
+        (o->fd < 0 && reserve(o, length))) {
+        memcpy(o->buffer + o->used, data, length);
+        o->used += length;
+        return;
+    }
+    if (o->fd < 0)
+        return;
+
+    struct iovec iov[2] = {
+        {o->buffer, o->used},
+        {(void *)data, length}
+    };
+    write_vectors(o, iov, 2);
+    o->used = 0;
+}
+
+void output_char(struct output *o, char c) {
+    if (reserve(o, 1))
+        o->buffer[o->used++] = c;
+}
+
+void output_u64(struct output *o, uint64_t value) {
+    if (!reserve(o, U64_DIGITS))
+        return;
+
+    char digits[U64_DIGITS];
+    char *start = write_digits(digits + U64_DIGITS, value);
+    size_t length = (size_t)(digits + U64_DIGITS - start);
+
+    memcpy(o->buffer + o->used, start, length);
+    o->used += length;
+}
@@ -0,0 +1,112 @@
+/** @file
+ * Interfejs modułu buforującego wyniki trybu wsadowego. Liczby są zamieniane
+ * na tekst bez użycia printf, a bufor jest opróżniany funkcjami write
+ * i writev dopiero, gdy się zapełni lub gdy skończy się wejście. Strumień
+ * może też gromadzić całe wyniki w pamięci, gdy muszą one poczekać na
+ * wyniki wcześniejszych sesji.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Struktura przechowująca bufor jednego strumienia wyjścia.
+ */
+struct output {
+    int fd;
+    /**<
+     * Deskryptor, do którego trafia zawartość bufora, lub -1, gdy wyniki są
+     * gromadzone w pamięci.
+     */
+    char *buffer;///< bufor wyjścia.
+    size_t capacity;///< rozmiar bufora.
+    size_t used;///< liczba znaków w buforze.
+    bool interactive;
+    /**<
+     * Czy deskryptor jest terminalem. Wtedy bufor jest opróżniany po każdym
+     * poleceniu, tak jak robi to biblioteka standardowa.
+     */
+    bool failed;
+    /**<
+     * Czy zapis do deskryptora lub powiększenie bufora w pamięci się nie
+     * powiodło.
+     */
+};
+
+/**
+ * @brief Przygotowuje bufor strumienia wyjścia @p fd.
+ * @param[out] o - strumień wyjścia.
+ * @param[in] fd - deskryptor otwarty do zapisu.
+ * @return @p true, gdy udało się zaalokować bufor, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool output_init(struct output *o, int fd);
+
+/**
+ * @brief Przygotowuje strumień gromadzący wyniki w pamięci.
+ * Bufor takiego strumienia rośnie w miarę potrzeb i nie jest nigdzie
+ * zapisywany.
+ * @param[out] o - strumień wyjścia.
+ */
+extern void output_init_memory(struct output *o);
+
+/**
+ * @brief Opróżnia bufor i zwalnia go.
+ * @param[in, out] o - strumień wyjścia.
+ * @return @p true, gdy cała zawartość bufora została zapisana, @p false
+ *         w przeciwnym przypadku.
+ */
+extern bool output_free(struct output *o);
+
+/**
+ * @brief Sprawdza, czy deskryptory @p fd1 i @p fd2 wskazują ten sam plik.
+ * Wyniki zapisywane do takich deskryptorów muszą przechodzić przez jeden
+ * bufor, by zachować kolejność.
+ * @param[in] fd1 - pierwszy deskryptor.
+ * @param[in] fd2 - drugi deskryptor.
+ * @return @p true, gdy oba deskryptory wskazują ten sam plik, @p false
+ *         w przeciwnym przypadku.
+ */
+extern bool output_same_file(int fd1, int fd2);
+
+/**
+ * @brief Zapisuje do deskryptora zawartość bufora.
+ * Strumień gromadzący wyniki w pamięci nie jest zmieniany.
+ * @param[in, out] o - strumień wyjścia.
+ * @return @p true, gdy cała zawartość bufora została zapisana, @p false
+ *         w przeciwnym przypadku.
+ */
+extern bool output_flush(struct output *o);
+
+/**
+ * @brief Dopisuje do strumienia @p length znaków spod adresu @p data.
+ * Gdy znaki nie mieszczą się w buforze, zapisuje bufor i znaki jednym
+ * wywołaniem writev, bez ich kopiowania.
+ * @param[in, out] o - strumień wyjścia.
+ * @param[in] data - dopisywane znaki.
+ * @param[in] length - liczba znaków.
+ */
+extern void output_bytes(struct output *o, const char *data, size_t length);
+
+/**
+ * @brief Dopisuje do strumienia znak @p c.
+ * @param[in, out] o - strumień wyjścia.
+ * @param[in] c - znak.
+ */
+extern void output_char(struct output *o, char c);
+
+/**
+ * @brief Dopisuje do strumienia zapis dziesiętny liczby @p value.
+ * @param[in, out] o - strumień wyjścia.
+ * @param[in] value - liczba.
+ */
+extern void output_u64(struct output *o, uint64_t value);
+
+#endif /* OUTPUT_H */
@@ -20,85 +20,41 @@
 #include "gamma.h"
 #include "batch.h"
 #include "interactive.h"
+#include "lexer.h"
+#include "sessions.h"
+#include "multiplex.h"
+#include "journal.h"
 #include "parser.h"
 
-/**
- * Tablica zawierająca białe znaki.
- */
-static const char delimiters[7] = {' ', '\t', '\v', '\f', '\r', '\n', '\0'};
-
 /**
  * Liczba ciągów znaków oddzielonych białymi znakami w poprawnej linijce,
  * wywołującej przejście do jednego z dwóch trybów gry. 
  */
 static const int VALID_NUMBER_OF_PARAMETERS = 5;
 
-/**
- * @brief Tworzy tablicę pięciu wskaźników.
- * @param[in, out] words - wskaźnik na tablicę wskaźników.
- * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
- * przypadku.
- */
-static bool initiate_arr_of_words(char ***words) {
-    *words = malloc(VALID_NUMBER_OF_PARAMETERS * sizeof(char *));
-
-    if ((*words) == NULL)
-        return false;
-
-    return true;
-}
-
-bool check_num_parameter(char *word) {
-    char *pointer_to_end;
-    unsigned long long parameter_num;
-
-    if ((int)word[0] < (int)'0' || (int)word[0] > (int)'9')
-            return false;
-        
-    parameter_num = strtoull(word, &pointer_to_end, 10);
-        
-    if (strcmp(pointer_to_end, "") != 0) {
-        return false;
-    }
-
-    if (parameter_num > UINT32_MAX) {
-        errno = 0;
-        return false;
-    }
-
-    return true;
-}
-
 /**
  * @brief Sprawdza poprawność linii wpisanych przed wejściem do jednego z
  *        trybów gry.
  * Sprawdza: liczbę łańcuchów znaków oddzielonych białymi znakami w linii,
  * pierwszy łańcuch znaków oraz poprawność łańcuchów, które docelowo mają 
  * składać się na liczby.
- * @param[in] words - tablica wskaźników do pierwszych znaków z kolejnych
- *                    łańcuchów znaków z linii.
- * @param[in] number_of_words_in_line - liczba łańcuchów znaków, oddzielonych
- *                                  białymi znakami w linii.
+ * @param[in] cmd - polecenie z linii.
  * @return @p true, gdy linijka może być poprawną linią wprowadzającą w jeden
  *         z trybów gry, @p false w przeciwnym przypadku.
  */
-static bool check_initial_line(char **words, int number_of_words_in_line) {
-    if (number_of_words_in_line > VALID_NUMBER_OF_PARAMETERS ||
-        number_of_words_in_line < VALID_NUMBER_OF_PARAMETERS) {
+static bool check_initial_line(const struct command *cmd) {
+    if (cmd->words != VALID_NUMBER_OF_PARAMETERS) {
         return false;
-        }
-    // sprawdzanie poprawności całego pierwszego słowa (strcmp) 
-    if (strcmp(words[0], "I") != 0 && strcmp(words[0], "B") != 0) {
+    }
+    if (cmd->name != 'I' && cmd->name != 'B' && cmd->name != 'R') {
         return false;
     }
-    
-    for (int i = 1; i < VALID_NUMBER_OF_PARAMETERS; i++) {
-        if (!check_num_parameter(words[i])) 
-            return false;
+    if (!cmd->numbers_valid) {
+        return false;
     }
 
-    for (int i = 1; i < 5; i++) {
-        if (strcmp(words[i], "0") == 0) {
+    for (int i = 0; i < VALID_NUMBER_OF_PARAMETERS - 1; i++) {
+        if (cmd->params[i] == 0) {
             return false;
         }
     }
@@ -106,50 +62,33 @@ static bool check_initial_line(char **words, int number_of_words_in_line) {
     return true;
 }
 
-int separate_words(char *buff, char **words) {
-    int number_of_words_in_line = 0;
-    char *word_from_line;
-
-    word_from_line = strtok(buff, delimiters);
-    if (word_from_line != NULL) {
-        words[0] = word_from_line;
-        number_of_words_in_line++;
-    }
-
-    while (word_from_line != NULL) {
-        word_from_line = strtok(NULL, delimiters);
-
-        if (word_from_line != NULL) {
-            if (number_of_words_in_line < VALID_NUMBER_OF_PARAMETERS)
-                words[number_of_words_in_line] = word_from_line;
-            number_of_words_in_line++;
-        }
-    }
+/**
+ * @brief Drukuje komunikat o błędzie w linii @p line_number, a gdy sesje
+ *        są rozgrywane równolegle, dołącza go do kolejki sesji.
+ * @param[in, out] q - kolejka sesji lub NULL.
+ * @param[in] line_number - numer linii.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool report_error(struct session_queue *q,
+                         unsigned long long line_number) {
+    if (q != NULL)
+        return sessions_error(q, line_number);
 
-    return number_of_words_in_line;
+    fprintf(stderr, "ERROR %lld\n", line_number);
+    return true;
 }
 
 /**
- * @brief Zmienia argumenty z wejścia na liczby i tworzy nową grę.
+ * @brief Tworzy nową grę o parametrach z polecenia.
  * 
- * @param[in] words - tablica wskaźników na kolejne ciągi znaków z wejścia.
- * @param[in] line_number - numer linii, na której wystąpiło obecnie wykonywane
- * polecenie.
- * @return Wskaźnik na utworzoną strukturę, przechowującą stan gry. 
+ * @param[in] cmd - polecenie z linii rozpoczynającej grę.
+ * @return Wskaźnik na utworzoną strukturę, przechowującą stan gry lub NULL,
+ *         gdy nie udało się jej utworzyć.
  */
-static gamma_t *new_gamma(char **words, unsigned long long line_number) {
-    char *pointer_to_end;
-    uint32_t param1 = strtoul(words[1], &pointer_to_end, 10);
-    uint32_t param2 = strtoul(words[2], &pointer_to_end, 10);
-    uint32_t param3 = strtoul(words[3], &pointer_to_end, 10);
-    uint32_t param4 = strtoul(words[4], &pointer_to_end, 10);
-    gamma_t *g = gamma_new(param1, param2, param3, param4);
-
-    if (g == NULL) {
-        fprintf(stderr, "ERROR %lld\n", line_number);
-    }
-
-    return g;  
+static gamma_t *new_gamma(const struct command *cmd) {
+    return gamma_new(cmd->params[0], cmd->params[1], cmd->params[2],
+                     cmd->params[3]);
 }
 
 /**
@@ -157,22 +96,26 @@ static gamma_t *new_gamma(char **words, unsigned long long line_number) {
  *        gry.
  * Przygotowuje terminal do przejścia w tryb interaktywny.
  * @param[in, out] g - wskaźnik na strukturę, przechowującą stan gry.
- * @param[in] words - tablica łańcuchów znaków z wejścia, oddzielonych białymi
- *                znakami.
- * @param[in] line_number - numer linii, na której wystąpiło poprawne polecenie
- *                      przejścia do jednego z dwóch trybów gry.
+ * @param[in] cmd - polecenie z linii rozpoczynającej grę.
+ * @param[in, out] r - stan wczytywania wejścia.
+ * @param[in, out] line_number - numer linii, na której wystąpiło poprawne
+ *                               polecenie przejścia do jednego z trybów gry,
+ *                               a po zakończeniu gry numer ostatnio
+ *                               wczytanej linii.
+ * @param[in, out] journal - dziennik ruchów trybu wsadowego lub NULL.
  * @return @p true, gdy w czasie gry nie wystąpił błąd krytyczny,
  *         @p false w przeciwnym przypadku.
  */
-static bool start_game(gamma_t *g, char **words,
-                        unsigned long long line_number) {
+static bool start_game(gamma_t *g, const struct command *cmd,
+                       struct line_reader *r,
+                       unsigned long long *line_number,
+                       struct journal *journal) {
     bool success = true;
-    char *pointer_to_end;
-    uint32_t param1 = strtoul(words[1], &pointer_to_end, 10);
-    uint32_t param2 = strtoul(words[2], &pointer_to_end, 10);
-    uint32_t param3 = strtoul(words[3], &pointer_to_end, 10);
+    uint32_t param1 = cmd->params[0];
+    uint32_t param2 = cmd->params[1];
+    uint32_t param3 = cmd->params[2];
 
-    if (strcmp(words[0], "I") == 0 && g != NULL) {
+    if (cmd->name == 'I' && g != NULL) {
         struct winsize window_size;
         ioctl(0, TIOCGWINSZ, &window_size);
         unsigned int width = window_size.ws_col;
@@ -192,12 +135,19 @@ static bool start_game(gamma_t *g, char **words,
         // nowe ustawienia
         tcsetattr(STDIN_FILENO, TCSANOW, &currsett);
         clear_console();
-        success = interactive_mode(g, words);
+        success = interactive_mode(g);
         // powrót do starych ustawień
         tcsetattr(STDIN_FILENO, TCSANOW, &prevsett);
     }
-    else if (strcmp(words[0], "B") == 0) {
-        success = batch_mode(g, line_number);
+    else if (cmd->name == 'B') {
+        if (journal != NULL && !journal_begin(journal, g, *line_number))
+            return false;
+        success = batch_mode(g, r, line_number, journal);
+        if (journal != NULL)
+            success = journal_finish(journal) && success;
+    }
+    else if (cmd->name == 'R') {
+        success = binary_mode(g, r);
     }
     else {
         return false;
@@ -205,60 +155,113 @@ static bool start_game(gamma_t *g, char **words,
     return success;
 }
 
-bool read_initial_line() {
-    size_t buffersize = 4;
-    char **words;
-    if(!initiate_arr_of_words(&words))
+/**
+ * @brief Odtwarza grę z dziennika i kontynuuje ją w trybie wsadowym.
+ * Drukuje @p OK i numer linii ostatniego ruchu zapisanego w dzienniku,
+ * a kolejne linie wejścia są numerowane dalej, więc wejściem powinna być
+ * część pierwotnego wejścia następująca po tej linii.
+ * @param[in, out] journal - dziennik.
+ * @param[in, out] r - stan wczytywania wejścia.
+ * @param[out] line_number - numer ostatnio wczytanej linii.
+ * @return @p true, gdy w czasie gry nie wystąpił błąd krytyczny lub
+ *         dziennik był pusty, @p false w przeciwnym przypadku.
+ */
+static bool resume_game(struct journal *journal, struct line_reader *r,
+                        unsigned long long *line_number) {
+    gamma_t *g;
+
+    if (!journal_recover(journal, &g, line_number))
         return false;
-    char *buff = NULL;
-    unsigned long long line_number = 0;
-    int getline_ret_code = 0;
+    if (g == NULL)
+        return true;
 
-    while (!feof(stdin)) {
-        errno = 0;
-        line_number++;
-        getline_ret_code = getline(&buff, &buffersize, stdin);
-        if (errno == ENOMEM) {
-            free(buff);
-            free(words);
+    printf("OK %lld\n", *line_number);
+    bool success = batch_mode(g, r, line_number, journal);
+    success = journal_finish(journal) && success;
+    gamma_delete(g);
+
+    return success;
+}
+
+bool read_initial_line(const char *path, unsigned workers,
+                       struct journal *journal) {
+    struct line_reader r;
+    if (path == NULL) {
+        if (!reader_init(&r, STDIN_FILENO))
             return false;
+    }
+    else if (!reader_open(&r, path)) {
+        if (errno != ENOMEM)
+            fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return false;
+    }
+
+    struct session_queue queue;
+    struct session_queue *q = workers > 1 ? &queue : NULL;
+    if (q != NULL && !sessions_init(q, workers)) {
+        reader_free(&r);
+        return false;
+    }
+
+    struct command cmd;
+    unsigned long long line_number = 0;
+    enum line_status status;
+    bool success = true;
+
+    if (journal != NULL && journal->recover)
+        success = resume_game(journal, &r, &line_number);
+
+    // terminal oddaje po jednej linii naraz, więc klawisze wciśnięte w trybie
+    // interaktywnym nie trafiają do bufora wejścia
+    while (success &&
+           (status = next_command(&r, &cmd, &line_number)) != LINE_END) {
+        if (status == LINE_NO_MEMORY) {
+            success = false;
+            break;
         }
-        if (feof(stdin)) {
-            if (getline_ret_code != GETLINE_EOF && buff[0] != '#')
-                fprintf(stderr, "ERROR %lld\n", line_number);
+        if (status == LINE_COMMAND && cmd.name == 'M' && cmd.words == 1) {
+            // tryb wielu gier czyta wejście do końca
+            if (q != NULL && !sessions_finish(q)) {
+                success = false;
+                break;
+            }
+            printf("OK %lld\n", line_number);
+            success = multiplex_mode(&r, &line_number, workers);
             break;
         }
-        if (buff[0] == '#' || strcmp(buff, "\n") == 0)
-            continue;
-        if (buff[0] != 'B' && buff[0] != 'I') {
-            fprintf(stderr, "ERROR %lld\n", line_number);
+        if (status == LINE_ERROR || !check_initial_line(&cmd)) {
+            success = report_error(q, line_number);
             continue;
         }
 
-        int number_of_words_in_line = separate_words(buff, words);
-        
-        if (!check_initial_line(words, number_of_words_in_line)) {
-            fprintf(stderr, "ERROR %lld\n", line_number);
+        gamma_t *g = new_gamma(&cmd);
+        if (g == NULL) {
+            success = report_error(q, line_number);
+            continue;
         }
-        else {
-            gamma_t *g = new_gamma(words, line_number);
-            if (g == NULL)
-                continue;
-            if (strcmp(words[0], "B") == 0)
-                printf("OK %lld\n", line_number);
-            bool success = start_game(g, words, line_number);
-            if (!success) {
-                gamma_delete(g);
-                free(buff);
-                free(words);
-                return false;
-            }
-            if (g != NULL)
-                gamma_delete(g);
+        if (cmd.name == 'B' && q != NULL) {
+            success = sessions_add(q, g, &r, &line_number);
+            continue;
+        }
+
+        // tryby interaktywny i binarny czytają wejście do końca
+        if (q != NULL && !sessions_finish(q)) {
+            gamma_delete(g);
+            success = false;
             break;
         }
+        if (cmd.name == 'B' || cmd.name == 'R')
+            printf("OK %lld\n", line_number);
+        success = start_game(g, &cmd, &r, &line_number, journal);
+        gamma_delete(g);
+        if (cmd.name != 'B')
+            break;
     }
-    free(buff);
-    free(words);
-    return true;
-}
\ No newline at end of file
+
+    if (q != NULL) {
+        success = sessions_finish(q) && success;
+        sessions_free(q);
+    }
+    reader_free(&r);
+    return success;
+}
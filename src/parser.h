@@ -11,41 +11,31 @@
 #ifndef PARSER_H
 #define PARSER_H
 
-/**
- * Wartość zwracana przez funkcję getline(...), gdy ta napotka koniec pliku.
- */
-#define GETLINE_EOF -1
-
 #include <stdbool.h>
 #include <stdint.h>
-
-/**
- * @brief Sprawdza poprawność numerycznych parametrów.
- * @param[in] word - pobrany z wejścia ciąg znaków.
- * @return @p true, gdy da się skonwertować ciąg znaków @p word na liczbę
- *         z zakresu od zera do UINT32_MAX, @p false w przeciwnym przypadku.
- */
-extern bool check_num_parameter(char *word);
-
-/**
- * @brief Liczy, jak wiele ciągów znaków rozdzielonych przez białe znaki
- *        wystąpiło w pobranej linii. Separuje te ciągi znaków od siebie
- *        nawzajem. 
- * @param[in, out] buff - wskaźnik do tablicy znaków. Tablica zawiera znaki
- *                        podane kolejno na wejściu.
- * @param[out] words - tablica wskaźników, w której funkcja zapisuje wskaźniki
- *                     do pierwszych znaków kolejnych odseparowanych ciągów
- *                     znaków.
- * @return Liczba odseparowanych ciągów znaków.
- */
-extern int separate_words(char *buff, char **words);
+#include "journal.h"
 
 /**
  * @brief Wczytuje i analizuje kolejne linie z wejścia, poszukując poprawnej
  *        linii, odsyłającej do jednego z dwóch trybów gry.
+ * Po znalezieniu tej linii dalsza część wejścia jest przekazywana do trybu
+ * gry, więc oba tryby korzystają z tego samego wczytywania.
+ * Wejście może zawierać kolejne sesje trybu wsadowego, zakończone linią
+ * @p E.
+ * @param[in] path - ścieżka do pliku wejściowego lub NULL, gdy wejściem jest
+ *                   standardowe wejście.
+ * @param[in] workers - liczba wątków, na których rozgrywane są sesje trybu
+ *                      wsadowego. Gdy jest większa od 1, wyniki sesji są
+ *                      drukowane dopiero po wczytaniu jej do końca, każda
+ *                      w jednym kawałku i w kolejności sesji na wejściu.
+ * @param[in, out] journal - dziennik, w którym zapisywane są udane ruchy
+ *                           sesji trybu wsadowego, lub NULL. Gdy dziennik
+ *                           ma ustawione pole @p recover, przed wczytaniem
+ *                           wejścia odtwarzana jest zapisana w nim gra.
  * @return @p true, gdy gra przebiegła przez komplikacji lub do gry nie doszło,
  *         @p false w przeciwnym przypadku.
  */
-extern bool read_initial_line();
+extern bool read_initial_line(const char *path, unsigned workers,
+                              struct journal *journal);
 
 #endif /*PARSER_H*/
\ No newline at end of file
@@ -0,0 +1,168 @@
+/** @file
+ * Implementacja kolejki cyklicznej łączącej jeden wątek wstawiający
+ * elementy z jednym wątkiem je pobierającym.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "ring.h"
+
+/**
+ * Liczba sprawdzeń kolejki w pętli, zanim czekający wątek zaśnie.
+ */
+static const unsigned RING_SPINS = 256;
+
+bool ring_init(struct ring *q, size_t elem_size, size_t capacity) {
+    q->slots = malloc(elem_size * capacity);
+    if (q->slots == NULL)
+        return false;
+
+    q->elem_size = elem_size;
+    q->mask = capacity - 1;
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->wake, NULL);
+    atomic_init(&q->closed, false);
+    atomic_init(&q->head, 0);
+    atomic_init(&q->consumer_waiting, false);
+    q->cached_tail = 0;
+    atomic_init(&q->tail, 0);
+    atomic_init(&q->producer_waiting, false);
+    q->cached_head = 0;
+
+    return true;
+}
+
+void ring_free(struct ring *q) {
+    pthread_cond_destroy(&q->wake);
+    pthread_mutex_destroy(&q->lock);
+    free(q->slots);
+    q->slots = NULL;
+}
+
+/**
+ * @brief Budzi drugi wątek, jeśli śpi.
+ * Zapis indeksu poprzedzający wywołanie i odczyt flagi @p waiting są
+ * sekwencyjnie spójne, podobnie jak ustawienie flagi i ponowne sprawdzenie
+ * kolejki w funkcji wait_for(...), więc co najmniej jeden z wątków zauważy
+ * zmianę wprowadzoną przez drugi.
+ * @param[in, out] q - kolejka.
+ * @param[in] waiting - flaga snu drugiego wątku.
+ */
+static void wake_other(struct ring *q, atomic_bool *waiting) {
+    if (!atomic_load(waiting))
+        return;
+
+    pthread_mutex_lock(&q->lock);
+    pthread_cond_broadcast(&q->wake);
+    pthread_mutex_unlock(&q->lock);
+}
+
+/**
+ * @brief Sprawdza, czy wątek wstawiający może kontynuować: w kolejce jest
+ *        miejsce albo została zamknięta.
+ * @param[in, out] q - kolejka.
+ * @return @p true, gdy wątek wstawiający nie musi czekać.
+ */
+static bool producer_ready(struct ring *q) {
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+    q->cached_head = atomic_load(&q->head);
+    return tail - q->cached_head <= q->mask || atomic_load(&q->closed);
+}
+
+/**
+ * @brief Sprawdza, czy uśpiony wątek wstawiający może kontynuować: kolejka
+ *        jest zapełniona co najwyżej w połowie albo została zamknięta.
+ * Budzenie dopiero po zwolnieniu połowy miejsc sprawia, że wątki nie
+ * budzą się nawzajem po każdym elemencie, gdy wstawianie jest szybsze od
+ * pobierania.
+ * @param[in, out] q - kolejka.
+ * @return @p true, gdy wątek wstawiający może się obudzić.
+ */
+static bool producer_resume(struct ring *q) {
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+    q->cached_head = atomic_load(&q->head);
+    return tail - q->cached_head <= q->mask / 2 || atomic_load(&q->closed);
+}
+
+/**
+ * @brief Sprawdza, czy w kolejce są elementy do pobrania.
+ * @param[in, out] q - kolejka.
+ * @return @p true, gdy wątek pobierający nie musi czekać.
+ */
+static bool consumer_ready(struct ring *q) {
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+
+    q->cached_tail = atomic_load(&q->tail);
+    return q->cached_tail != head;
+}
+
+/**
+ * @brief Czeka, aż warunek @p ready będzie spełniony.
+ * @param[in, out] q - kolejka.
+ * @param[in] ready - warunek sprawdzany w pętli przez czekający wątek.
+ * @param[in] resume - warunek, po którego spełnieniu uśpiony wątek jest
+ *                     budzony, pociągający za sobą warunek @p ready.
+ * @param[in, out] waiting - flaga snu czekającego wątku.
+ */
+static void wait_for(struct ring *q, bool (*ready)(struct ring *),
+                     bool (*resume)(struct ring *), atomic_bool *waiting) {
+    for (unsigned i = 0; i < RING_SPINS; i++) {
+        if (ready(q))
+            return;
+    }
+
+    pthread_mutex_lock(&q->lock);
+    atomic_store(waiting, true);
+    while (!resume(q))
+        pthread_cond_wait(&q->wake, &q->lock);
+    atomic_store(waiting, false);
+    pthread_mutex_unlock(&q->lock);
+}
+
+bool ring_push(struct ring *q, const void *elem) {
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+    if (tail - q->cached_head > q->mask)
+        wait_for(q, producer_ready, producer_resume, &q->producer_waiting);
+    if (atomic_load_explicit(&q->closed, memory_order_relaxed))
+        return false;
+
+    memcpy(q->slots + (tail & q->mask) * q->elem_size, elem, q->elem_size);
+    atomic_store(&q->tail, tail + 1);
+    wake_other(q, &q->consumer_waiting);
+
+    return true;
+}
+
+bool ring_try_pop(struct ring *q, void *elem) {
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+
+    if (q->cached_tail == head && !consumer_ready(q))
+        return false;
+
+    memcpy(elem, q->slots + (head & q->mask) * q->elem_size, q->elem_size);
+    atomic_store(&q->head, head + 1);
+    // zapamiętana wartość tail nie jest większa od prawdziwej, więc
+    // zapełnienie nie jest tu zawyżone i wątek nie przegapi pobudki
+    if (q->cached_tail - (head + 1) <= q->mask / 2)
+        wake_other(q, &q->producer_waiting);
+
+    return true;
+}
+
+void ring_pop(struct ring *q, void *elem) {
+    while (!ring_try_pop(q, elem))
+        wait_for(q, consumer_ready, consumer_ready, &q->consumer_waiting);
+}
+
+void ring_close(struct ring *q) {
+    atomic_store(&q->closed, true);
+    pthread_mutex_lock(&q->lock);
+    pthread_cond_broadcast(&q->wake);
+    pthread_mutex_unlock(&q->lock);
+}
@@ -0,0 +1,103 @@
+/** @file
+ * Interfejs kolejki cyklicznej o stałym rozmiarze, łączącej dokładnie jeden
+ * wątek wstawiający elementy z dokładnie jednym wątkiem je pobierającym.
+ * Wstawianie do niepełnej i pobieranie z niepustej kolejki nie zakłada
+ * blokad. Wątek, który musi czekać, najpierw krótko sprawdza kolejkę
+ * w pętli, a potem zasypia na zmiennej warunkowej.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#ifndef RING_H
+#define RING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+/**
+ * Rozmiar linii pamięci podręcznej procesora. Indeksy zmieniane przez różne
+ * wątki leżą w osobnych liniach.
+ */
+#define RING_CACHE_LINE 64
+
+/**
+ * Struktura przechowująca kolejkę.
+ */
+struct ring {
+    unsigned char *slots;///< miejsca na elementy.
+    size_t elem_size;///< rozmiar elementu w bajtach.
+    size_t mask;///< liczba miejsc pomniejszona o jeden.
+    pthread_mutex_t lock;///< blokada chroniąca zasypianie wątków.
+    pthread_cond_t wake;///< zmienna warunkowa, na której śpią wątki.
+    atomic_bool closed;///< czy wątek pobierający zrezygnował z elementów.
+    _Alignas(RING_CACHE_LINE) atomic_size_t head;
+    /**<
+     * Liczba pobranych elementów, zmieniana przez wątek pobierający.
+     */
+    atomic_bool consumer_waiting;///< czy wątek pobierający śpi.
+    size_t cached_tail;///< wartość @p tail znana wątkowi pobierającemu.
+    _Alignas(RING_CACHE_LINE) atomic_size_t tail;
+    /**<
+     * Liczba wstawionych elementów, zmieniana przez wątek wstawiający.
+     */
+    atomic_bool producer_waiting;///< czy wątek wstawiający śpi.
+    size_t cached_head;///< wartość @p head znana wątkowi wstawiającemu.
+};
+
+/**
+ * @brief Przygotowuje pustą kolejkę.
+ * @param[out] q - kolejka.
+ * @param[in] elem_size - rozmiar elementu w bajtach.
+ * @param[in] capacity - liczba miejsc, potęga dwójki.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool ring_init(struct ring *q, size_t elem_size, size_t capacity);
+
+/**
+ * @brief Zwalnia pamięć zajmowaną przez kolejkę. Żaden wątek nie może już
+ *        z niej korzystać.
+ * @param[in, out] q - kolejka.
+ */
+extern void ring_free(struct ring *q);
+
+/**
+ * @brief Wstawia element na koniec kolejki, czekając, aż zwolni się miejsce.
+ * Wywoływana tylko przez wątek wstawiający.
+ * @param[in, out] q - kolejka.
+ * @param[in] elem - element o rozmiarze podanym w ring_init(...).
+ * @return @p true, gdy wstawiono element, @p false, gdy wątek pobierający
+ *         zamknął kolejkę funkcją ring_close(...).
+ */
+extern bool ring_push(struct ring *q, const void *elem);
+
+/**
+ * @brief Pobiera element z początku kolejki, jeśli kolejka nie jest pusta.
+ * Wywoływana tylko przez wątek pobierający.
+ * @param[in, out] q - kolejka.
+ * @param[out] elem - miejsce na element.
+ * @return @p true, gdy pobrano element, @p false, gdy kolejka była pusta.
+ */
+extern bool ring_try_pop(struct ring *q, void *elem);
+
+/**
+ * @brief Pobiera element z początku kolejki, czekając, aż się pojawi.
+ * Wywoływana tylko przez wątek pobierający.
+ * @param[in, out] q - kolejka.
+ * @param[out] elem - miejsce na element.
+ */
+extern void ring_pop(struct ring *q, void *elem);
+
+/**
+ * @brief Zamyka kolejkę: kolejne wywołania ring_push(...) zwracają @p false,
+ *        a czekający na miejsce wątek wstawiający zostaje obudzony.
+ * Wywoływana przez wątek pobierający, który nie będzie już pobierał
+ * elementów.
+ * @param[in, out] q - kolejka.
+ */
+extern void ring_close(struct ring *q);
+
+#endif /* RING_H */
@@ -0,0 +1,212 @@
+/** @file
+ * Implementacja modułu rozgrywającego na wielu wątkach niezależne sesje
+ * trybu wsadowego z jednego wejścia.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include "sessions.h"
+#include "tpool.h"
+
+/**
+ * Liczba sesji na wątek, po zgromadzeniu których kolejka jest rozgrywana.
+ */
+static const size_t SESSIONS_PER_WORKER = 16;
+
+/**
+ * Łączna liczba pól plansz gier w kolejce, po przekroczeniu której kolejka
+ * jest rozgrywana. Ogranicza pamięć zajmowaną przez gry czekające w kolejce.
+ */
+static const uint64_t QUEUE_CELLS = UINT64_C(1) << 26;
+
+/**
+ * Łączna liczba linii sesji w kolejce, po przekroczeniu której kolejka jest
+ * rozgrywana.
+ */
+static const uint64_t QUEUE_LINES = UINT64_C(1) << 20;
+
+/**
+ * @brief Przygotowuje pusty element kolejki.
+ * @param[out] slot - element kolejki.
+ */
+static void slot_init(struct session_slot *slot) {
+    slot->g = NULL;
+    slot->session.lines = NULL;
+    slot->session.count = 0;
+    slot->session.capacity = 0;
+    output_init_memory(&slot->out);
+    output_init_memory(&slot->err);
+    slot->success = true;
+}
+
+/**
+ * @brief Zwalnia pamięć zajmowaną przez element kolejki.
+ * @param[in, out] slot - element kolejki.
+ */
+static void slot_free(struct session_slot *slot) {
+    gamma_delete(slot->g);
+    slot->g = NULL;
+    free(slot->session.lines);
+    slot->session.lines = NULL;
+    output_free(&slot->out);
+    output_free(&slot->err);
+}
+
+/**
+ * @brief Podaje strumień, do którego trafiają komunikaty o błędach sesji.
+ * @param[in] q - kolejka.
+ * @param[in] slot - element kolejki.
+ * @return Wskaźnik na strumień.
+ */
+static struct output *slot_err(const struct session_queue *q,
+                               struct session_slot *slot) {
+    return q->shared ? &slot->out : &slot->err;
+}
+
+bool sessions_init(struct session_queue *q, unsigned workers) {
+    q->workers = workers;
+    q->shared = output_same_file(STDOUT_FILENO, STDERR_FILENO);
+    // miejsce na komunikaty za ostatnią sesją i na zamknięcie ich elementu
+    q->capacity = workers * SESSIONS_PER_WORKER + 2;
+    q->slots = malloc(q->capacity * sizeof(struct session_slot));
+    q->count = 0;
+    q->cells = 0;
+    q->lines = 0;
+
+    if (q->slots == NULL)
+        return false;
+    if (!output_init(&q->out, STDOUT_FILENO)) {
+        output_free(&q->out);
+        free(q->slots);
+        return false;
+    }
+    if (!q->shared && !output_init(&q->err, STDERR_FILENO)) {
+        output_free(&q->err);
+        output_free(&q->out);
+        free(q->slots);
+        return false;
+    }
+
+    slot_init(&q->slots[0]);
+    return true;
+}
+
+bool sessions_error(struct session_queue *q,
+                    unsigned long long line_number) {
+    struct session_slot *slot = &q->slots[q->count];
+
+    batch_print_error(slot_err(q, slot), line_number);
+    return !slot_err(q, slot)->failed;
+}
+
+/**
+ * @brief Rozgrywa sesję z kolejki (funkcja wykonywana przez pulę wątków).
+ * @param[in, out] arg - wskaźnik na kolejkę.
+ * @param[in] task - indeks sesji w kolejce.
+ * @param[in] worker - numer wątku.
+ */
+static void run_slot(void *arg, uint64_t task, unsigned worker) {
+    (void)worker;
+    struct session_queue *q = arg;
+    struct session_slot *slot = &q->slots[task];
+
+    if (slot->g != NULL) {
+        bool success = batch_run_session(&slot->out, slot_err(q, slot),
+                                         slot->g, &slot->session);
+        slot->success = slot->success && success;
+        gamma_delete(slot->g);
+        slot->g = NULL;
+    }
+    free(slot->session.lines);
+    slot->session.lines = NULL;
+}
+
+/**
+ * @brief Rozgrywa kompletne sesje z kolejki i zapisuje ich wyniki.
+ * Komunikaty poprzedzające następną sesję pozostają w kolejce.
+ * @param[in, out] q - kolejka.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią, @p false
+ *         w przeciwnym przypadku.
+ */
+static bool run_queue(struct session_queue *q) {
+    bool success = tpool_run(q->workers, q->count, run_slot, q);
+
+    for (size_t i = 0; i < q->count; i++) {
+        struct session_slot *slot = &q->slots[i];
+
+        if (success) {
+            if (slot->out.used > 0)
+                output_bytes(&q->out, slot->out.buffer, slot->out.used);
+            if (slot->err.used > 0)
+                output_bytes(&q->err, slot->err.buffer, slot->err.used);
+            success = slot->success && !slot->out.failed &&
+                      !slot->err.failed;
+        }
+        slot_free(slot);
+    }
+
+    q->slots[0] = q->slots[q->count];
+    if (!success) {
+        // bez wczytywania z wyprzedzeniem gra zakończyłaby się na tej sesji
+        slot_free(&q->slots[0]);
+        slot_init(&q->slots[0]);
+    }
+    q->count = 0;
+    q->cells = 0;
+    q->lines = 0;
+
+    if (q->out.interactive)
+        output_flush(&q->out);
+    if (!q->shared && q->err.interactive)
+        output_flush(&q->err);
+
+    return success;
+}
+
+bool sessions_add(struct session_queue *q, gamma_t *g, struct line_reader *r,
+                  unsigned long long *line_number) {
+    struct session_slot *slot = &q->slots[q->count];
+
+    slot->g = g;
+    output_bytes(&slot->out, "OK ", 3);
+    output_u64(&slot->out, *line_number);
+    output_char(&slot->out, '\n');
+    // sesja wczytana tylko w części zostanie rozegrana do miejsca, w którym
+    // zabrakło pamięci, tak jak bez wczytywania z wyprzedzeniem
+    slot->success = batch_read_session(r, line_number, &slot->session);
+
+    q->cells += (uint64_t)gamma_width(g) * gamma_height(g);
+    q->lines += slot->session.count;
+    bool success = slot->success;
+    slot_init(&q->slots[++q->count]);
+
+    if (!success || q->count >= q->workers * SESSIONS_PER_WORKER ||
+        q->cells >= QUEUE_CELLS || q->lines >= QUEUE_LINES)
+        success = run_queue(q) && success;
+
+    return success;
+}
+
+bool sessions_finish(struct session_queue *q) {
+    // komunikaty za ostatnią sesją są zapisywane jak sesja bez gry
+    slot_init(&q->slots[++q->count]);
+    bool success = run_queue(q);
+
+    success = output_flush(&q->out) && success;
+    if (!q->shared)
+        success = output_flush(&q->err) && success;
+
+    return success;
+}
+
+void sessions_free(struct session_queue *q) {
+    for (size_t i = 0; i <= q->count; i++)
+        slot_free(&q->slots[i]);
+    free(q->slots);
+    output_free(&q->out);
+    if (!q->shared)
+        output_free(&q->err);
+}
@@ -0,0 +1,109 @@
+/** @file
+ * Interfejs modułu rozgrywającego na wielu wątkach niezależne sesje trybu
+ * wsadowego z jednego wejścia. Wyniki każdej sesji trafiają na wyjście
+ * w jednym kawałku, w kolejności sesji na wejściu.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#ifndef SESSIONS_H
+#define SESSIONS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "gamma.h"
+#include "batch.h"
+#include "lexer.h"
+#include "output.h"
+
+/**
+ * Struktura przechowująca sesję oczekującą na rozegranie wraz z jej
+ * wynikami.
+ */
+struct session_slot {
+    gamma_t *g;///< gra sesji lub NULL, gdy są tu tylko komunikaty o błędach.
+    struct batch_session session;///< linie sesji.
+    struct output out;///< wyniki sesji gromadzone w pamięci.
+    struct output err;///< komunikaty o błędach gromadzone w pamięci.
+    bool success;///< czy sesja nie zakończyła się brakiem pamięci.
+};
+
+/**
+ * Struktura przechowująca kolejkę sesji rozgrywanych równolegle.
+ */
+struct session_queue {
+    unsigned workers;///< liczba wątków.
+    bool shared;
+    /**<
+     * Czy wyniki i komunikaty o błędach trafiają do tego samego pliku. Wtedy
+     * komunikaty trafiają do strumienia wyników sesji.
+     */
+    struct session_slot *slots;
+    /**<
+     * Kolejne sesje. Element o indeksie @p count gromadzi komunikaty
+     * poprzedzające następną sesję.
+     */
+    size_t count;///< liczba kompletnych sesji w kolejce.
+    size_t capacity;///< rozmiar tablicy @p slots.
+    uint64_t cells;///< łączna liczba pól plansz gier w kolejce.
+    uint64_t lines;///< łączna liczba linii sesji w kolejce.
+    struct output out;///< standardowe wyjście.
+    struct output err;///< standardowe wyjście błędów, gdy nie jest wspólne.
+};
+
+/**
+ * @brief Przygotowuje pustą kolejkę sesji.
+ * @param[out] q - kolejka.
+ * @param[in] workers - liczba wątków.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool sessions_init(struct session_queue *q, unsigned workers);
+
+/**
+ * @brief Zapisuje komunikat o błędzie w linii @p line_number, poprzedzający
+ *        następną sesję.
+ * @param[in, out] q - kolejka.
+ * @param[in] line_number - numer linii.
+ * @return @p true, gdy udało się zaalokować pamięć, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool sessions_error(struct session_queue *q,
+                           unsigned long long line_number);
+
+/**
+ * @brief Wczytuje z wyprzedzeniem linie sesji gry @p g i dodaje ją do
+ *        kolejki. Gdy kolejka jest pełna, rozgrywa zgromadzone sesje.
+ * Przejmuje grę @p g, także gdy zwraca @p false.
+ * @param[in, out] q - kolejka.
+ * @param[in] g - wskaźnik na strukturę, przechowującą stan nowej gry.
+ * @param[in, out] r - stan wczytywania wejścia, ustawiony za linią
+ *                     rozpoczynającą grę.
+ * @param[in, out] line_number - numer linii rozpoczynającej grę, a po
+ *                               zakończeniu numer ostatnio wczytanej linii.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią, @p false
+ *         w przeciwnym przypadku.
+ */
+extern bool sessions_add(struct session_queue *q, gamma_t *g,
+                         struct line_reader *r,
+                         unsigned long long *line_number);
+
+/**
+ * @brief Rozgrywa sesje z kolejki i zapisuje ich wyniki oraz zgromadzone
+ *        komunikaty o błędach.
+ * @param[in, out] q - kolejka.
+ * @return @p true, gdy nie wystąpiły problemy z pamięcią, @p false
+ *         w przeciwnym przypadku. Wtedy wyniki kończą się na sesji, w której
+ *         zabrakło pamięci.
+ */
+extern bool sessions_finish(struct session_queue *q);
+
+/**
+ * @brief Zwalnia pamięć zajmowaną przez kolejkę, nie rozgrywając sesji.
+ * @param[in, out] q - kolejka.
+ */
+extern void sessions_free(struct session_queue *q);
+
+#endif /* SESSIONS_H */
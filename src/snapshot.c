@@ -0,0 +1,268 @@
+/** @file
+ * Implementacja zapisu stanu gry do pliku binarnego i odtwarzania go z takiego
+ * pliku.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "areas.h"
+#include "snapshot.h"
+
+/**
+ * Napis rozpoczynający każdy plik ze stanem gry.
+ */
+static const char SNAPSHOT_MAGIC[8] = {'G', 'A', 'M', 'M', 'A', 'S', 'N', 'P'};
+
+/**
+ * Liczba zapisywana w nagłówku, pozwalająca wykryć plik utworzony na
+ * komputerze o innej kolejności bajtów.
+ */
+static const uint32_t BYTE_ORDER_MARK = UINT32_C(0x01020304);
+
+/**
+ * @brief Podaje rozmiar tablicy flag złotego ruchu, dopełniony do
+ *        wielokrotności 4 bajtów.
+ * @param[in] players - liczba graczy.
+ * @return Liczba bajtów.
+ */
+static uint64_t flags_size(uint32_t players) {
+    return ((uint64_t)players + 3) / 4 * 4;
+}
+
+bool snapshot_save(gamma_t *g, const char *path) {
+    struct snapshot_header header;
+    uint64_t flags = flags_size(g->b_players);
+    uint64_t fields = (uint64_t)g->b_width * g->b_height;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.width = g->b_width;
+    header.height = g->b_height;
+    header.players = g->b_players;
+    header.areas_limit = g->areas_limit;
+
+    uint8_t *golden = calloc(flags, 1);
+    if (golden == NULL) {
+        errno = ENOMEM;
+        return false;
+    }
+    for (uint32_t i = 0; i < g->b_players; i++) {
+        golden[i] = g->golden_move_available[i];
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        free(golden);
+        return false;
+    }
+
+    // pola planszy leżą w jednym bloku, więc wystarcza jeden zapis
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(golden, 1, flags, file) == flags &&
+              fwrite(g->board[0], sizeof(uint32_t), fields, file) == fields;
+
+    free(golden);
+    if (fclose(file) != 0)
+        ok = false;
+
+    return ok;
+}
+
+/**
+ * @brief Sprawdza nagłówek pliku ze stanem gry.
+ * @param[in] header - nagłówek.
+ * @param[in] size - rozmiar pliku w bajtach.
+ * @return @p true, gdy nagłówek jest poprawny i zgadza się z rozmiarem
+ *         pliku, @p false w przeciwnym przypadku.
+ */
+static bool header_valid(const struct snapshot_header *header,
+                         uint64_t size) {
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 ||
+        header->version != SNAPSHOT_VERSION ||
+        header->byte_order != BYTE_ORDER_MARK ||
+        header->width < 1 || header->height < 1 ||
+        header->players < 1 || header->areas_limit < 1)
+        return false;
+
+    uint64_t fields = (uint64_t)header->width * header->height;
+    uint64_t expected = sizeof(struct snapshot_header) +
+                        flags_size(header->players);
+
+    // rozmiar pliku ogranicza liczbę pól, więc mnożenie się nie przepełni
+    if (size < expected || (size - expected) / sizeof(uint32_t) != fields ||
+        (size - expected) % sizeof(uint32_t) != 0)
+        return false;
+
+    return true;
+}
+
+/**
+ * @brief Wylicza liczniki graczy, liczbę wolnych pól, mapę bitową zajętych
+ *        pól i liczby obszarów graczy na podstawie planszy i rejestru
+ *        obszarów oraz oznacza wszystkich graczy do sprawdzenia, czy mogą
+ *        wykonać ruch.
+ * @param[in, out] g - wskaźnik na strukturę przechowującą stan gry.
+ */
+static void rebuild_counters(gamma_t *g) {
+    struct area_registry *r = g->registry;
+    uint32_t **board = g->board;
+
+    for (uint32_t y = 0; y < g->b_height; y++) {
+        for (uint32_t x = 0; x < g->b_width; x++) {
+            if (board[y][x] != 0) {
+                g->info[board[y][x] - 1].busy_fields++;
+                set_field_bit(g, g->busy_bits, x, y);
+                g->free_fields--;
+                continue;
+            }
+
+            // każdy gracz sąsiadujący z wolnym polem liczy je raz
+            uint32_t seen[ADJACENT_FIELDS];
+            uint32_t n = 0;
+            uint32_t owners[ADJACENT_FIELDS] = {
+                x > 0 ? board[y][x - 1] : 0,
+                x < g->b_width - 1 ? board[y][x + 1] : 0,
+                y > 0 ? board[y - 1][x] : 0,
+                y < g->b_height - 1 ? board[y + 1][x] : 0
+            };
+
+            for (int i = 0; i < ADJACENT_FIELDS; i++) {
+                bool repeated = owners[i] == 0;
+                for (uint32_t j = 0; j < n && !repeated; j++) {
+                    repeated = seen[j] == owners[i];
+                }
+                if (!repeated) {
+                    seen[n++] = owners[i];
+                    g->info[owners[i] - 1].adjacent_free++;
+                }
+            }
+        }
+    }
+
+    for (uint32_t p = 0; p < g->b_players; p++) {
+        for (uint32_t id = r->first[p]; id != 0; id = r->entries[id].next) {
+            g->busy_areas[p]++;
+        }
+    }
+
+    // to, którzy gracze mogą wykonać ruch, jest ustalane przy pierwszym
+    // pytaniu o to
+    for (uint32_t p = 0; p < g->b_players; p++) {
+        g->info[p].active = false;
+        g->info[p].active_stale = true;
+    }
+    g->active_players = 0;
+    g->stale_players = g->b_players;
+}
+
+/**
+ * @brief Tworzy stan gry opisany przez zmapowany plik.
+ * @param[in] data - początek zmapowanego pliku.
+ * @param[in] size - rozmiar pliku w bajtach.
+ * @return Wskaźnik na nową strukturę przechowującą stan gry lub NULL, gdy
+ *         plik jest niepoprawny (wtedy @p errno to EINVAL) lub nie udało się
+ *         zaalokować pamięci.
+ */
+static gamma_t *load_mapped(const unsigned char *data, uint64_t size) {
+    struct snapshot_header header;
+
+    if (size < sizeof(header)) {
+        errno = EINVAL;
+        return NULL;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (!header_valid(&header, size)) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    const unsigned char *golden = data + sizeof(header);
+    const unsigned char *cells = golden + flags_size(header.players);
+    uint64_t fields = (uint64_t)header.width * header.height;
+
+    gamma_t *g = gamma_new(header.width, header.height, header.players,
+                           header.areas_limit);
+    if (g == NULL) {
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    memcpy(g->board[0], cells, fields * sizeof(uint32_t));
+
+    bool valid = true;
+    for (uint32_t i = 0; i < header.players && valid; i++) {
+        valid = golden[i] <= 1;
+        g->golden_move_available[i] = golden[i] == 1;
+    }
+    for (uint64_t i = 0; i < fields && valid; i++) {
+        valid = g->board[0][i] <= header.players;
+    }
+    if (!valid) {
+        gamma_delete(g);
+        errno = EINVAL;
+        return NULL;
+    }
+
+    if (!registry_rebuild(g)) {
+        gamma_delete(g);
+        errno = ENOMEM;
+        return NULL;
+    }
+    rebuild_counters(g);
+
+    // plansza zapisana przez grę nigdy nie przekracza limitu obszarów, a
+    // wszystkie funkcje gry zakładają, że limit jest zachowany
+    for (uint32_t p = 0; p < header.players; p++) {
+        if (g->busy_areas[p] > header.areas_limit) {
+            gamma_delete(g);
+            errno = EINVAL;
+            return NULL;
+        }
+    }
+
+    return g;
+}
+
+gamma_t *snapshot_load(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return NULL;
+    }
+    if (st.st_size < (off_t)sizeof(struct snapshot_header)) {
+        close(fd);
+        errno = EINVAL;
+        return NULL;
+    }
+
+    uint64_t size = (uint64_t)st.st_size;
+    void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return NULL;
+
+    // plik jest czytany jednokrotnie, od początku do końca
+    posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+    gamma_t *g = load_mapped(data, size);
+    int saved_errno = errno;
+    munmap(data, size);
+    errno = saved_errno;
+
+    return g;
+}
@@ -0,0 +1,63 @@
+/** @file
+ * Interfejs modułu zapisującego stan gry do pliku binarnego i odtwarzającego
+ * go z takiego pliku.
+ *
+ * Plik zaczyna się nagłówkiem (struktura snapshot_header), po którym
+ * następuje tablica flag złotego ruchu kolejnych graczy (po jednym bajcie na
+ * gracza, dopełniona zerami do wielokrotności 4 bajtów), a po niej pola
+ * planszy jako liczby 32-bitowe, wiersz po wierszu, od wiersza o numerze 0.
+ * Liczby zapisane są w kolejności bajtów komputera, który utworzył plik.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "gamma.h"
+
+/**
+ * Wersja formatu pliku, zwiększana przy każdej jego zmianie.
+ */
+#define SNAPSHOT_VERSION 1
+
+/**
+ * Struktura opisująca nagłówek pliku ze stanem gry.
+ */
+struct snapshot_header {
+    char magic[8];///< napis "GAMMASNP" bez kończącego znaku '\0'.
+    uint32_t version;///< wersja formatu, @p SNAPSHOT_VERSION.
+    uint32_t byte_order;///< liczba 0x01020304, pozwalająca wykryć kolejność bajtów.
+    uint32_t width;///< szerokość planszy.
+    uint32_t height;///< wysokość planszy.
+    uint32_t players;///< liczba graczy.
+    uint32_t areas_limit;///< limit obszarów.
+};
+
+/**
+ * @brief Zapisuje stan gry @p g do pliku @p path.
+ * @param[in] g - wskaźnik na strukturę przechowującą stan gry.
+ * @param[in] path - ścieżka do pliku, który zostanie utworzony lub
+ *                   nadpisany.
+ * @return @p true, gdy udało się zapisać plik, @p false w przeciwnym
+ *         przypadku.
+ */
+extern bool snapshot_save(gamma_t *g, const char *path);
+
+/**
+ * @brief Odtwarza stan gry z pliku @p path.
+ * Mapuje plik do pamięci, kopiuje pola planszy i flagi złotego ruchu,
+ * a rejestr obszarów oraz liczniki graczy wylicza na nowo. Plik, w którym
+ * któryś gracz ma więcej obszarów, niż pozwala limit, jest niepoprawny.
+ * @param[in] path - ścieżka do pliku utworzonego przez funkcję
+ *                   snapshot_save(...).
+ * @return Wskaźnik na nową strukturę przechowującą stan gry lub NULL, gdy
+ *         nie udało się odczytać pliku, plik jest niepoprawny lub nie udało
+ *         się zaalokować pamięci.
+ */
+extern gamma_t *snapshot_load(const char *path);
+
+#endif /* SNAPSHOT_H */
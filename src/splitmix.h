@@ -0,0 +1,36 @@
+/** @file
+ * Generator liczb pseudolosowych splitmix64, z którego korzystają programy
+ * rozgrywające, mierzące i generujące partie.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#ifndef SPLITMIX_H
+#define SPLITMIX_H
+
+#include <stdint.h>
+
+/**
+ * @brief Podaje kolejną liczbę pseudolosową (splitmix64).
+ * @param[in, out] state - stan generatora.
+ * @return Liczba pseudolosowa.
+ */
+static inline uint64_t splitmix64(uint64_t *state) {
+    uint64_t x = (*state += 0x9E3779B97F4A7C15ULL);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Podaje liczbę pseudolosową z przedziału [0, @p n).
+ * @param[in, out] state - stan generatora.
+ * @param[in] n - górna granica, większa od zera.
+ * @return Liczba pseudolosowa mniejsza od @p n.
+ */
+static inline uint32_t splitmix64_below(uint64_t *state, uint32_t n) {
+    return (uint32_t)(splitmix64(state) % n);
+}
+
+#endif /* SPLITMIX_H */
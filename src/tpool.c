@@ -0,0 +1,205 @@
+/** @file
+ * Implementacja puli wątków, w której bezczynne wątki podkradają zadania
+ * pozostałym wątkom.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "tpool.h"
+
+/**
+ * Struktura przechowująca przedział numerów zadań przydzielonych wątkowi.
+ */
+struct task_range {
+    pthread_mutex_t lock;///< blokada chroniąca przedział.
+    uint64_t begin;///< numer pierwszego niewykonanego zadania.
+    uint64_t end;///< numer zadania tuż za ostatnim zadaniem z przedziału.
+};
+
+/**
+ * Struktura przechowująca stan puli wątków.
+ */
+struct tpool {
+    unsigned workers;///< liczba wątków.
+    struct task_range *ranges;///< przedziały zadań kolejnych wątków.
+    tpool_task fn;///< funkcja wykonująca zadanie.
+    void *arg;///< parametr funkcji wykonującej zadanie.
+};
+
+/**
+ * Struktura przekazywana nowo utworzonemu wątkowi.
+ */
+struct worker_arg {
+    struct tpool *pool;///< pula, do której należy wątek.
+    unsigned id;///< numer wątku.
+};
+
+/**
+ * @brief Podaje liczbę wątków ze zmiennej środowiskowej @p GAMMA_THREADS.
+ * @return Liczba wątków lub 0, gdy zmienna nie jest ustawiona albo nie jest
+ *         liczbą od 1 do @p UINT16_MAX.
+ */
+static unsigned forced_workers(void) {
+    const char *text = getenv("GAMMA_THREADS");
+    unsigned long n = 0;
+
+    if (text == NULL || *text == '\0')
+        return 0;
+
+    for (; *text != '\0'; text++) {
+        if (*text < '0' || *text > '9')
+            return 0;
+        n = n * 10 + (unsigned long)(*text - '0');
+        if (n > UINT16_MAX)
+            return 0;
+    }
+
+    return (unsigned)n;
+}
+
+unsigned tpool_default_workers(void) {
+    unsigned forced = forced_workers();
+    if (forced > 0)
+        return forced;
+
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (n < 1)
+        return 1;
+
+    return (unsigned)n;
+}
+
+/**
+ * @brief Pobiera pierwsze zadanie z przedziału @p r.
+ * @param[in, out] r - przedział zadań.
+ * @param[out] task - numer pobranego zadania.
+ * @return @p true, gdy przedział nie był pusty, @p false w przeciwnym
+ *         przypadku.
+ */
+static bool pop_task(struct task_range *r, uint64_t *task) {
+    bool found = false;
+
+    pthread_mutex_lock(&r->lock);
+    if (r->begin < r->end) {
+        *task = r->begin;
+        r->begin++;
+        found = true;
+    }
+    pthread_mutex_unlock(&r->lock);
+
+    return found;
+}
+
+/**
+ * @brief Przenosi do przedziału wątku @p id połowę zadań innego wątku.
+ * Przegląda wątki kolejno, zaczynając od wątku następnego po @p id.
+ * @param[in, out] pool - wskaźnik na pulę wątków.
+ * @param[in] id - numer wątku, który szuka zadań.
+ * @return @p true, gdy udało się zabrać jakieś zadania, @p false, gdy
+ *         wszystkie przedziały były puste.
+ */
+static bool steal_tasks(struct tpool *pool, unsigned id) {
+    for (unsigned i = 1; i < pool->workers; i++) {
+        struct task_range *victim = &pool->ranges[(id + i) % pool->workers];
+        uint64_t begin = 0, end = 0;
+
+        pthread_mutex_lock(&victim->lock);
+        if (victim->begin < victim->end) {
+            end = victim->end;
+            begin = end - (end - victim->begin + 1) / 2;
+            victim->end = begin;
+        }
+        pthread_mutex_unlock(&victim->lock);
+
+        if (begin < end) {
+            struct task_range *own = &pool->ranges[id];
+
+            pthread_mutex_lock(&own->lock);
+            own->begin = begin;
+            own->end = end;
+            pthread_mutex_unlock(&own->lock);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Pętla wątku: wykonuje własne zadania, a potem podkrada cudze.
+ * @param[in] p - wskaźnik na strukturę worker_arg.
+ * @return @p NULL.
+ */
+static void *worker_loop(void *p) {
+    struct worker_arg *w = p;
+    struct tpool *pool = w->pool;
+    uint64_t task;
+
+    do {
+        while (pop_task(&pool->ranges[w->id], &task)) {
+            pool->fn(pool->arg, task, w->id);
+        }
+    } while (steal_tasks(pool, w->id));
+
+    return NULL;
+}
+
+bool tpool_run(unsigned workers, uint64_t tasks, tpool_task fn, void *arg) {
+    if (workers < 1)
+        workers = 1;
+    if (workers > tasks && tasks > 0)
+        workers = (unsigned)tasks;
+
+    struct tpool pool = {workers, NULL, fn, arg};
+    pool.ranges = malloc(workers * sizeof(struct task_range));
+    struct worker_arg *args = malloc(workers * sizeof(struct worker_arg));
+    pthread_t *threads = malloc(workers * sizeof(pthread_t));
+    bool *started = calloc(workers, sizeof(bool));
+
+    if (pool.ranges == NULL || args == NULL || threads == NULL ||
+        started == NULL) {
+        free(pool.ranges);
+        free(args);
+        free(threads);
+        free(started);
+        return false;
+    }
+
+    for (unsigned i = 0; i < workers; i++) {
+        pthread_mutex_init(&pool.ranges[i].lock, NULL);
+        pool.ranges[i].begin = tasks / workers * i;
+        pool.ranges[i].end = tasks / workers * (i + 1);
+        args[i].pool = &pool;
+        args[i].id = i;
+    }
+    pool.ranges[workers - 1].end = tasks;
+
+    for (unsigned i = 1; i < workers; i++) {
+        started[i] = pthread_create(&threads[i], NULL, worker_loop,
+                                    &args[i]) == 0;
+    }
+
+    worker_loop(&args[0]);
+
+    for (unsigned i = 1; i < workers; i++) {
+        if (started[i])
+            pthread_join(threads[i], NULL);
+    }
+
+    for (unsigned i = 0; i < workers; i++) {
+        pthread_mutex_destroy(&pool.ranges[i].lock);
+    }
+
+    free(pool.ranges);
+    free(args);
+    free(threads);
+    free(started);
+    return true;
+}
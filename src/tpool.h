@@ -0,0 +1,49 @@
+/** @file
+ * Interfejs puli wątków, w której bezczynne wątki podkradają zadania
+ * pozostałym wątkom.
+ *
+ * @author Mateusz Jastrzębski <m.jastrzebsk28@student.uw.edu.pl>
+ * @date 19.10.2026
+ */
+
+#ifndef TPOOL_H
+#define TPOOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Funkcja wykonująca zadanie o numerze @p task na wątku o numerze @p worker.
+ * Pierwszy parametr to wskaźnik przekazany do funkcji tpool_run(...).
+ */
+typedef void (*tpool_task)(void *arg, uint64_t task, unsigned worker);
+
+/**
+ * @brief Podaje domyślną liczbę wątków, równą liczbie dostępnych procesorów.
+ * Zmienna środowiskowa @p GAMMA_THREADS, jeśli jest liczbą od 1 do
+ * @p UINT16_MAX, zastępuje liczbę procesorów, np. by wymusić w testach
+ * przetwarzanie na wielu wątkach na jednym procesorze.
+ * @return Liczba wątków, co najmniej jeden.
+ */
+extern unsigned tpool_default_workers(void);
+
+/**
+ * @brief Wykonuje zadania o numerach od 0 do @p tasks - 1 na @p workers
+ *        wątkach.
+ * Każdy wątek dostaje na początku spójny przedział numerów zadań i pobiera
+ * je kolejno od jego początku. Wątek, któremu skończyły się zadania, zabiera
+ * innemu wątkowi połowę jego pozostałego przedziału, licząc od końca.
+ * Wątek wywołujący funkcję jest wątkiem o numerze 0. Funkcja wraca dopiero
+ * po wykonaniu wszystkich zadań.
+ * @param[in] workers - liczba wątków, liczba dodatnia.
+ * @param[in] tasks - liczba zadań.
+ * @param[in] fn - funkcja wykonująca pojedyncze zadanie.
+ * @param[in] arg - wskaźnik przekazywany funkcji @p fn.
+ * @return @p true, gdy udało się wykonać wszystkie zadania, @p false, gdy
+ *         nie udało się zaalokować pamięci. Jeśli nie udało się uruchomić
+ *         dodatkowych wątków, zadania wykonywane są na mniejszej ich liczbie.
+ */
+extern bool tpool_run(unsigned workers, uint64_t tasks, tpool_task fn,
+                      void *arg);
+
+#endif /* TPOOL_H */
@@ -0,0 +1,12 @@
+# Plik podany w argumencie jest czytany przez odwzorowanie w pamięci, a inne
+# pliki, np. potok, blokami. Wyniki mają być takie same jak dla wejścia
+# standardowego.
+"$GAMMA" "$CASE.in"
+echo "exit $?"
+cat "$CASE.in" | "$GAMMA" /dev/stdin > "$WORK/pipe" 2>&1
+"$GAMMA" < "$CASE.in" > "$WORK/stdin" 2>&1
+cmp -s "$WORK/pipe" "$WORK/stdin" && echo "pipe same as stdin"
+: > "$WORK/empty"
+"$GAMMA" "$WORK/empty"
+echo "empty exit $?"
+"$GAMMA" "$WORK/missing" 2>&1 | sed "s#$WORK/##"
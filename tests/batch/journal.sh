@@ -0,0 +1,18 @@
+# Gra zapisywana w dzienniku, którego ostatni rekord został urwany, jest
+# odtwarzana bez tego ruchu, a urwany koniec pliku jest obcinany. Dalsza
+# część wejścia daje wtedy te same wyniki co gra bez przerwy.
+"$GAMMA" < "$CASE.in" > "$WORK/plain"
+"$GAMMA" -w "$WORK/journal" -y 1 -s 4 < "$CASE.in" > "$WORK/first"
+cmp -s "$WORK/plain" "$WORK/first" && echo "journaled run same as plain"
+ls "$WORK/journal"
+
+size=$(wc -c < "$WORK/journal/journal")
+head -c $((size - 1)) "$WORK/journal/journal" > "$WORK/torn"
+cp "$WORK/torn" "$WORK/journal/journal"
+"$GAMMA" -w "$WORK/journal" -r < /dev/null
+[ "$(wc -c < "$WORK/journal/journal")" -lt $((size - 1)) ] &&
+    echo "torn record truncated"
+
+line=$("$GAMMA" -w "$WORK/journal" -r < /dev/null | sed 's/^OK //')
+tail -n +$((line + 1)) "$CASE.in" | "$GAMMA" -w "$WORK/journal" -r
+"$GAMMA" -w "$WORK/journal" -r < /dev/null
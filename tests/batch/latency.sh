@@ -0,0 +1,17 @@
+# Podsumowania pomiarów czasu poleceń. Czasy zależą od maszyny, więc
+# porównywane są tylko liczby wywołań, a o czasach sprawdzane jest tylko to,
+# że kolejne percentyle nie maleją.
+"$GAMMA" -t text < "$CASE.in" 2> "$WORK/text"
+awk '$1 == "command" || length($1) == 1 { print $1, $2 }' "$WORK/text"
+awk 'length($1) == 1 && !($4 <= $5 && $5 <= $6 && $6 <= $7 && $7 <= $8) {
+         bad = 1
+     }
+     END { if (!bad) print "percentiles ordered" }' "$WORK/text"
+
+"$GAMMA" -t json < "$CASE.in" > /dev/null 2> "$WORK/json"
+grep -c '^{.*}$' "$WORK/json"
+grep -o '"[a-z]":{"count":[0-9]*' "$WORK/json"
+
+"$GAMMA" -t xml < /dev/null 2> "$WORK/usage"
+echo "exit $?"
+grep -c usage "$WORK/usage"
@@ -0,0 +1,12 @@
+# Linia dłuższa niż bufor wczytywania i linie przecinające granice kolejnych
+# bloków wejścia. Powtarzające się linie wyjścia są zliczane.
+{
+    echo "B 2 2 2 1"
+    awk 'BEGIN { printf "m"; for (i = 0; i < 1572864; i++) printf " ";
+                 print "1 0 0" }'
+    awk 'BEGIN { for (i = 0; i < 300000; i++) print "b 1" }'
+    echo "p"
+} | "$GAMMA" | awk '$0 == last { n++; next }
+                    NR > 1 { print n, last }
+                    { last = $0; n = 1 }
+                    END { print n, last }'
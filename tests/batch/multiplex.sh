@@ -0,0 +1,25 @@
+# Polecenia wielu gier oznaczone ich numerami. Wyniki mają nie zależeć od
+# liczby wątków, na których rozgrywane są gry.
+"$GAMMA" -j 2 < "$CASE.in"
+"$GAMMA" < "$CASE.in" > "$WORK/serial" 2>&1
+"$GAMMA" -j 2 < "$CASE.in" > "$WORK/parallel" 2>&1
+cmp -s "$WORK/serial" "$WORK/parallel" && echo "same as serial"
+
+# Wiele gier z przeplatającymi się poleceniami.
+awk 'BEGIN {
+    print "M"
+    for (n = 0; n < 64; n++)
+        print "@" n, "B 6 6 4 3"
+    for (i = 0; i < 2000; i++) {
+        n = (i * 37) % 64
+        print "@" n, "m", i % 4 + 1, (i * 5 + n) % 6, (i * 11) % 6
+        if (i % 97 == 0)
+            print "@" n, "p"
+    }
+    for (n = 0; n < 64; n++)
+        print "@" n, "b 1"
+}' > "$WORK/many"
+"$GAMMA" < "$WORK/many" > "$WORK/serial" 2>&1
+"$GAMMA" -j 4 < "$WORK/many" > "$WORK/parallel" 2>&1
+cmp -s "$WORK/serial" "$WORK/parallel" && echo "many games same as serial"
+wc -l < "$WORK/parallel" | tr -d ' '
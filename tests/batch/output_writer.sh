@@ -0,0 +1,24 @@
+# Plansza drukowana wiele razy nie mieści się w buforze wyjścia, więc jej
+# kolejne kopie są zapisywane razem z buforem funkcją writev. Liczone są
+# bajty wyjścia i wystąpienia różnych linii.
+{
+    echo "B 20 20 12 3"
+    echo "m 12 0 0"
+    echo "m 7 19 19"
+    echo "m 10 5 7"
+    awk 'BEGIN { for (i = 0; i < 700; i++) print "p" }'
+} | "$GAMMA" > "$WORK/boards"
+wc -c < "$WORK/boards" | tr -d ' '
+sort "$WORK/boards" | awk '$0 == last { n++; next }
+                           NR > 1 { print n, last }
+                           { last = $0; n = 1 }
+                           END { print n, last }'
+
+# Wyniki i komunikaty o błędach trafiające do jednego pliku zachowują
+# kolejność poleceń.
+printf 'B 3 1 2 1\nm 1 0 0\nx\nm 2 2 0\nm 1 1 1 1\nb 1\n' |
+    "$GAMMA" > "$WORK/both" 2>&1
+cat "$WORK/both"
+
+# Liczby o różnej liczbie cyfr.
+printf 'B 1000 1000 2 1\nf 1\nm 1 999 999\nf 1\nb 1\nf 2\nb 2\n' | "$GAMMA"
@@ -0,0 +1,32 @@
+# Sesja dłuższa niż kolejki linii i wyników potoku trybu wsadowego, z błędami
+# przeplatanymi z wynikami. Wyniki potoku mają być takie same jak wyniki
+# wykonania na jednym wątku, także gdy wyniki i błędy trafiają do jednego
+# pliku.
+awk 'BEGIN {
+    print "B 40 30 5 6"
+    for (i = 0; i < 20000; i++) {
+        if (i % 5 == 4)
+            print "g", i % 5 + 1, (i * 13) % 40, (i * 7) % 30
+        else
+            print "m", i % 5 + 1, (i * 17) % 40, (i * 3) % 30
+        if (i % 7 == 0)
+            print "q", i % 6
+        if (i % 11 == 0)
+            print "x", i
+        if (i % 1000 == 0)
+            print "p"
+    }
+    print "b 1"
+    print "f 2"
+}' > "$WORK/input"
+GAMMA_THREADS=1 "$GAMMA" < "$WORK/input" > "$WORK/serial" 2> "$WORK/serial.err"
+GAMMA_THREADS=4 "$GAMMA" < "$WORK/input" > "$WORK/pipeline" \
+    2> "$WORK/pipeline.err"
+cmp -s "$WORK/serial" "$WORK/pipeline" &&
+    cmp -s "$WORK/serial.err" "$WORK/pipeline.err" && echo "same as serial"
+GAMMA_THREADS=1 "$GAMMA" < "$WORK/input" > "$WORK/serial" 2>&1
+GAMMA_THREADS=4 "$GAMMA" < "$WORK/input" > "$WORK/pipeline" 2>&1
+cmp -s "$WORK/serial" "$WORK/pipeline" && echo "shared file same as serial"
+wc -l < "$WORK/pipeline" | tr -d ' '
+grep -c ERROR "$WORK/pipeline"
+cksum < "$WORK/pipeline"
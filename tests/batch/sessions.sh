@@ -0,0 +1,23 @@
+# Sesje rozdzielone linią E są rozgrywane równolegle, a ich wyniki są
+# drukowane w kolejności sesji na wejściu, tak samo jak przy rozgrywaniu ich
+# po kolei.
+"$GAMMA" -j 3 < "$CASE.in"
+"$GAMMA" < "$CASE.in" > "$WORK/serial" 2>&1
+"$GAMMA" -j 3 < "$CASE.in" > "$WORK/parallel" 2>&1
+cmp -s "$WORK/serial" "$WORK/parallel" && echo "same as serial"
+
+# Więcej sesji niż wątków.
+awk 'BEGIN {
+    for (s = 0; s < 40; s++) {
+        print "B 5 5 3 2"
+        for (i = 0; i < 30; i++)
+            print "m", i % 3 + 1, (i * 7 + s) % 5, (i * 3 + s) % 5
+        print "g 1", s % 5, 0
+        print "p"
+        print "E"
+    }
+}' > "$WORK/many"
+"$GAMMA" < "$WORK/many" > "$WORK/serial" 2>&1
+"$GAMMA" -j 4 < "$WORK/many" > "$WORK/parallel" 2>&1
+cmp -s "$WORK/serial" "$WORK/parallel" && echo "many sessions same as serial"
+wc -l < "$WORK/parallel" | tr -d ' '
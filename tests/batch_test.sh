@@ -0,0 +1,59 @@
+#!/bin/sh
+# Uruchamia testy trybu wsadowego programu gamma.
+#
+# Użycie: batch_test.sh GAMMA KATALOG
+#
+# Test NAZWA w katalogu KATALOG składa się z plików:
+#   NAZWA.in   - wejście programu,
+#   NAZWA.out  - oczekiwane standardowe wyjście,
+#   NAZWA.err  - oczekiwane wyjście błędów (nieobowiązkowy, domyślnie puste).
+# Zamiast wejścia test może mieć skrypt NAZWA.sh, uruchamiany ze zmiennymi
+# GAMMA (ścieżka programu), CASE (ścieżka testu bez rozszerzenia) i WORK
+# (pusty katalog tymczasowy). Z plikami NAZWA.out i NAZWA.err porównywane
+# są wtedy wyjścia skryptu.
+# Każdy test jest uruchamiany dwa razy: na jednym wątku i z potokiem wątków
+# trybu wsadowego, wymuszonym zmienną GAMMA_THREADS.
+
+gamma=$1
+dir=$2
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+failed=0
+
+LC_ALL=C
+export LC_ALL
+
+for file in "$dir"/*.in "$dir"/*.sh; do
+    [ -e "$file" ] || continue
+    case=${file%.*}
+    name=${case##*/}
+    # wejście testu ze skryptem jest czytane przez skrypt
+    case $file in
+        *.in) [ -e "$case.sh" ] && continue ;;
+    esac
+
+    for threads in 1 4; do
+        rm -rf "$work/case"
+        mkdir "$work/case"
+        GAMMA_THREADS=$threads
+        export GAMMA_THREADS
+        if [ -e "$case.sh" ]; then
+            GAMMA=$gamma CASE=$case WORK=$work/case sh "$case.sh" \
+                > "$work/out" 2> "$work/err"
+        else
+            "$gamma" < "$case.in" > "$work/out" 2> "$work/err"
+        fi
+
+        expected_err=/dev/null
+        [ -e "$case.err" ] && expected_err=$case.err
+        if cmp -s "$case.out" "$work/out" &&
+           cmp -s "$expected_err" "$work/err"; then
+            echo "PASS $name (GAMMA_THREADS=$threads)"
+        else
+            echo "FAIL $name (GAMMA_THREADS=$threads)"
+            failed=1
+        fi
+    done
+done
+
+exit $failed